@@ -2,7 +2,8 @@
 TEMPLATE = subdirs
 
 SUBDIRS = samples \
-	tests
+	tests \
+	benchmarks
 
 OTHER_FILES = README.md \
 	doc/mainpage.dox \
@@ -17,4 +17,14 @@ HEADERS += $$PWD/arg_iface.hpp \
 	$$PWD/arg_as_command.hpp \
 	$$PWD/enums.hpp \
 	$$PWD/all.hpp \
-	$$PWD/types.hpp
+	$$PWD/types.hpp \
+	$$PWD/parse_status.hpp \
+	$$PWD/static_schema.hpp \
+	$$PWD/memory_resource.hpp \
+	$$PWD/name_set.hpp \
+	$$PWD/typed_value.hpp \
+	$$PWD/response_file.hpp \
+	$$PWD/stream_source.hpp \
+	$$PWD/parse_stats.hpp \
+	$$PWD/prefix_trie.hpp \
+	$$PWD/similarity_index.hpp
@@ -38,7 +38,20 @@
 #include "exceptions.hpp"
 #include "groups.hpp"
 #include "help.hpp"
+#include "memory_resource.hpp"
 #include "multi_arg.hpp"
+#include "name_set.hpp"
+#include "parse_stats.hpp"
+#include "parse_status.hpp"
+#include "prefix_trie.hpp"
+#include "similarity_index.hpp"
+#include "static_schema.hpp"
+#include "stream_source.hpp"
+#include "typed_value.hpp"
 #include "types.hpp"
 
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	#include "response_file.hpp"
+#endif
+
 #endif // ARGS__ALL_HPP__INCLUDED
@@ -37,6 +37,8 @@
 #include "context.hpp"
 #include "exceptions.hpp"
 #include "value_utils.hpp"
+#include "typed_value.hpp"
+#include "parse_status.hpp"
 #include "types.hpp"
 
 // C++ include.
@@ -96,16 +98,24 @@ public:
 		If name is empty returned value should be a flag.
 		I.e. for example "-t" or "--timeout"
 	*/
-	String name() const override;
+	const String & name() const override;
 
 	//! \return Is this argument with value?
 	bool isWithValue() const override;
-	//! Set is this argument with value.
+	/*!
+		Set is this argument with value.
+
+		\throw BaseException if command line parser is sealed.
+	*/
 	void setWithValue( bool on = true );
 
 	//! \return Is this argument required?
 	bool isRequired() const override;
-	//! Set required.
+	/*!
+		Set required.
+
+		\throw BaseException if command line parser is sealed.
+	*/
 	void setRequired( bool on = true );
 
 	//! \return Is this argument defined?
@@ -113,21 +123,86 @@ public:
 	//! Set defined.
 	void setDefined( bool on = true );
 
-	//! \return Value of this argument.
+	/*!
+		\return Value of this argument.
+
+		Value is copied from the command line on the first call,
+		so the first call isn't thread-safe.
+	*/
 	virtual const String & value() const;
 	//! Set value.
 	void setValue( const String & v );
 
+	/*!
+		Set handler of the value. Handler is invoked with the value
+		while parsing, value isn't stored in the argument unless
+		\a storeValues is true. Handler should outlive parsing.
+	*/
+	void setValueHandler( ValueHandler handler, bool storeValues = false );
+
+	/*!
+		Set handler that is invoked when argument is found in the
+		command line and its value is taken. Handler should outlive
+		parsing.
+	*/
+	void setDefinedHandler( DefinedHandler handler );
+
+	/*!
+		\return Value converted to the type \a T: integer, floating
+		point number, bool, std::chrono::duration, ByteSize, String or
+		any type with specialization of ValueConverter.
+
+		Conversion is done once, converted value is cached till
+		the next change of the value. Cache is filled by this const
+		method, so it isn't thread-safe: concurrent calls on the same
+		argument should be synchronized.
+
+		\throw BaseException if value can't be converted.
+	*/
+	template< typename T >
+	T valueAs() const;
+
+	/*!
+		Convert value to the type \a T without exceptions.
+
+		\return Is conversion successful? Details are in the \a status.
+	*/
+	template< typename T >
+	bool valueAs(
+		//! Converted value.
+		T & value,
+		//! Status of the conversion.
+		ParseStatus & status ) const;
+
 	//! \return Flag.
 	const String & flag() const override;
-	//! Set flag.
+	/*!
+		Set flag.
+
+		\throw BaseException if command line parser is sealed.
+	*/
 	void setFlag( Char f );
 
 	//! \return Argument name.
 	const String & argumentName() const override;
-	//! Set argument name.
+	/*!
+		Set argument name.
+
+		\throw BaseException if command line parser is sealed.
+	*/
 	void setArgumentName( const String & name );
 
+	//! \return Aliases of the argument.
+	const StringList & aliases() const override;
+	/*!
+		Add alias, i.e. "-o" or "--output". Argument is found by any
+		of its aliases as by its flag and name.
+
+		\throw BaseException if alias doesn't start with "-" or
+			command line parser is sealed.
+	*/
+	void addAlias( const String & alias );
+
 	//! \return Value specifier.
 	const String & valueSpecifier() const override;
 	//! Set value specifier.
@@ -164,46 +239,85 @@ protected:
 		context. This method invokes exactly at that moment when
 		parser has found this argument.
 	*/
-	void process(
+	ParseError tryProcess(
 		//! Context of the command line.
 		Context & context ) override;
 
+	//! Clear state of the parsing: defined flag and value.
+	void clear() override;
+
 	/*!
 		Check correctness of the argument before parsing.
 
 		Implementation of this method must add his flag
 		and name to the flags and names.
 	*/
-	void checkCorrectnessBeforeParsing(
+	ParseStatus tryCheckCorrectnessBeforeParsing(
 		//! All known flags.
-		StringList & flags,
+		NameSet & flags,
 		//! All known names.
-		StringList & names ) const override;
+		NameSet & names ) const override;
 
 	//! Check correctness of the argument after parsing.
-	void checkCorrectnessAfterParsing() const override;
+	ParseStatus tryCheckCorrectnessAfterParsing() const override;
+
+	//! \return Cache of the converted values.
+	ValueCache & valueCache() const;
+
+	/*!
+		Pass value to the handler of the value.
+
+		\return Should value be stored in the argument?
+	*/
+	bool handleValue( const StringView & value );
+
+	//! Invoke handler of the definition.
+	void handleDefined();
 
 private:
 	DISABLE_COPY( Arg )
 
+	//! Update flag and name with dashes.
+	void updateKeys();
+	//! \throw BaseException if command line parser is sealed.
+	void checkNotSealed() const;
+
 	//! Is this argument with value?
 	bool m_isWithValue;
 	//! Is this argument required?
 	bool m_isRequired;
 	//! Is this argument defined?
 	bool m_isDefined;
-	//! Value of this argument.
-	String m_value;
+	//! Value of this argument, it's copied from the view by const value().
+	mutable String m_value;
+	//! View of the value in the context.
+	StringView m_valueView;
+	//! Is value copied from the view?
+	mutable bool m_isValueCopied;
 	//! Flag of this argument.
 	String m_flag;
 	//! Name of this argument.
 	String m_name;
+	//! Flag with dash, i.e. "-t".
+	String m_flagKey;
+	//! Name with dashes, i.e. "--timeout".
+	String m_nameKey;
+	//! Aliases with dashes.
+	StringList m_aliases;
 	//! Value specifier.
 	String m_valueSpecifier;
 	//! Description.
 	String m_description;
 	//! Long description.
 	String m_longDescription;
+	//! Cache of the converted values, filled by const valueAs().
+	mutable ValueCache m_cache;
+	//! Handler of the value.
+	ValueHandler m_valueHandler;
+	//! Store values when handler is set?
+	bool m_storeValues;
+	//! Handler of the definition.
+	DefinedHandler m_definedHandler;
 }; // class Arg
 
 
@@ -217,10 +331,13 @@ Arg::Arg( Char flag, T && name,
 	:	m_isWithValue( isWithValue )
 	,	m_isRequired( isRequired )
 	,	m_isDefined( false )
+	,	m_isValueCopied( true )
 	,	m_flag( 1, flag )
 	,	m_name( std::forward< T > ( name ) )
 	,	m_valueSpecifier( SL( "arg" ) )
+	,	m_storeValues( false )
 {
+	updateKeys();
 }
 
 inline
@@ -229,9 +346,12 @@ Arg::Arg( Char flag,
 	:	m_isWithValue( isWithValue )
 	,	m_isRequired( isRequired )
 	,	m_isDefined( false )
+	,	m_isValueCopied( true )
 	,	m_flag( 1, flag )
 	,	m_valueSpecifier( SL( "arg" ) )
+	,	m_storeValues( false )
 {
+	updateKeys();
 }
 
 template< typename T >
@@ -240,9 +360,12 @@ Arg::Arg( T && name,
 	:	m_isWithValue( isWithValue )
 	,	m_isRequired( isRequired )
 	,	m_isDefined( false )
+	,	m_isValueCopied( true )
 	,	m_name( std::forward< T > ( name ) )
 	,	m_valueSpecifier( SL( "arg" ) )
+	,	m_storeValues( false )
 {
+	updateKeys();
 }
 
 inline
@@ -253,102 +376,171 @@ Arg::~Arg()
 inline ArgIface *
 Arg::isItYou( const String & name )
 {
-	if( isArgument( name ) && name.substr( 2 ) == m_name )
+	// Views are compared, so nothing is allocated.
+	if( isArgument( name ) && StringView( name ).substr( 2 ) == m_name )
 		return this;
-	else if( isFlag( name ) && name.substr( 1 ) == m_flag )
+	else if( isFlag( name ) && StringView( name ).substr( 1 ) == m_flag )
 		return this;
-	else
-		return nullptr;
+
+	for( const auto & alias : m_aliases )
+	{
+		if( alias == name )
+			return this;
+	}
+
+	return nullptr;
 }
 
-inline void
-Arg::process( Context & context )
+inline ParseError
+Arg::tryProcess( Context & context )
 {
 	if( !isDefined() )
 	{
-		if( !isWithValue() )
-			setDefined( true );
-		else
+		if( isWithValue() )
 		{
-			try {
-				setValue( eatOneValue( context, cmdLine() ) );
+			m_cache.clear();
 
-				setDefined( true );
-			}
-			catch( const BaseException & )
+			StringView value;
+
+			if( !eatOneValue( context, cmdLine(), value ) )
+				return ParseError::ValueRequired;
+
+			if( handleValue( value ) )
 			{
-				throw BaseException( String( SL( "Argument \"" ) ) +
-					name() + SL( "\" requires value but it's not presented." ) );
+				// Word stored in the context doesn't outlive it.
+				if( context.isOwned() )
+				{
+					assignString( m_value, value );
+					m_isValueCopied = true;
+				}
+				else
+				{
+					m_valueView = value;
+					m_isValueCopied = false;
+				}
 			}
 		}
+
+		setDefined( true );
+
+		handleDefined();
+
+		return ParseError::None;
 	}
 	else
-		throw BaseException( String( SL( "Argument \"" ) ) +
-			name() + SL( "\" already defined." ) );
+		return ParseError::AlreadyDefined;
+}
+
+inline void
+Arg::clear()
+{
+	m_isDefined = false;
+	m_value.clear();
+	m_valueView = StringView();
+	m_isValueCopied = true;
+	m_cache.clear();
 }
 
-inline String
+inline const String &
 Arg::name() const
 {
 	if( !m_name.empty() )
-		return SL( "--" ) + m_name;
+		return m_nameKey;
 	else
-		return SL( "-" ) + m_flag;
+		return m_flagKey;
+}
+
+inline void
+Arg::updateKeys()
+{
+	m_flagKey.clear();
+	m_nameKey.clear();
+
+	if( !m_flag.empty() )
+		m_flagKey = String( SL( "-" ) ) + m_flag;
+
+	if( !m_name.empty() )
+		m_nameKey = String( SL( "--" ) ) + m_name;
 }
 
 inline void
-Arg::checkCorrectnessBeforeParsing( StringList & flags,
-	StringList & names ) const
+Arg::checkNotSealed() const
+{
+	if( isCmdLineSealed( cmdLine() ) )
+		throw BaseException( String( SL( "Argument \"" ) ) + name() +
+			SL( "\" can't be changed as command line parser is sealed." ) );
+}
+
+inline ParseStatus
+Arg::tryCheckCorrectnessBeforeParsing( NameSet & flags,
+	NameSet & names ) const
 {
 	if( !m_flag.empty() )
 	{
 		if( isCorrectFlag( m_flag ) )
 		{
-			const String flag = String( SL( "-" ) ) + m_flag;
-
-			auto it = std::find( flags.begin(), flags.end(), flag );
-
-			if( it != flags.end() )
-				throw BaseException( String( SL( "Redefinition of argument "
-					"witg flag \"" ) ) + flag + SL( "\"." ) );
-			else
-				flags.push_back( flag );
+			if( !flags.insert( m_flagKey ) )
+				return ParseStatus( ParseError::FlagRedefinition, this );
 		}
 		else
-			throw BaseException( String( SL( "Dissallowed flag \"-" ) ) +
-				m_flag + SL( "\"." ) );
+			return ParseStatus( ParseError::DisallowedFlag, this );
 	}
 
 	if( !m_name.empty() )
 	{
 		if( isCorrectName( m_name ) )
 		{
-			const String name = String( SL( "--" ) ) + m_name;
+			if( !names.insert( m_nameKey ) )
+				return ParseStatus( ParseError::NameRedefinition, this );
+		}
+		else
+			return ParseStatus( ParseError::DisallowedName, this );
+	}
 
-			auto it = std::find( names.begin(), names.end(), name );
+	if( m_flag.empty() && m_name.empty() )
+		return ParseStatus( ParseError::EmptyFlagAndName, this );
 
-			if( it != names.end() )
-				throw BaseException( String( SL( "Redefinition of argument "
-					"with name \"" ) ) + name + SL( "\"." ) );
-			else
-				names.push_back( name );
+	for( const auto & alias : m_aliases )
+	{
+		const bool isName = isArgument( alias );
+		const String key = alias.substr( isName ? 2 : 1 );
+
+		ParseError error = ParseError::None;
+
+		if( isName )
+		{
+			if( !isCorrectName( key ) )
+				error = ParseError::DisallowedName;
+			else if( !names.insert( alias ) )
+				error = ParseError::NameRedefinition;
 		}
 		else
-			throw BaseException( String( SL( "Dissallowed name \"--" ) ) +
-				m_name + SL( "\"." ) );
+		{
+			if( !isCorrectFlag( key ) )
+				error = ParseError::DisallowedFlag;
+			else if( !flags.insert( alias ) )
+				error = ParseError::FlagRedefinition;
+		}
+
+		if( error != ParseError::None )
+		{
+			ParseStatus status( error, this );
+			status.setWord( alias );
+
+			return status;
+		}
 	}
 
-	if( m_flag.empty() && m_name.empty() )
-		throw BaseException( String( SL( "Arguments with empty flag and name "
-			"are dissallowed." ) ) );
+	return ParseStatus();
 }
 
-inline void
-Arg::checkCorrectnessAfterParsing() const
+inline ParseStatus
+Arg::tryCheckCorrectnessAfterParsing() const
 {
 	if( isRequired() && !isDefined() )
-		throw BaseException( String( SL( "Undefined required argument \"" ) ) +
-			name() + SL( "\"." ) );
+		return ParseStatus( ParseError::UndefinedRequiredArgument, this );
+
+	return ParseStatus();
 }
 
 inline bool
@@ -360,7 +552,11 @@ Arg::isWithValue() const
 inline void
 Arg::setWithValue( bool on )
 {
+	checkNotSealed();
+
 	m_isWithValue = on;
+
+	notifyArgumentsChanged( cmdLine() );
 }
 
 inline bool
@@ -372,7 +568,11 @@ Arg::isRequired() const
 inline void
 Arg::setRequired( bool on )
 {
+	checkNotSealed();
+
 	m_isRequired = on;
+
+	notifyArgumentsChanged( cmdLine() );
 }
 
 inline bool
@@ -390,6 +590,12 @@ Arg::setDefined( bool on )
 inline const String &
 Arg::value() const
 {
+	if( !m_isValueCopied )
+	{
+		assignString( m_value, m_valueView );
+		m_isValueCopied = true;
+	}
+
 	return m_value;
 }
 
@@ -397,6 +603,87 @@ inline void
 Arg::setValue( const String & v )
 {
 	m_value = v;
+	m_isValueCopied = true;
+	m_cache.clear();
+}
+
+inline void
+Arg::setValueHandler( ValueHandler handler, bool storeValues )
+{
+	m_valueHandler = handler;
+	m_storeValues = storeValues;
+}
+
+inline void
+Arg::setDefinedHandler( DefinedHandler handler )
+{
+	m_definedHandler = handler;
+}
+
+template< typename T >
+inline T
+Arg::valueAs() const
+{
+	ParseStatus status;
+	T result;
+
+	if( !valueAs( result, status ) )
+		throw BaseException( invalidValueDescription( value(), name() ) );
+
+	return result;
+}
+
+template< typename T >
+inline bool
+Arg::valueAs( T & result, ParseStatus & status ) const
+{
+	const T * cached = m_cache.get< T > ();
+
+	if( !cached )
+	{
+		T converted;
+
+		if( !ValueConverter< T >::convert( StringView( value() ), converted ) )
+		{
+			status = ParseStatus( ParseError::InvalidValue, this );
+			status.setWord( value() );
+
+			return false;
+		}
+
+		cached = &m_cache.set( std::move( converted ) );
+	}
+
+	result = *cached;
+	status = ParseStatus();
+
+	return true;
+}
+
+inline ValueCache &
+Arg::valueCache() const
+{
+	return m_cache;
+}
+
+inline bool
+Arg::handleValue( const StringView & value )
+{
+	if( m_valueHandler )
+	{
+		m_valueHandler( value );
+
+		return m_storeValues;
+	}
+
+	return true;
+}
+
+inline void
+Arg::handleDefined()
+{
+	if( m_definedHandler )
+		m_definedHandler( *this );
 }
 
 inline const String &
@@ -408,7 +695,13 @@ Arg::flag() const
 inline void
 Arg::setFlag( Char f )
 {
+	checkNotSealed();
+
 	m_flag = String( 1, f );
+
+	updateKeys();
+
+	notifyArgumentsChanged( cmdLine() );
 }
 
 inline const String &
@@ -420,7 +713,33 @@ Arg::argumentName() const
 inline void
 Arg::setArgumentName( const String & name )
 {
+	checkNotSealed();
+
 	m_name = name;
+
+	updateKeys();
+
+	notifyArgumentsChanged( cmdLine() );
+}
+
+inline const StringList &
+Arg::aliases() const
+{
+	return m_aliases;
+}
+
+inline void
+Arg::addAlias( const String & alias )
+{
+	checkNotSealed();
+
+	if( !isFlag( alias ) && !isArgument( alias ) )
+		throw BaseException( String( SL( "Alias \"" ) ) + alias +
+			SL( "\" should start with \"-\" or \"--\"." ) );
+
+	m_aliases.push_back( alias );
+
+	notifyArgumentsChanged( cmdLine() );
 }
 
 inline const String &
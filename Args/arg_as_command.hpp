@@ -62,6 +62,7 @@ public:
 		,	m_opt( opt )
 		,	m_required( required )
 		,	m_defined( false )
+		,	m_storeValues( false )
 	{
 		if( isArgument( name ) || isFlag( name ) )
 			throw BaseException( String( SL( "ArgAsCommand's name can't "
@@ -97,7 +98,7 @@ public:
 		If name is empty returned value should be a flag.
 		I.e. for example "-t" or "--timeout"
 	*/
-	String name() const override
+	const String & name() const override
 	{
 		return m_name;
 	}
@@ -180,15 +181,36 @@ public:
 	const String & value() const
 	{
 		if( !m_values.empty() )
-			return m_values.front();
+			return m_values.values().front();
 		else
 			return m_emptyString;
 	}
 
-	//! \return All values for this argument.
+	//! \return All values for this argument, see LazyValues about copying.
 	const StringList & values() const
 	{
-		return m_values;
+		return m_values.values();
+	}
+
+	/*!
+		Set handler of the values. Handler is invoked with each value
+		while parsing, values aren't stored in the argument unless
+		\a storeValues is true. Handler should outlive parsing.
+	*/
+	void setValueHandler( ValueHandler handler, bool storeValues = false )
+	{
+		m_valueHandler = handler;
+		m_storeValues = storeValues;
+	}
+
+	/*!
+		Set handler that is invoked when argument is found in the
+		command line and its values are taken. Handler should outlive
+		parsing.
+	*/
+	void setDefinedHandler( DefinedHandler handler )
+	{
+		m_definedHandler = handler;
 	}
 
 protected:
@@ -218,7 +240,7 @@ protected:
 		context. This method invokes exactly at that moment when
 		parser has found this argument.
 	*/
-	void process(
+	ParseError tryProcess(
 		//! Context of the command line.
 		Context & context ) override
 	{
@@ -230,33 +252,43 @@ protected:
 			{
 				case ValueOptions::ManyValues :
 				{
-					eatValues( context, m_values,
-						String( SL( "Argument \"" ) ) +
-							m_name + SL( "\" require value that wasn't presented." ),
-						cmdLine() );
+					const ParseError error = consumeValues( context, cmdLine(),
+						[ this, &context ] ( const StringView & value ) -> bool
+						{
+							takeValue( value, context.isOwned(), m_valueHandler,
+								m_storeValues, m_values );
+
+							return true;
+						} );
+
+					if( error != ParseError::None )
+						return error;
 				}
 					break;
 
 				case ValueOptions::OneValue :
 				{
-					try {
-						m_values.push_back( eatOneValue( context, cmdLine() ) );
-					}
-					catch( const BaseException & )
-					{
-						throw BaseException( String( SL( "Argument \"" ) ) +
-							m_name + SL( "\" require value that wasn't presented." ) );
-					}
+					StringView value;
+
+					if( !eatOneValue( context, cmdLine(), value ) )
+						return ParseError::ValueRequired;
+
+					takeValue( value, context.isOwned(), m_valueHandler,
+						m_storeValues, m_values );
 				}
 					break;
 
 				default :
 					break;
 			}
+
+			if( m_definedHandler )
+				m_definedHandler( *this );
+
+			return ParseError::None;
 		}
 		else
-			throw BaseException( String( SL( "Argument \"" ) ) + m_name +
-				SL( "\" already defined." ) );
+			return ParseError::AlreadyDefined;
 	}
 
 	/*!
@@ -265,35 +297,40 @@ protected:
 		Implementation of this method must add his flag
 		and name to the flags and names.
 	*/
-	void checkCorrectnessBeforeParsing(
+	ParseStatus tryCheckCorrectnessBeforeParsing(
 		//! All known flags.
-		StringList & flags,
+		NameSet & flags,
 		//! All known names.
-		StringList & names ) const override
+		NameSet & names ) const override
 	{
 		UNUSED( flags )
 
 		if( isCorrectName( m_name ) )
 		{
-			auto it = std::find( names.begin(), names.end(), m_name );
-
-			if( it != names.end() )
-				throw BaseException( String( SL( "Redefinition of argument "
-					"with name \"" ) ) + m_name + SL( "\"." ) );
-			else
-				names.push_back( m_name );
+			if( !names.insert( m_name ) )
+				return ParseStatus( ParseError::NameRedefinition, this );
 		}
 		else
-			throw BaseException( String( SL( "Dissallowed name \"" ) ) +
-				m_name + SL( "\" for the argument." ) );
+			return ParseStatus( ParseError::DisallowedName, this );
+
+		return ParseStatus();
 	}
 
 	//! Check correctness of the argument after parsing.
-	void checkCorrectnessAfterParsing() const override
+	ParseStatus tryCheckCorrectnessAfterParsing() const override
 	{
 		if( isRequired() && !isDefined() )
-			throw BaseException( String( SL( "Undefined required argument \"" ) ) +
-				m_name + SL( "\"." ) );
+			return ParseStatus( ParseError::UndefinedRequiredArgument, this );
+
+		return ParseStatus();
+	}
+
+	//! Clear state of the parsing: defined flag and values.
+	void clear() override
+	{
+		m_defined = false;
+
+		m_values.clear();
 	}
 
 private:
@@ -317,7 +354,13 @@ private:
 	//! Long description.
 	String m_longDesc;
 	//! Values.
-	StringList m_values;
+	LazyValues m_values;
+	//! Handler of the values.
+	ValueHandler m_valueHandler;
+	//! Store values when handler is set?
+	bool m_storeValues;
+	//! Handler of the definition.
+	DefinedHandler m_definedHandler;
 }; // class ArgAsCommand
 
 const String ArgAsCommand::m_emptyString;
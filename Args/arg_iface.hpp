@@ -33,7 +33,14 @@
 
 // Args include.
 #include "utils.hpp"
+#include "name_set.hpp"
+#include "parse_status.hpp"
+#include "enums.hpp"
 #include "types.hpp"
+#include "exceptions.hpp"
+
+// C++ include.
+#include <iterator>
 
 
 namespace Args {
@@ -42,6 +49,34 @@ class Context;
 class CmdLine;
 
 
+//
+// isCmdLineSealed
+//
+
+//! \return Is command line sealed? Template because CmdLine is incomplete here.
+template< typename Cmd >
+bool isCmdLineSealed( Cmd * cmdLine )
+{
+	return ( cmdLine && cmdLine->isSealed() );
+}
+
+
+//
+// notifyArgumentsChanged
+//
+
+/*!
+	Notify command line parser that names, flags or children of its
+	arguments were changed. Template because CmdLine is incomplete here.
+*/
+template< typename Cmd >
+void notifyArgumentsChanged( Cmd * cmdLine )
+{
+	if( cmdLine )
+		cmdLine->argumentsChanged();
+}
+
+
 //
 // ArgIface
 //
@@ -62,13 +97,22 @@ public:
 	{
 	}
 
+	//! \return Kind of the argument.
+	virtual ArgKind kind() const
+	{
+		return ArgKind::Argument;
+	}
+
 	/*!
 		\return Name of the argument.
 
 		If name is empty returned value should be a flag.
 		I.e. for example "-t" or "--timeout"
+
+		Name is built once, so reference is valid till the change
+		of the flag or the name of the argument.
 	*/
-	virtual String name() const = 0;
+	virtual const String & name() const = 0;
 
 	//! \return Is this argument with value?
 	virtual bool isWithValue() const = 0;
@@ -94,6 +138,14 @@ public:
 	//! \return Long description of the argument.
 	virtual const String & longDescription() const = 0;
 
+	//! \return Aliases of the argument, i.e. "-o" or "--output".
+	virtual const StringList & aliases() const
+	{
+		static const StringList empty;
+
+		return empty;
+	}
+
 	//! \return Command line parser.
 	CmdLine * cmdLine() const
 	{
@@ -120,25 +172,170 @@ protected:
 		Process argument's staff, for example take values from
 		context. This method invokes exactly at that moment when
 		parser has found this argument.
+
+		\return Error if any. Implementation mustn't throw.
+
+		Default implementation calls process() of the arguments
+		written before parsing without exceptions, exception of it
+		is converted into ParseStatus by CmdLine.
 	*/
-	virtual void process(
+	virtual ParseError tryProcess(
 		//! Context of the command line.
-		Context & context ) = 0;
+		Context & context )
+	{
+		process( context );
+
+		return ParseError::None;
+	}
 
 	/*!
 		Check correctness of the argument before parsing.
 
 		Implementation of this method must add his flag
 		and name to the flags and names.
+
+		\return Status of the check. Implementation mustn't throw.
+
+		Default implementation calls checkCorrectnessBeforeParsing()
+		with the lists of the known flags and names, adds flags and
+		names appended by it to the sets and converts exception into
+		ParseStatus.
+	*/
+	virtual ParseStatus tryCheckCorrectnessBeforeParsing(
+		//! All known flags.
+		NameSet & flags,
+		//! All known names.
+		NameSet & names ) const
+	{
+		StringList flagsList = flags.toList();
+		StringList namesList = names.toList();
+
+		const std::size_t flagsCount = flagsList.size();
+		const std::size_t namesCount = namesList.size();
+
+		try {
+			checkCorrectnessBeforeParsing( flagsList, namesList );
+		}
+		catch( const HelpHasBeenPrintedException & )
+		{
+			return ParseStatus( ParseError::HelpHasBeenPrinted, this );
+		}
+		catch( const BaseException & x )
+		{
+			return exceptionStatus( x );
+		}
+
+		auto flag = flagsList.cbegin();
+		std::advance( flag, flagsCount );
+
+		for( ; flag != flagsList.cend(); ++flag )
+		{
+			if( !flags.insert( *flag ) )
+			{
+				ParseStatus status( ParseError::FlagRedefinition, this );
+				status.setWord( *flag );
+
+				return status;
+			}
+		}
+
+		auto name = namesList.cbegin();
+		std::advance( name, namesCount );
+
+		for( ; name != namesList.cend(); ++name )
+		{
+			if( !names.insert( *name ) )
+			{
+				ParseStatus status( ParseError::NameRedefinition, this );
+				status.setWord( *name );
+
+				return status;
+			}
+		}
+
+		return ParseStatus();
+	}
+
+	/*!
+		Check correctness of the argument after parsing.
+
+		\return Status of the check. Implementation mustn't throw.
+
+		Default implementation calls checkCorrectnessAfterParsing()
+		and converts exception into ParseStatus.
+	*/
+	virtual ParseStatus tryCheckCorrectnessAfterParsing() const
+	{
+		try {
+			checkCorrectnessAfterParsing();
+		}
+		catch( const HelpHasBeenPrintedException & )
+		{
+			return ParseStatus( ParseError::HelpHasBeenPrinted, this );
+		}
+		catch( const BaseException & x )
+		{
+			return exceptionStatus( x );
+		}
+
+		return ParseStatus();
+	}
+
+	/*!
+		Process argument's staff, for example take values from
+		context. Throws on error.
+
+		\deprecated Kept for the arguments written before parsing
+		without exceptions, override tryProcess() instead.
+	*/
+	virtual void process(
+		//! Context of the command line.
+		Context & )
+	{
+	}
+
+	/*!
+		Check correctness of the argument before parsing. Throws
+		on error.
+
+		Implementation of this method must add his flag
+		and name to the flags and names.
+
+		\deprecated Kept for the arguments written before parsing
+		without exceptions, override tryCheckCorrectnessBeforeParsing()
+		instead.
 	*/
 	virtual void checkCorrectnessBeforeParsing(
 		//! All known flags.
-		StringList & flags,
+		StringList & ,
 		//! All known names.
-		StringList & names ) const = 0;
+		StringList & ) const
+	{
+	}
 
-	//! Check correctness of the argument after parsing.
-	virtual void checkCorrectnessAfterParsing() const = 0;
+	/*!
+		Check correctness of the argument after parsing. Throws
+		on error.
+
+		\deprecated Kept for the arguments written before parsing
+		without exceptions, override tryCheckCorrectnessAfterParsing()
+		instead.
+	*/
+	virtual void checkCorrectnessAfterParsing() const
+	{
+	}
+
+	/*!
+		Clear state of the parsing: defined flag, values. Argument
+		should be ready for the next parsing. Already allocated
+		buffers should be kept if possible.
+
+		Does nothing by default, so arguments that don't override
+		it keep their state between parsings.
+	*/
+	virtual void clear()
+	{
+	}
 
 	//! Set command line parser.
 	virtual void setCmdLine( CmdLine * cmdLine )
@@ -149,10 +346,27 @@ protected:
 private:
 	DISABLE_COPY( ArgIface )
 
+	//! \return Status for the exception thrown by the argument.
+	ParseStatus exceptionStatus( const BaseException & x ) const
+	{
+		ParseStatus status( ParseError::ArgumentException, this );
+		status.setWord( x.desc() );
+
+		return status;
+	}
+
 	//! Command line parser.
 	CmdLine * m_cmdLine;
 }; // class ArgIface
 
+
+//
+// DefinedHandler
+//
+
+//! Handler that is invoked when argument is found in the command line.
+using DefinedHandler = FunctionRef< void ( ArgIface & ) >;
+
 } /* namespace Args */
 
 #endif // ARGS__ARG_IFACE_HPP__INCLUDED
@@ -37,11 +37,27 @@
 #include "arg_iface.hpp"
 #include "exceptions.hpp"
 #include "command.hpp"
+#include "group_iface.hpp"
+#include "groups.hpp"
+#include "parse_status.hpp"
+#include "static_schema.hpp"
+#include "memory_resource.hpp"
+#include "typed_value.hpp"
+#include "parse_stats.hpp"
+#include "prefix_trie.hpp"
+#include "similarity_index.hpp"
 #include "types.hpp"
 
 // C++ include.
+#include <array>
+#include <cctype>
 #include <list>
+#include <vector>
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <iterator>
+#include <utility>
 
 
 namespace Args {
@@ -54,6 +70,16 @@ namespace Args {
 	CmdLine is class that holds all rguments and parse
 	command line arguments in the correspondence with holded
 	arguments.
+
+	Internal containers of the parser allocate memory from the memory
+	resource given to the constructor. Global heap is still used by:
+
+	- characters of String, i.e. long keys of the index and of the
+	tries of the abbreviations, as String has no allocator;
+	- values of the arguments, they belong to the arguments and
+	are returned to the user as StringList;
+	- index for suggestions, it's built only when unknown argument
+	is reported.
 */
 class CmdLine final {
 public:
@@ -62,100 +88,531 @@ public:
 		//! No special options.
 		Empty = 0,
 		//! Command should be defined.
-		CommandIsRequired = 1
+		CommandIsRequired = 1,
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+		/*!
+			Replace "@file" words with the words of the response file.
+			Available only if ARGS_ENABLE_RESPONSE_FILES is defined.
+		*/
+		ExpandResponseFiles = 2,
+#endif
+		/*!
+			Allow unambiguous prefixes of the names and commands,
+			i.e. "--verb" for "--verbose".
+		*/
+		AllowAbbreviations = 4
 	}; // enum CmdLineOpts
 
+	//! \return Combination of the options.
+	friend CmdLineOpts operator | ( CmdLineOpts o1, CmdLineOpts o2 )
+	{
+		return static_cast< CmdLineOpts > ( static_cast< int > ( o1 ) |
+			static_cast< int > ( o2 ) );
+	}
+
+	/*!
+		Command line from argc and argv.
+
+		Internal containers of the parser (words of the command line,
+		index of the arguments, tries of the abbreviations) allocate
+		memory from the \a resource, that should outlive command line.
+	*/
 #ifdef ARGS_WSTRING_BUILD
 	CmdLine( int argc, const Char * const * argv,
-		CmdLineOpts opt = Empty );
+		CmdLineOpts opt = Empty,
+		MemoryResource * resource = newDeleteResource() );
 #else
 	CmdLine( int argc, const char * const * argv,
-		CmdLineOpts opt = Empty );
+		CmdLineOpts opt = Empty,
+		MemoryResource * resource = newDeleteResource() );
 #endif
 
+	/*!
+		Command line from the range of words.
+
+		Range doesn't contain executable name. Words are not copied,
+		so they should outlive parsing.
+	*/
+	template< typename Iterator >
+	CmdLine( Iterator first, Iterator last, CmdLineOpts opt = Empty,
+		MemoryResource * resource = newDeleteResource() );
+
+	/*!
+		Command line from the container of words (std::vector< std::string >,
+		std::array, span, QStringList...).
+
+		Container doesn't contain executable name. Words are not copied,
+		so container should outlive parsing.
+	*/
+	template< typename Container, typename = decltype(
+		std::begin( std::declval< const Container & > () ) ) >
+	explicit CmdLine( const Container & args, CmdLineOpts opt = Empty,
+		MemoryResource * resource = newDeleteResource() );
+
+	//! Words are not copied, so temporary container is not allowed.
+	template< typename Container, typename = decltype(
+		std::begin( std::declval< const Container & > () ) ) >
+	CmdLine( const Container && args, CmdLineOpts opt = Empty,
+		MemoryResource * resource = newDeleteResource() ) = delete;
+
 	//! Add argument.
 	void addArg( ArgIface * arg );
 
 	//! Add argument.
 	void addArg( ArgIface & arg );
 
-	//! Parse arguments.
+	/*!
+		Add range of arguments (pointers or references) and check
+		correctness of the arguments in one pass.
+
+		Nothing is added if any argument is incorrect.
+
+		\throw BaseException on error.
+	*/
+	template< typename Iterator >
+	void addArgs( Iterator first, Iterator last );
+
+	//! Add container of arguments (pointers or references).
+	template< typename Container, typename = decltype(
+		std::begin( std::declval< const Container & > () ) ) >
+	void addArgs( const Container & args );
+
+	/*!
+		Parse arguments.
+
+		\throw HelpHasBeenPrintedException if help has been printed.
+		\throw BaseException on error.
+	*/
 	void parse();
 
-	//! \return Argument for the given name.
+	/*!
+		Parse arguments without exceptions.
+
+		\return Is parsing successful? Details are in the \a status.
+	*/
+	bool parse(
+		//! Status of the parsing.
+		ParseStatus & status );
+
+	/*!
+		Parse new command line with the same arguments. State of the
+		previous parsing is cleared with reset().
+
+		\throw HelpHasBeenPrintedException if help has been printed.
+		\throw BaseException on error.
+	*/
+#ifdef ARGS_WSTRING_BUILD
+	void parse( int argc, const Char * const * argv );
+#else
+	void parse( int argc, const char * const * argv );
+#endif
+
+	/*!
+		Parse new command line with the same arguments without exceptions.
+		State of the previous parsing is cleared with reset().
+
+		\return Is parsing successful? Details are in the \a status.
+	*/
+#ifdef ARGS_WSTRING_BUILD
+	bool parse( int argc, const Char * const * argv, ParseStatus & status );
+#else
+	bool parse( int argc, const char * const * argv, ParseStatus & status );
+#endif
+
+	/*!
+		Validate arguments and build index once. Later parsings skip
+		validation, arguments can't be added after sealing.
+
+		\throw BaseException if arguments are incorrect.
+	*/
+	void seal();
+
+	/*!
+		Validate arguments and build index once without exceptions.
+
+		\return Is sealing successful? Details are in the \a status.
+	*/
+	bool seal(
+		//! Status of the validation.
+		ParseStatus & status );
+
+	//! \return Is command line sealed?
+	bool isSealed() const;
+
+	/*!
+		Notify that names, flags, aliases, children or options of the
+		added arguments were changed, index is rebuilt on the next
+		lookup, arguments are checked again on the next parsing.
+		Does nothing if command line is sealed.
+
+		Arguments of the library do it themselves, custom arguments
+		should call it on such changes.
+	*/
+	void argumentsChanged();
+
+	/*!
+		\return Fingerprint of the arguments: kinds, flags, names,
+		values and required options, structure of commands and groups.
+
+		Take it after seal() and compare later to check that
+		arguments weren't changed.
+	*/
+	std::size_t fingerprint() const;
+
+	/*!
+		Clear state of the previous parsing: defined flags, values,
+		command. Only arguments touched by the parsing are visited,
+		allocated buffers are kept for the next parsing.
+
+		State is cleared by ArgIface::clear(), that does nothing by
+		default. Custom arguments derived from ArgIface should override
+		clear() to be reusable, otherwise they keep the state of the
+		previous parsing.
+	*/
+	void reset();
+
+#ifdef ARGS_ENABLE_PARSE_STATS
+	/*!
+		\return Statistics of the parsings since creation or the last
+		resetParseStats(). Available only if ARGS_ENABLE_PARSE_STATS
+		is defined.
+	*/
+	const ParseStats & parseStats() const;
+
+	//! Reset statistics of the parsings.
+	void resetParseStats();
+#endif
+
+	/*!
+		\return Argument for the given name.
+
+		\throw BaseException if there is no such argument.
+	*/
 	ArgIface * findArgument( const String & name );
 
+	/*!
+		\return Argument for the given name.
+
+		\throw BaseException if there is no such argument.
+	*/
+	ArgIface * findArgument( const StringView & name );
+
+	/*!
+		\return Argument for the given name.
+
+		\retval nullptr if there is no such argument.
+	*/
+	ArgIface * tryFindArgument( const String & name );
+
+	/*!
+		\return Argument for the given name.
+
+		\retval nullptr if there is no such argument.
+	*/
+	ArgIface * tryFindArgument( const StringView & name );
+
+	/*!
+		\return Long names and commands similar to the given name,
+		the nearest first. Global arguments and arguments of the current
+		command are looked through.
+
+		Names are indexed once, on the first call after preparing for
+		parsing, and only some names with most common bigrams are
+		compared, so it's cheap enough for error paths.
+	*/
+	std::vector< String > suggestions( const StringView & name,
+		std::size_t count = 3 );
+
 	//! \return All arguments.
 	const std::list< ArgIface* > & arguments() const;
 
+	//! \return Memory resource of the internal containers.
+	MemoryResource * memoryResource() const;
+
+	/*!
+		Use static schema for lookup of the arguments.
+
+		Added arguments should match the schema exactly, then run-time
+		checks of correctness before parsing are skipped as the schema
+		is validated at compile time. Schema should outlive command line.
+
+		Schema replaces only the index of the arguments, argument objects
+		are still needed alongside the schema, they keep values and state
+		of the parsing. Arguments are bound to the specs through the
+		perfect hash of the schema.
+
+		\throw BaseException if schema is incorrect.
+	*/
+	template< std::size_t N >
+	void setSchema( const StaticSchema< N > & schema );
+
 private:
+	//! Index of the arguments: name or flag -> argument.
+	typedef std::unordered_map< StringView, ArgIface*, StringViewHash,
+		std::equal_to< StringView >, PolymorphicAllocator<
+			std::pair< const StringView, ArgIface* > > > ArgIndex;
+	//! Indexes of the commands' arguments.
+	typedef std::unordered_map< const Command*, ArgIndex,
+		std::hash< const Command* >, std::equal_to< const Command* >,
+		PolymorphicAllocator< std::pair< const Command* const, ArgIndex > > >
+			CommandsIndex;
+	//! Storage of the keys of the index.
+	typedef std::list< String, PolymorphicAllocator< String > > Keys;
+	//! Table of the flags: ASCII code of the flag -> argument.
+	typedef std::array< ArgIface*, 128 > FlagTable;
+	//! Tables of the flags of the commands, with global flags included.
+	typedef std::unordered_map< const Command*, FlagTable,
+		std::hash< const Command* >, std::equal_to< const Command* >,
+		PolymorphicAllocator< std::pair< const Command* const, FlagTable > > >
+			CommandsFlags;
+	//! Tries of the names of the commands' arguments.
+	typedef std::unordered_map< const Command*, PrefixTrie,
+		std::hash< const Command* >, std::equal_to< const Command* >,
+		PolymorphicAllocator< std::pair< const Command* const, PrefixTrie > > >
+			CommandsAbbreviations;
+	//! Indexes of the names of the commands' arguments for suggestions.
+	typedef std::unordered_map< const Command*, SimilarityIndex,
+		std::hash< const Command* >, std::equal_to< const Command* >,
+		PolymorphicAllocator< std::pair< const Command* const, SimilarityIndex > > >
+			CommandsSuggestions;
+
+	//! Check correctness of the arguments and build index.
+	ParseStatus prepare();
+	//! Fill tables of the flags.
+	void buildFlagTables();
+	//! Fill table of the flags for the current command.
+	void fillFlagTable( FlagTable & table );
+	//! Set table of the flags of the current command.
+	void setCommandFlags();
+	//! \return Argument for the flag.
+	ArgIface * findFlag( Char flag ) const;
+	/*!
+		Call \a func( scope, name, arg ) for the long names, long aliases
+		and names of the commands. Scope is the command of the argument
+		or nullptr for global arguments.
+	*/
+	template< typename Func >
+	static void forEachLongName( ArgIface * arg, const Command * scope,
+		Func & func );
+	//! Build tries of the names if abbreviations are allowed.
+	void buildAbbreviations();
+	//! Build indexes of the names for suggestions.
+	void buildSuggestions();
+	/*!
+		Find argument by abbreviation of its name. Long names are
+		abbreviated only with TokenKind::Long words, commands only
+		with TokenKind::Word or TokenKind::Operand words that don't
+		start with "-".
+
+		\return false if abbreviation is ambiguous, details are
+			in the \a status.
+	*/
+	bool findAbbreviation( const StringView & word, TokenKind kind,
+		std::size_t token, ArgIface * & arg, ParseStatus & status );
+	//! Command line without words, public constructors delegate to it.
+	CmdLine( CmdLineOpts opt, MemoryResource * resource );
 	//! Check correctness of the arguments before parsing.
-	void checkCorrectnessBeforeParsing() const;
+	ParseStatus checkCorrectnessBeforeParsing() const;
 	//! Check correctness of the arguments after parsing.
-	void checkCorrectnessAfterParsing() const;
+	ParseStatus checkCorrectnessAfterParsing() const;
+	//! Process argument. \return Is processing successful?
+	bool process( ArgIface * arg, std::size_t token, ParseStatus & status );
+	//! Set context to the argv.
+#ifdef ARGS_WSTRING_BUILD
+	void setArgv( int argc, const Char * const * argv );
+#else
+	void setArgv( int argc, const char * const * argv );
+#endif
+	//! Expand response files if it's enabled.
+	void expandResponseFiles();
+	//! Build index of the arguments.
+	void buildIndex();
+	//! Add argument to the index.
+	void addToIndex( ArgIndex & index, ArgIface * arg );
+	//! Add key to the index.
+	void addKey( ArgIndex & index, String key, ArgIface * arg );
+	//! Bind arguments to the static schema.
+	ParseStatus bindSchema();
+	//! Bind argument to the static schema.
+	ParseStatus bindToSchema( ArgIface * arg, std::size_t scope,
+		std::size_t parent );
+	//! \return Argument from the static schema.
+	ArgIface * findInSchema( const StringView & name );
+	//! \return Fingerprint with the given argument.
+	static std::size_t addToFingerprint( std::size_t fingerprint,
+		const ArgIface * arg );
 
 private:
 	DISABLE_COPY( CmdLine )
 
+	//! Memory resource.
+	MemoryResource * m_resource;
 	// Context.
 	Context m_context;
 	//! Arguments.
 	std::list< ArgIface* > m_args;
+	//! Set of the arguments for the fast check of duplicates.
+	std::unordered_set< ArgIface*, std::hash< ArgIface* >,
+		std::equal_to< ArgIface* >, PolymorphicAllocator< ArgIface* > > m_argsSet;
 	//! Current command.
 	Command * m_command;
 	//! Option.
 	CmdLineOpts m_opt;
+	//! Index of the global arguments and commands.
+	ArgIndex m_index;
+	//! Indexes of the commands' arguments.
+	CommandsIndex m_commandsIndex;
+	//! Storage of the keys of the index.
+	Keys m_keys;
+	//! Table of the global flags.
+	FlagTable m_flags;
+	//! Tables of the flags of the commands.
+	CommandsFlags m_commandsFlags;
+	//! Table of the flags of the current command.
+	const FlagTable * m_commandFlags;
+	//! Trie of the global names and commands.
+	PrefixTrie m_abbreviations;
+	//! Tries of the names of the commands' arguments.
+	CommandsAbbreviations m_commandsAbbreviations;
+	//! Index of the global names and commands for suggestions.
+	SimilarityIndex m_suggestions;
+	//! Indexes of the names of the commands' arguments for suggestions.
+	CommandsSuggestions m_commandsSuggestions;
+	//! Are indexes for suggestions up to date?
+	bool m_isSuggestionsBuilt;
+	//! Static schema.
+	StaticSchemaView m_schema;
+	//! Arguments bound to the specs of the static schema.
+	std::vector< ArgIface*, PolymorphicAllocator< ArgIface* > > m_schemaArgs;
+	//! Command for which scope in the static schema is cached.
+	const Command * m_schemaCommand;
+	//! Scope of the current command in the static schema.
+	std::size_t m_schemaScope;
+	//! Is index up to date?
+	bool m_isIndexBuilt;
+	//! Are arguments checked and all tables built for parsing?
+	bool m_isPrepared;
+	//! Arguments touched by the parsing.
+	std::vector< ArgIface*, PolymorphicAllocator< ArgIface* > > m_touched;
+	//! Is sealed?
+	bool m_isSealed;
+#ifdef ARGS_ENABLE_PARSE_STATS
+	//! Statistics of the parsings.
+	ParseStats m_stats;
+#endif
 }; // class CmdLine
 
 
 //
-// makeContext
+// CmdLine
 //
 
-//! Make context from the argc and argv.
-static inline ContextInternal
+inline
+CmdLine::CmdLine( CmdLineOpts opt, MemoryResource * resource )
+	:	m_resource( resource )
+	,	m_context( resource )
+	,	m_argsSet( 0, std::hash< ArgIface* > (), std::equal_to< ArgIface* > (),
+			PolymorphicAllocator< ArgIface* > ( resource ) )
+	,	m_command( nullptr )
+	,	m_opt( opt )
+	,	m_index( ArgIndex::allocator_type( resource ) )
+	,	m_commandsIndex( CommandsIndex::allocator_type( resource ) )
+	,	m_keys( Keys::allocator_type( resource ) )
+	,	m_flags()
+	,	m_commandsFlags( CommandsFlags::allocator_type( resource ) )
+	,	m_commandFlags( nullptr )
+	,	m_abbreviations( resource )
+	,	m_commandsAbbreviations( CommandsAbbreviations::allocator_type( resource ) )
+	,	m_commandsSuggestions( CommandsSuggestions::allocator_type( resource ) )
+	,	m_isSuggestionsBuilt( false )
+	,	m_schemaArgs( PolymorphicAllocator< ArgIface* > ( resource ) )
+	,	m_schemaCommand( nullptr )
+	,	m_schemaScope( 0 )
+	,	m_isIndexBuilt( false )
+	,	m_isPrepared( false )
+	,	m_touched( PolymorphicAllocator< ArgIface* > ( resource ) )
+	,	m_isSealed( false )
+{
+}
+
+inline
 #ifdef ARGS_WSTRING_BUILD
-	makeContext( int argc, const Char * const * argv )
+	CmdLine::CmdLine( int argc, const Char * const * argv, CmdLineOpts opt,
+		MemoryResource * resource )
 #else
-	makeContext( int argc, const char * const * argv )
+	CmdLine::CmdLine( int argc, const char * const * argv, CmdLineOpts opt,
+		MemoryResource * resource )
 #endif
+	:	CmdLine( opt, resource )
 {
-	ContextInternal context;
+	setArgv( argc, argv );
+}
 
-	// We skip first argv because of it's executable name.
-	for( int i = 1; i < argc; ++i )
-		context.push_back( argv[ i ] );
+template< typename Iterator >
+inline
+CmdLine::CmdLine( Iterator first, Iterator last, CmdLineOpts opt,
+	MemoryResource * resource )
+	:	CmdLine( opt, resource )
+{
+	m_context.assign( first, last );
 
-	return context;
-} // makeContext
+	expandResponseFiles();
+}
 
+template< typename Container, typename >
+inline
+CmdLine::CmdLine( const Container & args, CmdLineOpts opt,
+	MemoryResource * resource )
+	:	CmdLine( opt, resource )
+{
+	m_context.assign( std::begin( args ), std::end( args ) );
 
-//
-// CmdLine
-//
+	expandResponseFiles();
+}
 
-inline
+inline void
 #ifdef ARGS_WSTRING_BUILD
-	CmdLine::CmdLine( int argc, const Char * const * argv, CmdLineOpts opt )
+	CmdLine::setArgv( int argc, const Char * const * argv )
 #else
-	CmdLine::CmdLine( int argc, const char * const * argv, CmdLineOpts opt )
+	CmdLine::setArgv( int argc, const char * const * argv )
 #endif
-	:	m_context( makeContext( argc, argv ) )
-	,	m_command( nullptr )
-	,	m_opt( opt )
 {
+	ARGS_PARSE_STATS( details::ParseStatsScope statsScope( m_stats ); )
+
+	// We skip first argv because of it's executable name.
+	if( argc > 1 )
+		m_context.assign( argv + 1, argv + argc );
+	else
+		m_context.assign( argv, argv );
+
+	expandResponseFiles();
+}
+
+inline void
+CmdLine::expandResponseFiles()
+{
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	if( m_opt & ExpandResponseFiles )
+		m_context.expandResponseFiles();
+#endif
 }
 
 inline void
 CmdLine::addArg( ArgIface * arg )
 {
+	if( m_isSealed )
+		throw BaseException( String( SL( "Arguments can't be added to "
+			"the sealed command line parser." ) ) );
+
 	if( arg )
 	{
-		if( std::find( m_args.begin(), m_args.end(), arg ) == m_args.end() )
+		if( m_argsSet.insert( arg ).second )
 		{
 			arg->setCmdLine( this );
 
 			m_args.push_back( arg );
+
+			argumentsChanged();
 		}
 		else
 			throw BaseException( String( SL( "Argument \"" ) ) +
@@ -172,155 +629,1286 @@ CmdLine::addArg( ArgIface & arg )
 	addArg( &arg );
 }
 
-inline void
-CmdLine::parse()
+namespace details {
+
+//! \return Pointer to the argument.
+inline ArgIface *
+argPointer( ArgIface * arg )
 {
-	checkCorrectnessBeforeParsing();
+	return arg;
+}
 
-	while( !m_context.atEnd() )
-	{
-		String word = *m_context.next();
+//! \return Pointer to the argument.
+inline ArgIface *
+argPointer( ArgIface & arg )
+{
+	return &arg;
+}
+
+} /* namespace details */
 
-		const String::size_type eqIt = word.find( '=' );
+template< typename Iterator >
+inline void
+CmdLine::addArgs( Iterator first, Iterator last )
+{
+	const std::size_t count = m_args.size();
 
-		if( eqIt != String::npos )
+	auto rollback = [&] () {
+		while( m_args.size() > count )
 		{
-			const String value = word.substr( eqIt + 1 );
+			m_args.back()->setCmdLine( nullptr );
+			m_argsSet.erase( m_args.back() );
+			m_args.pop_back();
+		}
+	};
 
-			if( !value.empty() )
-				m_context.prepend( value );
+	for( ; first != last; ++first )
+	{
+		try {
+			addArg( details::argPointer( *first ) );
+		}
+		catch( const BaseException & )
+		{
+			rollback();
 
-			word = word.substr( 0, eqIt );
+			throw;
 		}
+	}
 
-		if( isArgument( word ) )
-			findArgument( word )->process( m_context );
-		else if( isFlag( word ) )
+	if( m_schema.isNull() )
+	{
+		const ParseStatus status = checkCorrectnessBeforeParsing();
+
+		if( !status.isOk() )
 		{
-			for( String::size_type i = 1, length = word.length(); i < length; ++i )
-			{
-				const String flag = String( SL( "-" ) ) +
+			rollback();
 
-#ifdef ARGS_QSTRING_BUILD
-					String( word[ i ] );
-#else
-					String( 1, word[ i ] );
-#endif
+			throw BaseException( status.description() );
+		}
+	}
+}
 
-				ArgIface * arg = findArgument( flag );
+template< typename Container, typename >
+inline void
+CmdLine::addArgs( const Container & args )
+{
+	addArgs( std::begin( args ), std::end( args ) );
+}
 
-				if( i < length - 1 && arg->isWithValue() )
-					throw BaseException( String( SL( "Only last argument in "
-						"flags combo can have value. Flags combo is\"" ) ) +
-						word + SL( "\"." ) );
-				else
-					arg->process( m_context );
-			}
-		}
-		// Command?
+inline void
+CmdLine::parse()
+{
+	ParseStatus status;
+
+	if( !parse( status ) )
+	{
+		if( status.isHelpPrinted() )
+			throw HelpHasBeenPrintedException();
 		else
-		{
-			ArgIface * tmp = findArgument( word );
+			throw BaseException( status.description() );
+	}
+}
 
-			if( tmp )
-			{
-				Command * cmd = dynamic_cast< Command* > ( tmp );
+inline ParseStatus
+CmdLine::prepare()
+{
+	ARGS_PARSE_STATS( details::ParseTimer timer( &ParseStats::m_beforeParsingTime ); )
 
-				if( cmd )
-				{
-					if( m_command )
-						throw BaseException( String( SL( "Only one command can be "
-							"specified. But you entered \"" ) ) + m_command->name() +
-							SL( "\" and \"" ) + cmd->name() + SL( "\"." ) );
-					else
-					{
-						m_command = cmd;
+	// Nothing is rebuilt till arguments are changed, so parsings of the
+	// unsealed command line don't allocate.
+	if( m_isPrepared )
+		return ParseStatus();
 
-						m_command->process( m_context );
-					}
-				}
-				// Argument is as a command
-				else
-					tmp->process( m_context );
-			}
-			else
-				throw BaseException( String( SL( "Unknown argument \"" ) ) +
-					word + SL( "\"." ) );
-		}
+	ParseStatus status;
+
+	if( m_schema.isNull() )
+	{
+		status = checkCorrectnessBeforeParsing();
+
+		if( status.isOk() && !m_isIndexBuilt )
+			buildIndex();
+	}
+	else
+		status = bindSchema();
+
+	if( status.isOk() )
+	{
+		buildFlagTables();
+		buildAbbreviations();
+
+		m_isPrepared = true;
 	}
 
-	checkCorrectnessAfterParsing();
+	return status;
 }
 
-inline const std::list< ArgIface* > &
-CmdLine::arguments() const
+inline void
+CmdLine::buildFlagTables()
 {
-	return m_args;
+	Command * current = m_command;
+
+	m_command = nullptr;
+	fillFlagTable( m_flags );
+	m_command = current;
+
+	// Tables of the commands are filled when command is found.
+	m_commandsFlags.clear();
+	m_commandFlags = nullptr;
+
+	if( m_command )
+		setCommandFlags();
 }
 
 inline void
-CmdLine::checkCorrectnessBeforeParsing() const
+CmdLine::setCommandFlags()
 {
-	StringList flags;
-	StringList names;
+	auto it = m_commandsFlags.find( m_command );
 
-	std::list< ArgIface* > cmds;
+	// emplace() allocates node even if key exists.
+	if( it == m_commandsFlags.end() )
+	{
+		it = m_commandsFlags.emplace( m_command, FlagTable() ).first;
 
-	std::for_each( m_args.cbegin(), m_args.cend(),
-		[ &cmds, &flags, &names ] ( ArgIface * arg )
-		{
-			if( dynamic_cast< Command* > ( arg ) )
-				cmds.push_back( arg );
-			else
-				arg->checkCorrectnessBeforeParsing( flags, names );
-		}
-	);
+		fillFlagTable( it->second );
+	}
 
-	std::for_each( cmds.cbegin(), cmds.cend(),
-		[ &flags, &names ] ( ArgIface * arg )
-			{ arg->checkCorrectnessBeforeParsing( flags, names ); }
-	);
+	m_commandFlags = &it->second;
 }
 
 inline void
-CmdLine::checkCorrectnessAfterParsing() const
+CmdLine::fillFlagTable( FlagTable & table )
 {
-	std::for_each( m_args.begin(), m_args.end(),
-		[] ( ArgIface * arg )
-			{ arg->checkCorrectnessAfterParsing(); }
-	);
+	Char flag[ 2 ] = { SL( '-' ), SL( '-' ) };
 
-	if( m_opt == CommandIsRequired && !m_command )
-		throw BaseException( SL( "Not specified command." ) );
+	for( std::size_t i = 0; i < table.size(); ++i )
+	{
+		flag[ 1 ] = Char( static_cast< char > ( i ) );
+
+		// Flags are alphanumeric, see isCorrectFlag().
+		table[ i ] = ( std::isalnum( static_cast< int > ( i ) ) ?
+			tryFindArgument( StringView( flag, 2 ) ) : nullptr );
+	}
 }
 
-inline ArgIface *
-CmdLine::findArgument( const String & name )
+//! \return Key of the spec in the static schema.
+static inline String
+staticSpecKey( const StaticArgSpec & spec )
+{
+	if( spec.kind() != StaticArgKind::Argument )
+		return String( spec.name() );
+	else if( spec.hasName() )
+		return String( SL( "--" ) ) + String( spec.name() );
+	else
+		return String( SL( "-" ) ) + String( 1, spec.flag() );
+}
+
+template< typename Func >
+inline void
+CmdLine::forEachLongName( ArgIface * arg, const Command * scope, Func & func )
 {
-	std::list< ArgIface* >::iterator it = std::find_if( m_args.begin(),
-		m_args.end(), [ &name ] ( ArgIface * arg ) -> bool
-			{ return ( arg->isItYou( name ) != nullptr ); } );
+	Command * cmd = details::asCommand( arg );
 
-	if( it != m_args.end() )
+	if( cmd )
 	{
-		Command * tmp = dynamic_cast< Command* > ( *it );
+		func( scope, cmd->name(), cmd );
 
-		if( tmp )
-			return tmp;
+		for( const auto & child : cmd->children() )
+			forEachLongName( child, cmd, func );
+
+		return;
 	}
 
-	if( it != m_args.end() )
-		return (*it)->isItYou( name );
-	else if( m_command )
+	GroupIface * g = details::asGroup( arg );
+
+	if( g )
+	{
+		for( const auto & child : g->children() )
+			forEachLongName( child, scope, func );
+
+		return;
+	}
+
+	// Flags and words of ArgAsCommand are skipped.
+	if( !arg->argumentName().empty() )
+		func( scope, String( SL( "--" ) ) + arg->argumentName(), arg );
+
+	for( const auto & alias : arg->aliases() )
+	{
+		if( isArgument( alias ) )
+			func( scope, alias, arg );
+	}
+}
+
+inline void
+CmdLine::buildAbbreviations()
+{
+	m_abbreviations.clear();
+	m_commandsAbbreviations.clear();
+
+	if( !( m_opt & AllowAbbreviations ) )
+		return;
+
+	auto add = [ this ] ( const Command * cmd, const String & name,
+		ArgIface * arg )
+	{
+		if( cmd )
+			m_commandsAbbreviations.emplace( cmd,
+				PrefixTrie( m_resource ) ).first->second.insert( name, arg );
+		else
+			m_abbreviations.insert( name, arg );
+	};
+
+	for( const auto & arg : m_args )
+		forEachLongName( arg, nullptr, add );
+}
+
+inline void
+CmdLine::buildSuggestions()
+{
+	m_suggestions.clear();
+	m_commandsSuggestions.clear();
+
+	// Names are taken from the index of the arguments, so suggested
+	// names are always the ones that can be found.
+	if( m_schema.isNull() )
+	{
+		if( !m_isIndexBuilt )
+			buildIndex();
+
+		// Flags and words of ArgAsCommand are skipped.
+		for( const auto & key : m_index )
+		{
+			if( isArgument( key.first ) ||
+				key.second->kind() == ArgKind::Command )
+					m_suggestions.insert( key.first.toString() );
+		}
+
+		for( const auto & children : m_commandsIndex )
+		{
+			SimilarityIndex & index = m_commandsSuggestions.emplace(
+				children.first, SimilarityIndex() ).first->second;
+
+			for( const auto & key : children.second )
+			{
+				if( isArgument( key.first ) )
+					index.insert( key.first.toString() );
+			}
+		}
+	}
+	else
+	{
+		if( !m_isIndexBuilt )
+			bindSchema();
+
+		for( std::size_t i = 0; i < m_schema.size(); ++i )
+		{
+			const StaticArgSpec & spec = m_schema.spec( i );
+
+			if( !m_schemaArgs[ i ] || ( spec.kind() != StaticArgKind::Command &&
+				( spec.kind() != StaticArgKind::Argument || !spec.hasName() ) ) )
+					continue;
+
+			// Command of the argument, if any, through the groups.
+			std::size_t parent = m_schema.parent( i );
+
+			while( parent != StaticSchemaView::npos &&
+				m_schema.spec( parent ).kind() != StaticArgKind::Command )
+					parent = m_schema.parent( parent );
+
+			const Command * cmd = ( parent == StaticSchemaView::npos ? nullptr :
+				details::asCommand( m_schemaArgs[ parent ] ) );
+
+			if( cmd )
+				m_commandsSuggestions.emplace( cmd, SimilarityIndex() ).first->
+					second.insert( staticSpecKey( spec ) );
+			else
+				m_suggestions.insert( staticSpecKey( spec ) );
+		}
+	}
+
+	m_isSuggestionsBuilt = true;
+}
+
+inline std::vector< String >
+CmdLine::suggestions( const StringView & name, std::size_t count )
+{
+	std::vector< String > result;
+
+	// Flags are too short to be similar to something.
+	if( count == 0 || isFlag( name ) )
+		return result;
+
+	if( !m_isSuggestionsBuilt )
+		buildSuggestions();
+
+	const bool isLongName = isArgument( name );
+	const std::size_t length = ( isLongName ? name.size() - 2 : name.size() );
+	const std::size_t maxDistance = std::max< std::size_t > ( 1, length / 3 );
+
+	// Names with most common bigrams are the nearest ones usually, so
+	// a few of them are compared even if thousands of names are alike.
+	const std::size_t maxCandidates = std::max< std::size_t > ( count, 64 );
+
+	std::vector< SimilarityIndex::Match > matches;
+
+	m_suggestions.find( name, maxDistance, matches, maxCandidates );
+
+	if( m_command )
+	{
+		const auto it = m_commandsSuggestions.find( m_command );
+
+		if( it != m_commandsSuggestions.cend() )
+			it->second.find( name, maxDistance, matches, maxCandidates );
+	}
+
+	std::sort( matches.begin(), matches.end(),
+		[] ( const SimilarityIndex::Match & m1,
+			const SimilarityIndex::Match & m2 )
+		{
+			const StringView v1( m1.second );
+			const StringView v2( m2.second );
+
+			return ( m1.first < m2.first || ( m1.first == m2.first &&
+				std::lexicographical_compare( v1.begin(), v1.end(),
+					v2.begin(), v2.end() ) ) );
+		} );
+
+	for( const auto & match : matches )
 	{
-		ArgIface * tmp = m_command->isItYourChild( name );
+		if( result.size() == count )
+			break;
+
+		// Long names for long name, commands for word.
+		if( isArgument( match.second ) != isLongName ||
+			( !result.empty() && match.second == result.back() ) )
+				continue;
+
+		result.push_back( match.second.toString() );
+	}
+
+	return result;
+}
+
+inline bool
+CmdLine::findAbbreviation( const StringView & word, TokenKind kind,
+	std::size_t token, ArgIface * & arg, ParseStatus & status )
+{
+	arg = nullptr;
+
+	if( !( m_opt & AllowAbbreviations ) )
+		return true;
+
+	// Names of the commands never start with "-", so such word would
+	// match only long names, i.e. "-" or "--name" after the end of options.
+	if( kind != TokenKind::Long && ( ( kind != TokenKind::Word &&
+		kind != TokenKind::Operand ) || word.empty() || word[ 0 ] == SL( '-' ) ) )
+			return true;
+
+	bool ambiguous = false;
+
+	arg = m_abbreviations.find( word, ambiguous );
+
+	const PrefixTrie * children = nullptr;
+
+	if( m_command )
+	{
+		const auto it = m_commandsAbbreviations.find( m_command );
+
+		if( it != m_commandsAbbreviations.cend() )
+			children = &it->second;
+	}
+
+	if( children && !ambiguous )
+	{
+		bool childAmbiguous = false;
+
+		ArgIface * child = children->find( word, childAmbiguous );
+
+		if( childAmbiguous || ( arg && child && arg != child ) )
+			ambiguous = true;
+		else if( child )
+			arg = child;
+	}
+
+	if( ambiguous )
+	{
+		arg = nullptr;
+
+		std::vector< String > candidates;
+
+		m_abbreviations.collect( word, candidates );
+
+		if( children )
+			children->collect( word, candidates );
+
+		std::sort( candidates.begin(), candidates.end(),
+			[] ( const String & s1, const String & s2 )
+			{
+				const StringView v1( s1 );
+				const StringView v2( s2 );
+
+				return std::lexicographical_compare( v1.begin(), v1.end(),
+					v2.begin(), v2.end() );
+			} );
+
+		status = ParseStatus( ParseError::AmbiguousArgument, token,
+			word.toString() );
+		status.setCandidates( std::move( candidates ) );
+
+		return false;
+	}
+
+	return true;
+}
+
+inline ArgIface *
+CmdLine::findFlag( Char flag ) const
+{
+	const unsigned int code = details::charCode( flag );
+
+	if( code >= m_flags.size() )
+		return nullptr;
+
+	return ( m_commandFlags ? ( *m_commandFlags )[ code ] : m_flags[ code ] );
+}
+
+inline void
+CmdLine::seal()
+{
+	ParseStatus status;
+
+	if( !seal( status ) )
+		throw BaseException( status.description() );
+}
+
+inline bool
+CmdLine::seal( ParseStatus & status )
+{
+	ARGS_PARSE_STATS( details::ParseStatsScope statsScope( m_stats ); )
+
+	if( !m_isSealed )
+	{
+		status = prepare();
+
+		m_isSealed = status.isOk();
+	}
+	else
+		status = ParseStatus();
+
+	return m_isSealed;
+}
+
+inline bool
+CmdLine::isSealed() const
+{
+	return m_isSealed;
+}
+
+inline void
+CmdLine::argumentsChanged()
+{
+	// Sealed command line keeps its index.
+	if( !m_isSealed )
+	{
+		m_isIndexBuilt = false;
+		m_isPrepared = false;
+	}
+}
+
+inline std::size_t
+CmdLine::addToFingerprint( std::size_t fingerprint, const ArgIface * arg )
+{
+	const StringViewHash hash;
+
+	const auto mix = [ &fingerprint ] ( std::size_t value )
+	{
+		fingerprint = ( fingerprint ^ value ) *
+			static_cast< std::size_t > ( 1099511628211ULL );
+	};
+
+	const GroupIface * g = details::asGroup( arg );
+
+	mix( arg->kind() == ArgKind::Command ? 1 : ( g ? 2 : 3 ) );
+	mix( hash( arg->flag() ) );
+	mix( hash( arg->argumentName() ) );
+	mix( hash( arg->name() ) );
+
+	for( const auto & alias : arg->aliases() )
+		mix( hash( alias ) );
+	mix( arg->isWithValue() ? 1 : 0 );
+	mix( arg->isRequired() ? 1 : 0 );
+
+	if( g )
+	{
+		mix( g->children().size() );
+
+		for( const auto & child : g->children() )
+			fingerprint = addToFingerprint( fingerprint, child );
+	}
+
+	return fingerprint;
+}
+
+inline std::size_t
+CmdLine::fingerprint() const
+{
+	std::size_t fingerprint = static_cast< std::size_t > ( m_opt );
+
+	for( const auto & arg : m_args )
+		fingerprint = addToFingerprint( fingerprint, arg );
+
+	return fingerprint;
+}
+
+inline bool
+CmdLine::parse( ParseStatus & status )
+{
+	ARGS_PARSE_STATS( details::ParseStatsScope statsScope( m_stats ); )
+
+	if( !m_isSealed )
+	{
+		status = prepare();
+
+		if( !status.isOk() )
+			return false;
+	}
+
+	ARGS_PARSE_STATS( details::ParseTimer loopTimer( &ParseStats::m_tokenLoopTime ); )
+
+	while( !m_context.atEnd() )
+	{
+		const auto it = m_context.next();
+		const Token t = m_context.token( it );
+		const StringView word = t.name( *it );
+
+		const std::size_t token = m_context.index();
+
+		ARGS_PARSE_STATS( details::addParseStat( &ParseStats::m_tokens ); )
+
+		if( t.kind() == TokenKind::EndOfOptions )
+			continue;
+
+		if( t.hasValue( *it ) )
+		{
+			const StringView value = t.value( *it );
+
+			if( !value.empty() )
+				m_context.prepend( value, TokenKind::Value );
+		}
+
+		if( t.kind() == TokenKind::Long )
+		{
+			ArgIface * arg = tryFindArgument( word );
+
+			if( !arg && !findAbbreviation( word, t.kind(), token, arg, status ) )
+				return false;
+
+			if( !arg )
+			{
+				status = ParseStatus( ParseError::UnknownArgument, token,
+					word.toString() );
+				status.setCandidates( suggestions( word ) );
+
+				return false;
+			}
+
+			if( !process( arg, token, status ) )
+				return false;
+		}
+		else if( t.kind() == TokenKind::Short )
+		{
+			Char flag[ 2 ] = { SL( '-' ), SL( '-' ) };
+
+			for( StringView::size_type i = 1, length = word.size(); i < length; ++i )
+			{
+				flag[ 1 ] = word[ i ];
+
+				ArgIface * arg = findFlag( word[ i ] );
+
+				if( !arg )
+				{
+					status = ParseStatus( ParseError::UnknownArgument, token,
+						StringView( flag, 2 ).toString() );
+
+					return false;
+				}
+
+				if( i < length - 1 && arg->isWithValue() )
+				{
+					status = ParseStatus( ParseError::ValueInFlagsCombo, token,
+						word.toString() );
+
+					return false;
+				}
+				else if( !process( arg, token, status ) )
+					return false;
+			}
+		}
+		// Command?
+		else
+		{
+			ArgIface * tmp = tryFindArgument( word );
+
+			if( !tmp && !findAbbreviation( word, t.kind(), token, tmp, status ) )
+				return false;
+
+			// Words after end of options can't be flags or arguments.
+			if( tmp && ( !tmp->flag().empty() || !tmp->argumentName().empty() ) )
+				tmp = nullptr;
+
+			if( tmp )
+			{
+				Command * cmd = details::asCommand( tmp );
+
+				if( cmd )
+				{
+					if( m_command )
+					{
+						status = ParseStatus( ParseError::OnlyOneCommand,
+							m_command, cmd );
+						status.setToken( token );
+
+						return false;
+					}
+					else
+					{
+						m_command = cmd;
+
+						setCommandFlags();
+
+						if( !process( m_command, token, status ) )
+							return false;
+					}
+				}
+				// Argument is as a command
+				else if( !process( tmp, token, status ) )
+					return false;
+			}
+			else
+			{
+				status = ParseStatus( ParseError::UnknownArgument, token,
+					word.toString() );
+				status.setCandidates( suggestions( word ) );
+
+				return false;
+			}
+		}
+	}
+
+	ARGS_PARSE_STATS( loopTimer.stop(); )
+
+	status = checkCorrectnessAfterParsing();
+
+	return status.isOk();
+}
+
+inline void
+#ifdef ARGS_WSTRING_BUILD
+	CmdLine::parse( int argc, const Char * const * argv )
+#else
+	CmdLine::parse( int argc, const char * const * argv )
+#endif
+{
+	reset();
+	setArgv( argc, argv );
+	parse();
+}
+
+inline bool
+#ifdef ARGS_WSTRING_BUILD
+	CmdLine::parse( int argc, const Char * const * argv, ParseStatus & status )
+#else
+	CmdLine::parse( int argc, const char * const * argv, ParseStatus & status )
+#endif
+{
+	reset();
+	setArgv( argc, argv );
+
+	return parse( status );
+}
+
+inline void
+CmdLine::reset()
+{
+	for( const auto & arg : m_touched )
+		arg->clear();
+
+	m_touched.clear();
+	m_command = nullptr;
+	m_commandFlags = nullptr;
+}
+
+inline bool
+CmdLine::process( ArgIface * arg, std::size_t token, ParseStatus & status )
+{
+	ARGS_PARSE_STATS( details::ParseTimer timer( &ParseStats::m_valuesTime ); )
+
+	if( !arg->isDefined() )
+		m_touched.push_back( arg );
+
+	ParseError error = ParseError::None;
+
+	// Arguments written before parsing without exceptions still throw.
+	try {
+		error = arg->tryProcess( m_context );
+	}
+	catch( const HelpHasBeenPrintedException & )
+	{
+		error = ParseError::HelpHasBeenPrinted;
+	}
+	catch( const BaseException & x )
+	{
+		status = arg->exceptionStatus( x );
+		status.setToken( token );
+
+		return false;
+	}
+
+	if( error != ParseError::None )
+	{
+		status = ParseStatus( error, arg );
+		status.setToken( token );
+
+		// Incorrect value is left in the context as the next item.
+		if( error == ParseError::InvalidValue && !m_context.atEnd() )
+		{
+			status.setToken( m_context.index() + 1 );
+			status.setWord( m_context.begin()->toString() );
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+#ifdef ARGS_ENABLE_PARSE_STATS
+inline const ParseStats &
+CmdLine::parseStats() const
+{
+	return m_stats;
+}
+
+inline void
+CmdLine::resetParseStats()
+{
+	m_stats = ParseStats();
+}
+#endif
+
+inline const std::list< ArgIface* > &
+CmdLine::arguments() const
+{
+	return m_args;
+}
+
+inline MemoryResource *
+CmdLine::memoryResource() const
+{
+	return m_resource;
+}
+
+inline ParseStatus
+CmdLine::checkCorrectnessBeforeParsing() const
+{
+	NameSet flags( m_resource );
+	NameSet names( m_resource );
+
+	std::vector< ArgIface*, PolymorphicAllocator< ArgIface* > > cmds( m_resource );
+
+	for( const auto & arg : m_args )
+	{
+		if( arg->kind() == ArgKind::Command )
+			cmds.push_back( arg );
+		else
+		{
+			ParseStatus status = arg->tryCheckCorrectnessBeforeParsing(
+				flags, names );
+
+			if( !status.isOk() )
+				return status;
+		}
+	}
+
+	for( const auto & arg : cmds )
+	{
+		ParseStatus status = arg->tryCheckCorrectnessBeforeParsing(
+			flags, names );
+
+		if( !status.isOk() )
+			return status;
+	}
+
+	return ParseStatus();
+}
+
+inline ParseStatus
+CmdLine::checkCorrectnessAfterParsing() const
+{
+	ARGS_PARSE_STATS( details::ParseTimer timer( &ParseStats::m_afterParsingTime ); )
+
+	for( const auto & arg : m_args )
+	{
+		ParseStatus status = arg->tryCheckCorrectnessAfterParsing();
+
+		if( !status.isOk() )
+			return status;
+	}
+
+	if( ( m_opt & CommandIsRequired ) && !m_command )
+		return ParseStatus( ParseError::CommandNotSpecified );
+
+	return ParseStatus();
+}
+
+inline void
+CmdLine::addToIndex( ArgIndex & index, ArgIface * arg )
+{
+	Command * cmd = details::asCommand( arg );
+
+	if( cmd )
+	{
+		addKey( index, cmd->name(), cmd );
+
+		ArgIndex & children = m_commandsIndex.emplace( cmd,
+			ArgIndex( ArgIndex::allocator_type( m_resource ) ) ).first->second;
+
+		for( const auto & child : cmd->children() )
+			addToIndex( children, child );
+
+		return;
+	}
+
+	GroupIface * g = details::asGroup( arg );
+
+	if( g )
+	{
+		for( const auto & child : g->children() )
+			addToIndex( index, child );
+
+		return;
+	}
+
+	// First registered argument wins as it was with linear search.
+	if( !arg->flag().empty() )
+		addKey( index, String( SL( "-" ) ) + arg->flag(), arg );
+
+	if( !arg->argumentName().empty() )
+		addKey( index, String( SL( "--" ) ) + arg->argumentName(), arg );
+
+	if( arg->flag().empty() && arg->argumentName().empty() )
+		addKey( index, arg->name(), arg );
+
+	for( const auto & alias : arg->aliases() )
+		addKey( index, alias, arg );
+}
+
+inline void
+CmdLine::addKey( ArgIndex & index, String key, ArgIface * arg )
+{
+	if( index.find( StringView( key ) ) == index.cend() )
+	{
+		m_keys.push_back( std::move( key ) );
+
+		index.emplace( StringView( m_keys.back() ), arg );
+	}
+}
+
+inline void
+CmdLine::buildIndex()
+{
+	m_index.clear();
+	m_commandsIndex.clear();
+	m_keys.clear();
+
+	for( const auto & arg : m_args )
+		addToIndex( m_index, arg );
+
+	m_isIndexBuilt = true;
+	m_isSuggestionsBuilt = false;
+}
+
+inline ArgIface *
+CmdLine::tryFindArgument( const String & name )
+{
+	return tryFindArgument( StringView( name ) );
+}
+
+inline ArgIface *
+CmdLine::tryFindArgument( const StringView & name )
+{
+	if( !m_schema.isNull() )
+		return findInSchema( name );
+
+	if( !m_isIndexBuilt )
+		buildIndex();
+
+	ARGS_PARSE_STATS( details::addParseStat( &ParseStats::m_findArgumentProbes ); )
+
+	auto it = m_index.find( name );
+
+	if( it != m_index.cend() )
+		return it->second;
+	else if( m_command )
+	{
+		const auto children = m_commandsIndex.find( m_command );
+
+		if( children != m_commandsIndex.cend() )
+		{
+			ARGS_PARSE_STATS( details::addParseStat( &ParseStats::m_findArgumentProbes ); )
+
+			auto cit = children->second.find( name );
+
+			if( cit != children->second.cend() )
+				return cit->second;
+		}
+	}
+
+	return nullptr;
+}
+
+inline ArgIface *
+CmdLine::findArgument( const String & name )
+{
+	return findArgument( StringView( name ) );
+}
+
+inline ArgIface *
+CmdLine::findArgument( const StringView & name )
+{
+	ArgIface * arg = tryFindArgument( name );
+
+	if( arg )
+		return arg;
+
+	ParseStatus status( ParseError::UnknownArgument, ParseStatus::npos,
+		name.toString() );
+	status.setCandidates( suggestions( name ) );
+
+	throw BaseException( status.description() );
+}
+
+template< std::size_t N >
+inline void
+CmdLine::setSchema( const StaticSchema< N > & schema )
+{
+	if( schema.error() != StaticSchemaError::None )
+		throw BaseException( String( SL( "Incorrect static schema." ) ) );
+
+	if( m_isSealed )
+		throw BaseException( String( SL( "Schema can't be set to "
+			"the sealed command line parser." ) ) );
+
+	m_schema = schema.view();
+	m_isIndexBuilt = false;
+	m_isPrepared = false;
+}
+
+inline ParseStatus
+CmdLine::bindSchema()
+{
+	m_schemaArgs.assign( m_schema.size(), nullptr );
+	m_schemaCommand = nullptr;
+	m_isIndexBuilt = true;
+	m_isSuggestionsBuilt = false;
+
+	for( const auto & arg : m_args )
+	{
+		ParseStatus status = bindToSchema( arg, 0, StaticSchemaView::npos );
+
+		if( !status.isOk() )
+			return status;
+	}
+
+	for( std::size_t i = 0; i < m_schemaArgs.size(); ++i )
+	{
+		if( !m_schemaArgs[ i ] )
+			return ParseStatus( ParseError::SchemaMismatch, ParseStatus::npos,
+				staticSpecKey( m_schema.spec( i ) ) );
+	}
+
+	return ParseStatus();
+}
+
+inline ParseStatus
+CmdLine::bindToSchema( ArgIface * arg, std::size_t scope, std::size_t parent )
+{
+	const ParseStatus mismatch( ParseError::SchemaMismatch, arg );
+
+	Command * cmd = details::asCommand( arg );
+
+	if( cmd )
+	{
+		const std::size_t i = m_schema.find( 0, StringView( cmd->name() ) );
+
+		if( i == StaticSchemaView::npos || m_schemaArgs[ i ] ||
+			parent != StaticSchemaView::npos ||
+			m_schema.spec( i ).kind() != StaticArgKind::Command ||
+			m_schema.spec( i ).isWithValue() != cmd->isWithValue() )
+				return mismatch;
+
+		m_schemaArgs[ i ] = cmd;
+
+		for( const auto & child : cmd->children() )
+		{
+			ParseStatus status = bindToSchema( child, i + 1, i );
+
+			if( !status.isOk() )
+				return status;
+		}
+
+		return ParseStatus();
+	}
+
+	GroupIface * g = details::asGroup( arg );
+
+	if( g )
+	{
+		const std::size_t i = m_schema.findGroup( scope, StringView( g->name() ) );
+
+		if( i == StaticSchemaView::npos || m_schemaArgs[ i ] ||
+			m_schema.parent( i ) != parent ||
+			m_schema.spec( i ).isRequired() != g->isRequired() )
+				return mismatch;
+
+		m_schemaArgs[ i ] = g;
+
+		for( const auto & child : g->children() )
+		{
+			ParseStatus status = bindToSchema( child, scope, i );
+
+			if( !status.isOk() )
+				return status;
+		}
+
+		return ParseStatus();
+	}
+
+	const bool isWord = ( arg->flag().empty() && arg->argumentName().empty() );
+
+	// Lookup through the perfect hash without building of the key.
+	std::size_t i = StaticSchemaView::npos;
+
+	if( !arg->flag().empty() )
+		i = m_schema.findFlag( scope, StringView( arg->flag() ) );
+	else if( !arg->argumentName().empty() )
+		i = m_schema.findName( scope, StringView( arg->argumentName() ) );
+	else
+		i = m_schema.find( scope, StringView( arg->name() ) );
+
+	if( i == StaticSchemaView::npos || m_schemaArgs[ i ] ||
+		m_schema.parent( i ) != parent )
+			return mismatch;
+
+	const StaticArgSpec & spec = m_schema.spec( i );
+
+	if( spec.kind() != ( isWord ? StaticArgKind::ArgAsCommand :
+			StaticArgKind::Argument ) ||
+		spec.isWithValue() != arg->isWithValue() ||
+		spec.isRequired() != arg->isRequired() ||
+		// Aliases aren't described by the static schema.
+		!arg->aliases().empty() )
+			return mismatch;
+
+	if( !isWord )
+	{
+		const bool isFlagMatched = ( spec.hasFlag() ?
+			m_schema.findFlag( scope, StringView( arg->flag() ) ) == i :
+			arg->flag().empty() );
+		const bool isNameMatched = ( spec.hasName() ?
+			m_schema.findName( scope, StringView( arg->argumentName() ) ) == i :
+			arg->argumentName().empty() );
+
+		if( !isFlagMatched || !isNameMatched )
+			return mismatch;
+	}
+
+	m_schemaArgs[ i ] = arg;
+
+	return ParseStatus();
+}
+
+inline ArgIface *
+CmdLine::findInSchema( const StringView & name )
+{
+	if( !m_isIndexBuilt )
+		bindSchema();
+
+	ARGS_PARSE_STATS( details::addParseStat( &ParseStats::m_findArgumentProbes ); )
+
+	std::size_t i = m_schema.find( 0, name );
+
+	if( i == StaticSchemaView::npos && m_command )
+	{
+		if( m_command != m_schemaCommand )
+		{
+			m_schemaCommand = m_command;
+			m_schemaScope = static_cast< std::size_t > ( std::distance(
+				m_schemaArgs.cbegin(), std::find( m_schemaArgs.cbegin(),
+					m_schemaArgs.cend(), m_command ) ) ) + 1;
+		}
+
+		ARGS_PARSE_STATS( details::addParseStat( &ParseStats::m_findArgumentProbes ); )
+
+		i = m_schema.find( m_schemaScope, name );
+	}
+
+	return ( i == StaticSchemaView::npos ? nullptr : m_schemaArgs[ i ] );
+}
+
+
+//
+// ParseStatus
+//
+
+//! \return Quoted candidates, i.e. "a", "b" or "c".
+static inline String
+candidatesList( const std::vector< String > & candidates )
+{
+	String list;
+
+	for( std::size_t i = 0; i < candidates.size(); ++i )
+	{
+		if( i > 0 )
+			list = list + ( i + 1 < candidates.size() ?
+				SL( ", " ) : SL( " or " ) );
+
+		list = list + SL( "\"" ) + candidates[ i ] + SL( "\"" );
+	}
+
+	return list;
+}
+
+inline String
+ParseStatus::description() const
+{
+	const bool isCommand = ( m_arg && m_arg->kind() == ArgKind::Command );
+
+	switch( m_error )
+	{
+		case ParseError::None :
+			return String();
+
+		case ParseError::HelpHasBeenPrinted :
+			return String( SL( "Help has been printed." ) );
+
+		case ParseError::UnknownArgument :
+			return String( SL( "Unknown argument \"" ) ) + m_word + SL( "\"." ) +
+				( m_candidates.empty() ? String() : String( SL( " Did you mean " ) ) +
+					candidatesList( m_candidates ) + SL( "?" ) );
+
+		case ParseError::ValueInFlagsCombo :
+			return String( SL( "Only last argument in flags combo can have "
+				"value. Flags combo is \"" ) ) + m_word + SL( "\"." );
+
+		case ParseError::OnlyOneCommand :
+			return String( SL( "Only one command can be specified. "
+				"But you entered \"" ) ) + m_arg->name() + SL( "\" and \"" ) +
+				m_other->name() + SL( "\"." );
+
+		case ParseError::ValueRequired :
+			return String( isCommand ? SL( "Command \"" ) : SL( "Argument \"" ) ) +
+				m_arg->name() + SL( "\" require value that wasn't presented." );
+
+		case ParseError::AlreadyDefined :
+			return String( SL( "Argument \"" ) ) + m_arg->name() +
+				SL( "\" already defined." );
+
+		case ParseError::UndefinedRequiredArgument :
+			return String( SL( "Undefined required argument \"" ) ) +
+				m_arg->name() + SL( "\"." );
+
+		case ParseError::CommandNotSpecified :
+			return String( SL( "Not specified command." ) );
+
+		case ParseError::OnlyOneGroupViolation :
+			return String( SL( "Only one argument can be defined in OnlyOne "
+				"group \"" ) ) + m_group->name() + SL( "\". Whereas defined \"" ) +
+				m_arg->name() + SL( "\" and \"" ) + m_other->name() + SL( "\"." );
+
+		case ParseError::AllOfGroupViolation :
+			return String( SL( "All arguments in AllOf group \"" ) ) +
+				m_arg->name() + SL( "\" should be defined." );
+
+		case ParseError::FlagRedefinition :
+			return String( SL( "Redefinition of argument with flag \"" ) ) +
+				( m_word.empty() ? String( SL( "-" ) ) + m_arg->flag() : m_word ) +
+				SL( "\"." );
+
+		case ParseError::NameRedefinition :
+			return String( isCommand ? SL( "Redefinition of command with name \"" ) :
+				SL( "Redefinition of argument with name \"" ) ) +
+				( m_word.empty() ? m_arg->name() : m_word ) + SL( "\"." );
+
+		case ParseError::DisallowedFlag :
+			return String( SL( "Dissallowed flag \"" ) ) +
+				( m_word.empty() ? String( SL( "-" ) ) + m_arg->flag() : m_word ) +
+				SL( "\"." );
+
+		case ParseError::DisallowedName :
+			return String( SL( "Dissallowed name \"" ) ) +
+				( m_word.empty() ? m_arg->name() : m_word ) +
+				( isCommand ? SL( "\" for the command." ) : SL( "\"." ) );
+
+		case ParseError::EmptyFlagAndName :
+			return String( SL( "Arguments with empty flag and name "
+				"are dissallowed." ) );
+
+		case ParseError::RequiredArgumentInGroup :
+		{
+			String kind;
+
+			switch( m_group->kind() )
+			{
+				case ArgKind::OnlyOneGroup :
+					kind = SL( "OnlyOne " );
+					break;
+
+				case ArgKind::AllOfGroup :
+					kind = SL( "AllOf " );
+					break;
+
+				case ArgKind::AtLeastOneGroup :
+					kind = SL( "AtLeastOne " );
+					break;
+
+				default :
+					break;
+			}
+
+			return String( SL( "Required argument \"" ) ) + m_arg->name() +
+				SL( "\" is not allowed to be in " ) + kind + SL( "group \"" ) +
+				m_group->name() + SL( "\"." );
+		}
+
+		case ParseError::SchemaMismatch :
+		{
+			if( m_arg )
+				return String( SL( "Argument \"" ) ) + m_arg->name() +
+					SL( "\" doesn't match the schema." );
+			else
+				return String( SL( "Argument \"" ) ) + m_word +
+					SL( "\" from the schema wasn't added." );
+		}
+
+		case ParseError::InvalidValue :
+			return invalidValueDescription( m_word,
+				( m_arg ? m_arg->name() : String() ) );
+
+		case ParseError::AmbiguousArgument :
+			return String( SL( "Ambiguous argument \"" ) ) + m_word +
+				SL( "\", it can be " ) + candidatesList( m_candidates ) +
+				SL( "." );
+
+		case ParseError::StreamReadError :
+			return String( SL( "Values of the argument \"" ) ) + m_arg->name() +
+				SL( "\" can't be read from the stream." );
 
-		if( tmp )
-			return tmp;
+		case ParseError::ArgumentException :
+			return m_word;
 	}
 
-	throw BaseException( String( SL( "Unknown argument \"" ) ) +
-		name + SL( "\"." ) );
+	return String();
 }
 
 } /* namespace Args */
@@ -60,6 +60,7 @@ public:
 		:	GroupIface( name )
 		,	m_opt( opt )
 		,	m_isDefined( false )
+		,	m_storeValues( false )
 	{
 		if( isArgument( name ) || isFlag( name ) )
 			throw BaseException( String( SL( "Command's name can't "
@@ -89,6 +90,12 @@ public:
 	{
 	}
 
+	//! \return Kind of the argument.
+	ArgKind kind() const override
+	{
+		return ArgKind::Command;
+	}
+
 	//! \return Is this command defined?
 	bool isDefined() const override
 	{
@@ -148,15 +155,36 @@ public:
 	const String & value() const
 	{
 		if( !m_values.empty() )
-			return m_values.front();
+			return m_values.values().front();
 		else
 			return m_dummyEmptyString;
 	}
 
-	//! \return All values for this argument.
+	//! \return All values for this argument, see LazyValues about copying.
 	const StringList & values() const
 	{
-		return m_values;
+		return m_values.values();
+	}
+
+	/*!
+		Set handler of the values. Handler is invoked with each value
+		while parsing, values aren't stored in the argument unless
+		\a storeValues is true. Handler should outlive parsing.
+	*/
+	void setValueHandler( ValueHandler handler, bool storeValues = false )
+	{
+		m_valueHandler = handler;
+		m_storeValues = storeValues;
+	}
+
+	/*!
+		Set handler that is invoked when command is found in the
+		command line and its values are taken. Handler should outlive
+		parsing.
+	*/
+	void setDefinedHandler( DefinedHandler handler )
+	{
+		m_definedHandler = handler;
 	}
 
 protected:
@@ -204,7 +232,7 @@ protected:
 		context. This method invokes exactly at that moment when
 		parser has found this argument.
 	*/
-	void process(
+	ParseError tryProcess(
 		//! Context of the command line.
 		Context & ctx ) override
 	{
@@ -214,29 +242,40 @@ protected:
 		{
 			case ValueOptions::ManyValues :
 			{
-				eatValues( ctx, m_values,
-					String( SL( "Command \"" ) ) +
-						name() + SL( "\" require value that wasn't presented." ),
-					cmdLine() );
+				const ParseError error = consumeValues( ctx, cmdLine(),
+					[ this, &ctx ] ( const StringView & value ) -> bool
+					{
+						takeValue( value, ctx.isOwned(), m_valueHandler,
+							m_storeValues, m_values );
+
+						return true;
+					} );
+
+				if( error != ParseError::None )
+					return error;
 			}
 				break;
 
 			case ValueOptions::OneValue :
 			{
-				try {
-					m_values.push_back( eatOneValue( ctx, cmdLine() ) );
-				}
-				catch( const BaseException & )
-				{
-					throw BaseException( String( SL( "Command \"" ) ) +
-						name() + SL( "\" require value that wasn't presented." ) );
-				}
+				StringView value;
+
+				if( !eatOneValue( ctx, cmdLine(), value ) )
+					return ParseError::ValueRequired;
+
+				takeValue( value, ctx.isOwned(), m_valueHandler,
+					m_storeValues, m_values );
 			}
 				break;
 
 			default :
 				break;
 		}
+
+		if( m_definedHandler )
+			m_definedHandler( *this );
+
+		return ParseError::None;
 	}
 
 	/*!
@@ -245,37 +284,45 @@ protected:
 		Implementation of this method must add his flag
 		and name to the flags and names.
 	*/
-	void checkCorrectnessBeforeParsing(
+	ParseStatus tryCheckCorrectnessBeforeParsing(
 		//! All known flags.
-		StringList & flags,
+		NameSet & flags,
 		//! All known names.
-		StringList & names ) const override
+		NameSet & names ) const override
 	{
 		if( isCorrectName( name() ) )
 		{
-			auto it = std::find( names.begin(), names.end(), name() );
-
-			if( it != names.end() )
-				throw BaseException( String( SL( "Redefinition of command "
-					"with name \"" ) ) + name() + SL( "\"." ) );
-			else
-				names.push_back( name() );
+			if( !names.insert( name() ) )
+				return ParseStatus( ParseError::NameRedefinition, this );
 		}
 		else
-			throw BaseException( String( SL( "Dissallowed name \"" ) ) +
-				name() + SL( "\" for the command." ) );
+			return ParseStatus( ParseError::DisallowedName, this );
 
-		StringList ftmp = flags;
-		StringList ntmp = names;
+		NameSet ftmp( &flags );
+		NameSet ntmp( &names );
 
-		GroupIface::checkCorrectnessBeforeParsing( ftmp, ntmp );
+		return GroupIface::tryCheckCorrectnessBeforeParsing( ftmp, ntmp );
 	}
 
 	//! Check correctness of the argument after parsing.
-	void checkCorrectnessAfterParsing() const override
+	ParseStatus tryCheckCorrectnessAfterParsing() const override
 	{
 		if( isDefined() )
-			GroupIface::checkCorrectnessAfterParsing();
+			return GroupIface::tryCheckCorrectnessAfterParsing();
+
+		return ParseStatus();
+	}
+
+	/*!
+		Clear state of the parsing: defined flag and values.
+
+		Children are cleared by the command line.
+	*/
+	void clear() override
+	{
+		m_isDefined = false;
+
+		m_values.clear();
 	}
 
 private:
@@ -292,9 +339,40 @@ private:
 	//! Is defined.
 	bool m_isDefined;
 	//! Values.
-	StringList m_values;
+	LazyValues m_values;
+	//! Handler of the values.
+	ValueHandler m_valueHandler;
+	//! Store values when handler is set?
+	bool m_storeValues;
+	//! Handler of the definition.
+	DefinedHandler m_definedHandler;
 }; // class Command
 
+
+namespace details {
+
+//
+// asCommand
+//
+
+//! \return Command if \a arg is a command, nullptr otherwise.
+inline Command *
+asCommand( ArgIface * arg )
+{
+	return ( arg && arg->kind() == ArgKind::Command ?
+		static_cast< Command* > ( arg ) : nullptr );
+}
+
+//! \return Command if \a arg is a command, nullptr otherwise.
+inline const Command *
+asCommand( const ArgIface * arg )
+{
+	return ( arg && arg->kind() == ArgKind::Command ?
+		static_cast< const Command* > ( arg ) : nullptr );
+}
+
+} /* namespace details */
+
 } /* namespace Args */
 
 #endif // ARGS__COMMAND_HPP__INCLUDED
@@ -33,10 +33,22 @@
 
 // C++ include.
 #include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <list>
+#include <algorithm>
 
 // Args include.
 #include "utils.hpp"
+#include "enums.hpp"
 #include "types.hpp"
+#include "memory_resource.hpp"
+#include "parse_stats.hpp"
+
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	#include "response_file.hpp"
+#endif
 
 
 namespace Args {
@@ -45,10 +57,83 @@ namespace Args {
 // ContextInternal
 //
 
-//! What Context actually is.
+//! Storage for the items owned by the context.
 typedef StringList ContextInternal;
 
 
+//
+// Token
+//
+
+/*!
+	Classified word of the command line. Word is classified once
+	when it's added to the context.
+*/
+class Token final {
+public:
+	Token()
+		:	m_kind( TokenKind::Word )
+		,	m_isOwned( false )
+		,	m_nameEnd( 0 )
+	{
+	}
+
+	Token( TokenKind kind, std::size_t nameEnd )
+		:	m_kind( kind )
+		,	m_isOwned( false )
+		,	m_nameEnd( static_cast< std::uint32_t > ( nameEnd ) )
+	{
+	}
+
+	//! \return Classified token of the word.
+	static Token classify( const StringView & word );
+
+	//! \return Kind.
+	TokenKind kind() const
+	{
+		return m_kind;
+	}
+
+	//! \return Name part of the word, i.e. "--name" of "--name=value".
+	StringView name( const StringView & word ) const
+	{
+		return word.substr( 0, m_nameEnd );
+	}
+
+	//! \return Is there "=" in the word?
+	bool hasValue( const StringView & word ) const
+	{
+		return ( m_nameEnd < word.size() );
+	}
+
+	//! \return Value part of the word, i.e. "value" of "--name=value".
+	StringView value( const StringView & word ) const
+	{
+		return word.substr( m_nameEnd + 1 );
+	}
+
+	//! \return Is word stored in the context?
+	bool isOwned() const
+	{
+		return m_isOwned;
+	}
+
+	//! Set whether word is stored in the context.
+	void setOwned( bool on )
+	{
+		m_isOwned = on;
+	}
+
+private:
+	//! Kind.
+	TokenKind m_kind;
+	//! Is word stored in the context?
+	bool m_isOwned;
+	//! End of the name in the word, position of "=" if any.
+	std::uint32_t m_nameEnd;
+}; // class Token
+
+
 //
 // Context
 //
@@ -56,90 +141,491 @@ typedef StringList ContextInternal;
 /*!
 	Context is a list of words in the command line that user
 	presented with interface for interacting with them.
+
+	Context doesn't copy words, it holds views into the caller's
+	storage (argv, container of strings), so this storage should
+	outlive parsing. Only words that can't be referenced (converted
+	words, prepended strings) are stored in the context.
 */
 class Context final {
 public:
-	explicit Context( ContextInternal items );
+	//! Items of the context.
+	typedef std::vector< StringView,
+		PolymorphicAllocator< StringView > > Items;
+	//! Classified items of the context.
+	typedef std::vector< Token, PolymorphicAllocator< Token > > Tokens;
+
+	explicit Context( MemoryResource * resource = newDeleteResource() );
+
+	explicit Context( ContextInternal items,
+		MemoryResource * resource = newDeleteResource() );
+
+	//! Reference words from the given range.
+	template< typename Iterator >
+	void assign( Iterator first, Iterator last );
 
 	//! \return Iterator to the first item in the context.
-	ContextInternal::iterator begin();
+	Items::iterator begin();
 
 	//! \return Iterator to the last item in the context.
-	ContextInternal::iterator end();
+	Items::iterator end();
 
 	//! \return Is context at end?
 	bool atEnd();
 
 	//! \return Iterator to the next item in the context.
-	ContextInternal::iterator next();
+	Items::iterator next();
 
 	//! Put back last taken item.
 	void putBack();
 
-	//! Prepend context with new item.
+	/*!
+		Prepend context with new item.
+
+		New item replaces the last taken one, so index of the
+		last taken item is the index of the prepended item.
+	*/
+	void prepend( const StringView & what );
+
+	//! Prepend context with new item of the given kind (Word or Value).
+	void prepend( const StringView & what, TokenKind kind );
+
+	//! Prepend context with new item, context stores a copy of the string.
 	void prepend( const String & what );
 
+	//! \return Classified item.
+	const Token & token( Items::const_iterator it ) const;
+
+	//! \return Index of the last taken item.
+	std::size_t index() const;
+
+	/*!
+		\return Is the last taken item stored in the context (converted
+			word, word of the response file, prepended string)?
+
+		Such item is valid only while the context is alive and isn't
+		assigned again, so it should be copied by the one who keeps it.
+	*/
+	bool isOwned() const;
+
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	/*!
+		Replace "@file" words before the end of options with the
+		words of the response file. File is memory mapped, words are
+		views into the mapping if they don't need unquoting (and the
+		string is narrow). Response files can include other ones up
+		to \a maxDepth levels. Word is left as is if file can't be
+		read.
+
+		Should be called before parsing. Available only if
+		ARGS_ENABLE_RESPONSE_FILES is defined.
+	*/
+	void expandResponseFiles( std::size_t maxDepth = 16 );
+#endif
+
 private:
 	DISABLE_COPY( Context )
 
-	//! Internal representation of the context.
-	ContextInternal m_context;
-	//! Iterator to the current item in the context.
-	ContextInternal::iterator m_it;
+	//! List of the owned items.
+	typedef std::list< String, PolymorphicAllocator< String > > Storage;
+
+	//! Add item.
+	void push( const StringView & item, bool isOwned = false );
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	//! Add words of the response file.
+	void expandResponseFile( const StringView & item, bool isOwned,
+		std::size_t depth );
+	//! \return Word of the response file.
+	StringView responseWord( const ResponseToken & token );
+#endif
+	//! Insert item before the current one.
+	void insert( const StringView & what, const Token & token );
+	//! Reference the string.
+	void addItem( const String & item );
+	//! Reference null-terminated string.
+	void addItem( const Char * item );
+	//! \return String in the storage, cleared strings are reused.
+	String & store();
+#ifdef ARGS_QSTRING_BUILD
+	//! Store converted string.
+	void addItem( const char * item );
+	//! Store Qt's string.
+	void addItem( const QString & item );
+#endif
+
+	//! Items.
+	Items m_items;
+	//! Classified items.
+	Tokens m_tokens;
+	//! Storage of the owned items.
+	Storage m_storage;
+	//! Cleared strings of the storage that can be reused.
+	Storage m_spare;
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	//! Mapped response files.
+	std::vector< MappedFile, PolymorphicAllocator< MappedFile > > m_files;
+	//! Items before expansion of the response files.
+	Items m_sourceItems;
+	//! Tokens before expansion of the response files.
+	Tokens m_sourceTokens;
+#endif
+	//! Was end of options met in the added items?
+	bool m_isEndOfOptions;
+	//! Index of the current item.
+	std::size_t m_current;
 }; // class Context
 
 
+//
+// Token
+//
+
+inline Token
+Token::classify( const StringView & word )
+{
+	const std::size_t eq = std::min( word.find( SL( '=' ) ), word.size() );
+
+	if( word.size() >= 2 && word[ 0 ] == SL( '-' ) && word[ 1 ] == SL( '-' ) )
+	{
+		if( word.size() == 2 )
+			return Token( TokenKind::EndOfOptions, 2 );
+		else
+			return Token( TokenKind::Long, eq );
+	}
+	// Single "-" is a word, usually it means standard input.
+	else if( word.size() > 1 && word[ 0 ] == SL( '-' ) )
+		return Token( TokenKind::Short, eq );
+	else
+		return Token( TokenKind::Word, eq );
+}
+
+
 //
 // Context
 //
 
 inline
-Context::Context( ContextInternal items )
-	:	m_context( std::move( items ) )
-	,	m_it( m_context.begin() )
+Context::Context( MemoryResource * resource )
+	:	m_items( Items::allocator_type( resource ) )
+	,	m_tokens( Tokens::allocator_type( resource ) )
+	,	m_storage( Storage::allocator_type( resource ) )
+	,	m_spare( Storage::allocator_type( resource ) )
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	,	m_files( PolymorphicAllocator< MappedFile > ( resource ) )
+	,	m_sourceItems( Items::allocator_type( resource ) )
+	,	m_sourceTokens( Tokens::allocator_type( resource ) )
+#endif
+	,	m_isEndOfOptions( false )
+	,	m_current( 0 )
+{
+}
+
+inline
+Context::Context( ContextInternal items, MemoryResource * resource )
+	:	m_items( Items::allocator_type( resource ) )
+	,	m_tokens( Tokens::allocator_type( resource ) )
+	,	m_storage( Storage::allocator_type( resource ) )
+	,	m_spare( Storage::allocator_type( resource ) )
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	,	m_files( PolymorphicAllocator< MappedFile > ( resource ) )
+	,	m_sourceItems( Items::allocator_type( resource ) )
+	,	m_sourceTokens( Tokens::allocator_type( resource ) )
+#endif
+	,	m_isEndOfOptions( false )
+	,	m_current( 0 )
+{
+	m_items.reserve( items.size() );
+	m_tokens.reserve( items.size() );
+
+	for( auto & item : items )
+	{
+		store() = std::move( item );
+
+		push( StringView( m_storage.back() ), true );
+	}
+}
+
+template< typename Iterator >
+inline void
+Context::assign( Iterator first, Iterator last )
+{
+	m_items.clear();
+	m_tokens.clear();
+	m_spare.splice( m_spare.end(), m_storage );
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+	m_files.clear();
+#endif
+	m_isEndOfOptions = false;
+	m_current = 0;
+
+	for( ; first != last; ++first )
+		addItem( *first );
+}
+
+inline void
+Context::push( const StringView & item, bool isOwned )
+{
+	m_items.push_back( item );
+
+	if( m_isEndOfOptions )
+		m_tokens.push_back( Token( TokenKind::Operand, item.size() ) );
+	else
+	{
+		m_tokens.push_back( Token::classify( item ) );
+
+		m_isEndOfOptions = ( m_tokens.back().kind() == TokenKind::EndOfOptions );
+	}
+
+	m_tokens.back().setOwned( isOwned );
+}
+
+#ifdef ARGS_ENABLE_RESPONSE_FILES
+
+namespace details {
+
+//! \return Is word a reference to the response file?
+inline bool
+isResponseFile( const StringView & word )
+{
+	return ( word.size() > 1 && word[ 0 ] == SL( '@' ) );
+}
+
+} /* namespace details */
+
+inline void
+Context::expandResponseFiles( std::size_t maxDepth )
+{
+	bool hasResponseFiles = false;
+
+	for( std::size_t i = 0; i < m_items.size() && !hasResponseFiles; ++i )
+	{
+		if( m_tokens[ i ].kind() == TokenKind::EndOfOptions )
+			break;
+
+		hasResponseFiles = ( m_tokens[ i ].kind() == TokenKind::Word &&
+			details::isResponseFile( m_items[ i ] ) );
+	}
+
+	if( !hasResponseFiles )
+		return;
+
+	// Buffers are swapped, so they are reused by the next expansions.
+	m_sourceItems.swap( m_items );
+	m_sourceTokens.swap( m_tokens );
+
+	m_items.clear();
+	m_tokens.clear();
+	m_items.reserve( m_sourceItems.size() );
+	m_tokens.reserve( m_sourceItems.size() );
+	m_isEndOfOptions = false;
+	m_current = 0;
+
+	for( std::size_t i = 0; i < m_sourceItems.size(); ++i )
+	{
+		if( !m_isEndOfOptions && m_sourceTokens[ i ].kind() == TokenKind::Word &&
+			details::isResponseFile( m_sourceItems[ i ] ) )
+				expandResponseFile( m_sourceItems[ i ],
+					m_sourceTokens[ i ].isOwned(), maxDepth );
+		else
+			push( m_sourceItems[ i ], m_sourceTokens[ i ].isOwned() );
+	}
+}
+
+inline void
+Context::expandResponseFile( const StringView & item, bool isOwned,
+	std::size_t depth )
+{
+	MappedFile file;
+
+	if( depth == 0 || !file.open( details::toUtf8( item.substr( 1 ) ) ) )
+	{
+		push( item, isOwned );
+
+		return;
+	}
+
+	std::vector< ResponseToken > tokens;
+
+	tokenizeResponseFile( file.data(), file.data() + file.size(), tokens );
+
+	m_files.push_back( std::move( file ) );
+
+	m_items.reserve( m_items.size() + tokens.size() );
+	m_tokens.reserve( m_tokens.size() + tokens.size() );
+
+	for( const auto & token : tokens )
+	{
+		const StringView word = responseWord( token );
+
+		// Words are views into the mapped file or the storage.
+		if( !m_isEndOfOptions && details::isResponseFile( word ) )
+			expandResponseFile( word, true, depth - 1 );
+		else
+			push( word, true );
+	}
+}
+
+inline StringView
+Context::responseWord( const ResponseToken & token )
+{
+#if !defined( ARGS_WSTRING_BUILD ) && !defined( ARGS_QSTRING_BUILD )
+	if( !token.m_isQuoted )
+		return StringView( token.m_begin,
+			static_cast< std::size_t > ( token.m_end - token.m_begin ) );
+#endif
+
+	if( token.m_isQuoted )
+	{
+		const std::string word = unquoteResponseToken( token );
+
+		store() = details::fromUtf8( word.data(), word.size() );
+	}
+	else
+		store() = details::fromUtf8( token.m_begin,
+			static_cast< std::size_t > ( token.m_end - token.m_begin ) );
+
+	ARGS_PARSE_STATS( details::addCopiedBytes( m_storage.back() ); )
+
+	return StringView( m_storage.back() );
+}
+
+#endif // ARGS_ENABLE_RESPONSE_FILES
+
+inline void
+Context::addItem( const String & item )
+{
+	push( StringView( item ) );
+}
+
+inline void
+Context::addItem( const Char * item )
+{
+	push( StringView( item ) );
+}
+
+#ifdef ARGS_QSTRING_BUILD
+inline void
+Context::addItem( const char * item )
+{
+	store() = String( item );
+	ARGS_PARSE_STATS( details::addCopiedBytes( m_storage.back() ); )
+	push( StringView( m_storage.back() ), true );
+}
+
+inline void
+Context::addItem( const QString & item )
 {
+	store() = String( item );
+	ARGS_PARSE_STATS( details::addCopiedBytes( m_storage.back() ); )
+	push( StringView( m_storage.back() ), true );
 }
+#endif
 
-inline ContextInternal::iterator
+inline String &
+Context::store()
+{
+	if( m_spare.empty() )
+		m_storage.emplace_back();
+	else
+		m_storage.splice( m_storage.end(), m_spare, m_spare.begin() );
+
+	return m_storage.back();
+}
+
+inline Context::Items::iterator
 Context::begin()
 {
-	return m_it;
+	return m_items.begin() + m_current;
 }
 
-inline ContextInternal::iterator
+inline Context::Items::iterator
 Context::end()
 {
-	return m_context.end();
+	return m_items.end();
 }
 
 inline bool
 Context::atEnd()
 {
-	return ( begin() == end() );
+	return ( m_current == m_items.size() );
 }
 
-inline ContextInternal::iterator
+inline Context::Items::iterator
 Context::next()
 {
 	if( atEnd() )
 		return end();
 	else
-		return m_it++;
+		return m_items.begin() + m_current++;
 }
 
 inline void
 Context::putBack()
 {
-	if( begin() == m_context.begin() )
-		return;
+	if( m_current > 0 )
+		--m_current;
+}
+
+inline void
+Context::prepend( const StringView & what )
+{
+	insert( what, Token::classify( what ) );
+}
+
+inline void
+Context::prepend( const StringView & what, TokenKind kind )
+{
+	insert( what, Token( kind, what.size() ) );
+}
+
+inline void
+Context::insert( const StringView & what, const Token & token )
+{
+	// Prepended view is a part of the last taken item, i.e. value
+	// of "--name=value", so it's stored where this item is stored.
+	const bool owned = isOwned();
+
+	if( m_current > 0 )
+	{
+		m_items[ --m_current ] = what;
+		m_tokens[ m_current ] = token;
+		m_tokens[ m_current ].setOwned( owned );
+	}
 	else
-		--m_it;
+	{
+		m_items.insert( m_items.begin(), what );
+		m_tokens.insert( m_tokens.begin(), token );
+		m_tokens.front().setOwned( owned );
+	}
 }
 
 inline void
 Context::prepend( const String & what )
 {
-	m_it = m_context.insert( m_it, what );
+	store() = what;
+	ARGS_PARSE_STATS( details::addCopiedBytes( m_storage.back() ); )
+
+	insert( StringView( m_storage.back() ), Token::classify( what ) );
+
+	m_tokens[ m_current ].setOwned( true );
+}
+
+inline const Token &
+Context::token( Items::const_iterator it ) const
+{
+	return m_tokens[ static_cast< std::size_t > ( it - m_items.cbegin() ) ];
+}
+
+inline std::size_t
+Context::index() const
+{
+	return ( m_current > 0 ? m_current - 1 : 0 );
+}
+
+inline bool
+Context::isOwned() const
+{
+	return ( m_current > 0 && m_tokens[ m_current - 1 ].isOwned() );
 }
 
 } /* namespace Args */
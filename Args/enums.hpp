@@ -47,6 +47,101 @@ enum class ValueOptions {
 	ManyValues = 2
 }; // enum ValueOptions
 
+
+//
+// ArgKind
+//
+
+//! Kind of the argument, used for dispatch without RTTI.
+enum class ArgKind : unsigned char {
+	//! Argument: Arg, MultiArg, Help, ArgAsCommand and so on.
+	Argument = 0,
+	//! Command.
+	Command,
+	//! OnlyOneGroup.
+	OnlyOneGroup,
+	//! AllOfGroup.
+	AllOfGroup,
+	//! AtLeastOneGroup.
+	AtLeastOneGroup,
+	//! Group derived from GroupIface by user.
+	Group
+}; // enum class ArgKind
+
+
+//
+// TokenKind
+//
+
+//! Kind of the word in the command line.
+enum class TokenKind : unsigned char {
+	//! Bare word: command, value, ArgAsCommand.
+	Word = 0,
+	//! Argument with name, i.e. "--name" or "--name=value".
+	Long,
+	//! Flag or combo of flags, i.e. "-a", "-abc" or "-a=value".
+	Short,
+	//! End of options "--", words after it are operands.
+	EndOfOptions,
+	//! Value that was taken from "--name=value".
+	Value,
+	//! Word after the end of options, it's a value even if starts with "-".
+	Operand
+}; // enum class TokenKind
+
+
+//
+// ParseError
+//
+
+//! Errors that may occur during parsing.
+enum class ParseError {
+	//! No error.
+	None = 0,
+	//! Help has been printed.
+	HelpHasBeenPrinted,
+	//! Unknown argument in the command line.
+	UnknownArgument,
+	//! Not the last flag in flags combo is with value.
+	ValueInFlagsCombo,
+	//! More than one command in the command line.
+	OnlyOneCommand,
+	//! Argument requires value that wasn't presented.
+	ValueRequired,
+	//! Argument already defined.
+	AlreadyDefined,
+	//! Required argument wasn't defined.
+	UndefinedRequiredArgument,
+	//! Command is required but wasn't specified.
+	CommandNotSpecified,
+	//! More than one argument defined in OnlyOne group.
+	OnlyOneGroupViolation,
+	//! Not all arguments defined in AllOf group.
+	AllOfGroupViolation,
+	//! Redefinition of the flag.
+	FlagRedefinition,
+	//! Redefinition of the name.
+	NameRedefinition,
+	//! Dissallowed flag.
+	DisallowedFlag,
+	//! Dissallowed name.
+	DisallowedName,
+	//! Argument has neither flag nor name.
+	EmptyFlagAndName,
+	//! Required argument in the group.
+	RequiredArgumentInGroup,
+	//! Argument doesn't match the static schema.
+	SchemaMismatch,
+	//! Value of the argument can't be converted to the requested type.
+	InvalidValue,
+	//! Abbreviation matches more than one argument.
+	AmbiguousArgument,
+	//! Values can't be read from the stream.
+	StreamReadError,
+	//! Argument has thrown exception, ParseStatus::word() is its description.
+	ArgumentException
+}; // enum ParseError
+
 } /* namespace Args */
 
 #endif // ARGS__ENUMS_HPP__INCLUDED
@@ -45,6 +45,7 @@
 
 // C++ include.
 #include <list>
+#include <unordered_set>
 #include <type_traits>
 #include <algorithm>
 #include <utility>
@@ -95,14 +96,12 @@ public:
 		!std::is_base_of< Command, T >::value >::type
 	addArg( T & arg )
 	{
-		if( dynamic_cast< Command* > ( &arg ) )
+		if( arg.kind() == ArgKind::Command )
 			throw BaseException( String( SL( "Commands not allowed in groups. "
 				"You are trying to add command \"" ) ) + arg.name() +
 				SL( "\" to group \"" ) + name() + SL( "\"." ) );
 
-		if( std::find( m_children.cbegin(), m_children.cend(), &arg ) ==
-			m_children.cend() )
-				m_children.push_back( &arg );
+		addChild( &arg );
 	}
 
 	//! Add argument.
@@ -111,14 +110,12 @@ public:
 		!std::is_base_of< Command, T >::value >::type
 	addArg( T * arg )
 	{
-		if( dynamic_cast< Command* > ( arg ) )
+		if( arg->kind() == ArgKind::Command )
 			throw BaseException( String( SL( "Commands not allowed in groups. "
 				"You are trying to add command \"" ) ) + arg->name() +
 				SL( "\" to group \"" ) + name() + SL( "\"." ) );
 
-		if( std::find( m_children.cbegin(), m_children.cend(), arg ) ==
-			m_children.cend() )
-				m_children.push_back( arg );
+		addChild( arg );
 	}
 
 	/*!
@@ -127,11 +124,17 @@ public:
 		If name is empty returned value should be a flag.
 		I.e. for example "-t" or "--timeout"
 	*/
-	String name() const override
+	const String & name() const override
 	{
 		return m_name;
 	}
 
+	//! \return Kind of the argument.
+	ArgKind kind() const override
+	{
+		return ArgKind::Group;
+	}
+
 	//! \return Is this argument with value?
 	bool isWithValue() const override
 	{
@@ -144,10 +147,20 @@ public:
 		return m_required;
 	}
 
-	//! Set required flag.
+	/*!
+		Set required flag.
+
+		\throw BaseException if command line parser is sealed.
+	*/
 	virtual void setRequired( bool on = true )
 	{
+		if( isCmdLineSealed( cmdLine() ) )
+			throw BaseException( String( SL( "Group \"" ) ) + name() +
+				SL( "\" can't be changed as command line parser is sealed." ) );
+
 		m_required = on;
+
+		notifyArgumentsChanged( cmdLine() );
 	}
 
 	//! \return Flag.
@@ -212,9 +225,15 @@ protected:
 		context. This method invokes exactly at that moment when
 		parser has found this argument.
 	*/
-	void process(
+	ParseError tryProcess(
 		//! Context of the command line.
 		Context & ) override
+	{
+		return ParseError::None;
+	}
+
+	//! Group has no state of the parsing.
+	void clear() override
 	{
 	}
 
@@ -224,26 +243,39 @@ protected:
 		Implementation of this method must add his flag
 		and name to the flags and names.
 	*/
-	void checkCorrectnessBeforeParsing(
+	ParseStatus tryCheckCorrectnessBeforeParsing(
 		//! All known flags.
-		StringList & flags,
+		NameSet & flags,
 		//! All known names.
-		StringList & names ) const override
+		NameSet & names ) const override
 	{
 		for( const auto & arg : m_children )
-			arg->checkCorrectnessBeforeParsing( flags, names );
+		{
+			ParseStatus status = arg->tryCheckCorrectnessBeforeParsing(
+				flags, names );
+
+			if( !status.isOk() )
+				return status;
+		}
+
+		return ParseStatus();
 	}
 
 	//! Check correctness of the argument after parsing.
-	void checkCorrectnessAfterParsing() const override
+	ParseStatus tryCheckCorrectnessAfterParsing() const override
 	{
 		for( const auto & arg : m_children )
-			arg->checkCorrectnessAfterParsing();
+		{
+			ParseStatus status = arg->tryCheckCorrectnessAfterParsing();
+
+			if( !status.isOk() )
+				return status;
+		}
 
 		if( isRequired() && !isDefined() )
-			throw BaseException(
-				String( SL( "Not defined required argument \"" ) ) +
-				name() + SL( "\"" ) );
+			return ParseStatus( ParseError::UndefinedRequiredArgument, this );
+
+		return ParseStatus();
 	}
 
 	//! Set command line parser.
@@ -256,10 +288,33 @@ protected:
 	}
 
 private:
+	//! Add child.
+	void addChild( ArgIface * arg )
+	{
+		if( isCmdLineSealed( cmdLine() ) )
+			throw BaseException( String( SL( "Argument \"" ) ) + arg->name() +
+				SL( "\" can't be added to group \"" ) + name() +
+				SL( "\" as command line parser is sealed." ) );
+
+		if( m_childrenSet.insert( arg ).second )
+		{
+			m_children.push_back( arg );
+
+			if( cmdLine() )
+			{
+				arg->setCmdLine( cmdLine() );
+
+				notifyArgumentsChanged( cmdLine() );
+			}
+		}
+	}
+
 	DISABLE_COPY( GroupIface )
 
 	//! List of children.
 	Arguments m_children;
+	//! Set of the children for the fast check of duplicates.
+	std::unordered_set< ArgIface* > m_childrenSet;
 	//! Name.
 	String m_name;
 	//! Is required?
@@ -268,6 +323,31 @@ private:
 
 const String GroupIface::m_dummyEmptyString;
 
+
+namespace details {
+
+//
+// asGroup
+//
+
+//! \return Group if \a arg is a group or a command, nullptr otherwise.
+inline GroupIface *
+asGroup( ArgIface * arg )
+{
+	return ( arg && arg->kind() != ArgKind::Argument ?
+		static_cast< GroupIface* > ( arg ) : nullptr );
+}
+
+//! \return Group if \a arg is a group or a command, nullptr otherwise.
+inline const GroupIface *
+asGroup( const ArgIface * arg )
+{
+	return ( arg && arg->kind() != ArgKind::Argument ?
+		static_cast< const GroupIface* > ( arg ) : nullptr );
+}
+
+} /* namespace details */
+
 } /* namespace Args */
 
 #endif // ARGS__GROUP_IFACE_HPP__INCLUDED
@@ -67,6 +67,12 @@ public:
 	{
 	}
 
+	//! \return Kind of the argument.
+	ArgKind kind() const override
+	{
+		return ArgKind::OnlyOneGroup;
+	}
+
 	//! \return Is this argument defined?
 	bool isDefined() const override
 	{
@@ -86,28 +92,35 @@ protected:
 		Implementation of this method must add his flag
 		and name to the flags and names.
 	*/
-	void checkCorrectnessBeforeParsing(
+	ParseStatus tryCheckCorrectnessBeforeParsing(
 		//! All known flags.
-		StringList & flags,
+		NameSet & flags,
 		//! All known names.
-		StringList & names ) const override
+		NameSet & names ) const override
 	{
-		GroupIface::checkCorrectnessBeforeParsing( flags, names );
+		ParseStatus status =
+			GroupIface::tryCheckCorrectnessBeforeParsing( flags, names );
+
+		if( !status.isOk() )
+			return status;
 
 		for( const auto & arg : children() )
 		{
 			if( arg->isRequired() )
-				throw BaseException( String( SL( "Required argument \"" ) ) +
-					arg->name() +
-					SL( "\" is not allowed to be in OnlyOne group \"" ) +
-					name() + SL( "\"." ) );
+				return ParseStatus( ParseError::RequiredArgumentInGroup,
+					arg, nullptr, this );
 		}
+
+		return ParseStatus();
 	}
 
 	//! Check correctness of the argument after parsing.
-	void checkCorrectnessAfterParsing() const override
+	ParseStatus tryCheckCorrectnessAfterParsing() const override
 	{
-		GroupIface::checkCorrectnessAfterParsing();
+		ParseStatus status = GroupIface::tryCheckCorrectnessAfterParsing();
+
+		if( !status.isOk() )
+			return status;
 
 		ArgIface * defined = nullptr;
 
@@ -116,14 +129,14 @@ protected:
 			if( arg->isDefined() )
 			{
 				if( defined )
-					throw BaseException( String( SL( "Only one argument can "
-						"be defined in OnlyOne group \"" ) ) + name() + SL( "\". " ) +
-						SL( "Whereas defined \"" ) + defined->name() +
-						SL( "\" and \"" ) + arg->name() + SL( "\"." ) );
+					return ParseStatus( ParseError::OnlyOneGroupViolation,
+						defined, arg, this );
 				else
 					defined = arg;
 			}
 		}
+
+		return ParseStatus();
 	}
 }; // class OnlyOneGroup
 
@@ -148,6 +161,12 @@ public:
 	{
 	}
 
+	//! \return Kind of the argument.
+	ArgKind kind() const override
+	{
+		return ArgKind::AllOfGroup;
+	}
+
 	//! \return Is this argument defined?
 	bool isDefined() const override
 	{
@@ -167,28 +186,35 @@ protected:
 		Implementation of this method must add his flag
 		and name to the flags and names.
 	*/
-	void checkCorrectnessBeforeParsing(
+	ParseStatus tryCheckCorrectnessBeforeParsing(
 		//! All known flags.
-		StringList & flags,
+		NameSet & flags,
 		//! All known names.
-		StringList & names ) const override
+		NameSet & names ) const override
 	{
-		GroupIface::checkCorrectnessBeforeParsing( flags, names );
+		ParseStatus status =
+			GroupIface::tryCheckCorrectnessBeforeParsing( flags, names );
+
+		if( !status.isOk() )
+			return status;
 
 		for( const auto & arg : children() )
 		{
 			if( arg->isRequired() )
-				throw BaseException( String( SL( "Required argument \"" ) ) +
-					arg->name() +
-					SL( "\" is not allowed to " ) +
-					SL( "be in AllOf group \"" ) + name() + SL( "\"." ) );
+				return ParseStatus( ParseError::RequiredArgumentInGroup,
+					arg, nullptr, this );
 		}
+
+		return ParseStatus();
 	}
 
 	//! Check correctness of the argument after parsing.
-	void checkCorrectnessAfterParsing() const override
+	ParseStatus tryCheckCorrectnessAfterParsing() const override
 	{
-		GroupIface::checkCorrectnessAfterParsing();
+		ParseStatus status = GroupIface::tryCheckCorrectnessAfterParsing();
+
+		if( !status.isOk() )
+			return status;
 
 		bool defined = false;
 
@@ -202,8 +228,9 @@ protected:
 			} );
 
 		if( defined && !all )
-			throw BaseException( String( SL( "All arguments in "
-				"AllOf group \"" ) ) + name() + SL( "\" should be defined." ) );
+			return ParseStatus( ParseError::AllOfGroupViolation, this );
+
+		return ParseStatus();
 	}
 }; // class AllOfGroup
 
@@ -228,6 +255,12 @@ public:
 	{
 	}
 
+	//! \return Kind of the argument.
+	ArgKind kind() const override
+	{
+		return ArgKind::AtLeastOneGroup;
+	}
+
 	//! \return Is this argument defined?
 	bool isDefined() const override
 	{
@@ -247,22 +280,26 @@ protected:
 		Implementation of this method must add his flag
 		and name to the flags and names.
 	*/
-	void checkCorrectnessBeforeParsing(
+	ParseStatus tryCheckCorrectnessBeforeParsing(
 		//! All known flags.
-		StringList & flags,
+		NameSet & flags,
 		//! All known names.
-		StringList & names ) const override
+		NameSet & names ) const override
 	{
-		GroupIface::checkCorrectnessBeforeParsing( flags, names );
+		ParseStatus status =
+			GroupIface::tryCheckCorrectnessBeforeParsing( flags, names );
+
+		if( !status.isOk() )
+			return status;
 
 		for( const auto & arg : children() )
 		{
 			if( arg->isRequired() )
-				throw BaseException( String( SL( "Required argument \"" ) ) +
-					arg->name() +
-					SL( "\" is not allowed to " ) +
-					SL( "be in AtLeastOne group \"" ) + name() + SL( "\"." ) );
+				return ParseStatus( ParseError::RequiredArgumentInGroup,
+					arg, nullptr, this );
 		}
+
+		return ParseStatus();
 	}
 }; // class AtLeastOneGroup
 
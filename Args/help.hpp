@@ -68,7 +68,7 @@ protected:
 		context. This method invokes exactly at that moment when
 		parser has found this argument.
 	*/
-	void process(
+	ParseError tryProcess(
 		//! Context of the command line.
 		Context & context ) override;
 
@@ -83,7 +83,7 @@ protected:
 private:
 	//! Printer.
 	HelpPrinter m_printer;
-	//! Throw or not exception?
+	//! Stop parsing (throw exception) on print?
 	bool m_throwExceptionOnPrint;
 }; // class Help
 
@@ -119,12 +119,12 @@ Help::setLineLength( String::size_type length )
 	m_printer.setLineLength( length );
 }
 
-inline void
-Help::process( Context & context )
+inline ParseError
+Help::tryProcess( Context & context )
 {
 	if( !context.atEnd() )
 	{
-		const String arg = *context.next();
+		const String arg = context.next()->toString();
 
 		// Argument or flag.
 		if( isArgument( arg ) || isFlag( arg ) )
@@ -132,26 +132,23 @@ Help::process( Context & context )
 		// Command?
 		else
 		{
-			try {
-				ArgIface * tmp = cmdLine()->findArgument( arg );
-
-				Command * cmd = dynamic_cast< Command* > ( tmp );
-
-				// Command.
-				if( cmd )
-				{
-					if( !context.atEnd() )
-						m_printer.print( cmd, *context.next(), outStream() );
-					else
-						m_printer.print( arg, outStream() );
-				}
+			ArgIface * tmp = cmdLine()->tryFindArgument( arg );
+
+			Command * cmd = details::asCommand( tmp );
+
+			// Command.
+			if( cmd )
+			{
+				if( !context.atEnd() )
+					m_printer.print( cmd, context.next()->toString(),
+						outStream() );
 				else
 					m_printer.print( arg, outStream() );
 			}
-			catch( const BaseException & )
-			{
+			else if( tmp )
+				m_printer.print( arg, outStream() );
+			else
 				m_printer.print( outStream() );
-			}
 		}
 	}
 	else
@@ -160,7 +157,9 @@ Help::process( Context & context )
 	setDefined( true );
 
 	if( m_throwExceptionOnPrint )
-		throw HelpHasBeenPrintedException();
+		return ParseError::HelpHasBeenPrinted;
+
+	return ParseError::None;
 }
 
 } /* namespace Args */
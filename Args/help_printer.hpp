@@ -195,8 +195,8 @@ HelpPrinter::sortArg( ArgIface * arg,
 	String::size_type & maxCommand,
 	bool requiredAllOfGroup ) const
 {
-	GroupIface * g = dynamic_cast< GroupIface* > ( arg );
-	Command * cmd = dynamic_cast< Command* > ( arg );
+	GroupIface * g = details::asGroup( arg );
+	Command * cmd = details::asCommand( arg );
 
 	if( cmd )
 	{
@@ -210,7 +210,7 @@ HelpPrinter::sortArg( ArgIface * arg,
 	}
 	else if( g )
 	{
-		if( g->isRequired() && dynamic_cast< AllOfGroup* > ( g ) )
+		if( g->isRequired() && g->kind() == ArgKind::AllOfGroup )
 			requiredAllOfGroup = true;
 		else
 			requiredAllOfGroup = false;
@@ -419,10 +419,11 @@ HelpPrinter::print( OutStreamType & to )
 inline void
 HelpPrinter::print( const String & name, OutStreamType & to )
 {
-	try {
-		ArgIface * arg = m_cmdLine->findArgument( name );
+	ArgIface * arg = m_cmdLine->tryFindArgument( name );
 
-		Command * cmd = dynamic_cast < Command* > ( arg );
+	if( arg )
+	{
+		Command * cmd = details::asCommand( arg );
 
 		if( cmd )
 		{
@@ -531,10 +532,8 @@ HelpPrinter::print( const String & name, OutStreamType & to )
 		else
 			print( arg, to );
 	}
-	catch( const BaseException & )
-	{
+	else
 		print( to );
-	}
 }
 
 inline void
@@ -752,20 +751,13 @@ HelpPrinter::print( Command * cmd, const String & name,
 	{
 		ArgIface * arg = cmd->isItYourChild( name );
 
+		if( !arg )
+			arg = m_cmdLine->tryFindArgument( name );
+
 		if( arg )
 			print( arg, to );
 		else
-		{
-			try {
-				arg = m_cmdLine->findArgument( name );
-
-				print( arg, to );
-			}
-			catch( const BaseException & )
-			{
-				print( cmd->name(), to );
-			}
-		}
+			print( cmd->name(), to );
 	}
 	else
 		print( to );
@@ -0,0 +1,475 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ARGS__MEMORY_RESOURCE_HPP__INCLUDED
+#define ARGS__MEMORY_RESOURCE_HPP__INCLUDED
+
+// Args include.
+#include "utils.hpp"
+
+// C++ include.
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <algorithm>
+
+#if defined( __has_include )
+	#if __has_include( <memory_resource> ) && ( __cplusplus >= 201703L || \
+		( defined( _MSVC_LANG ) && _MSVC_LANG >= 201703L ) )
+		#define ARGS_HAS_PMR
+		#include <memory_resource>
+	#endif
+#endif
+
+
+namespace Args {
+
+namespace details {
+
+//
+// resourceTypeId
+//
+
+//! \return Unique identifier of the type, used instead of RTTI.
+template< typename T >
+const void *
+resourceTypeId() noexcept
+{
+	static const char id = 0;
+
+	return &id;
+}
+
+} /* namespace details */
+
+
+//
+// MemoryResource
+//
+
+/*!
+	Source of the memory for the internal containers of the
+	command line parser. It's an analogue of std::pmr::memory_resource
+	available in C++14.
+*/
+class MemoryResource {
+public:
+	virtual ~MemoryResource()
+	{
+	}
+
+	//! \return Allocated memory.
+	void * allocate( std::size_t bytes,
+		std::size_t alignment = alignof( std::max_align_t ) )
+	{
+		return doAllocate( bytes, alignment );
+	}
+
+	//! Deallocate memory.
+	void deallocate( void * p, std::size_t bytes,
+		std::size_t alignment = alignof( std::max_align_t ) )
+	{
+		doDeallocate( p, bytes, alignment );
+	}
+
+	//! \return Can memory allocated by one resource be deallocated by other?
+	bool isEqual( const MemoryResource & other ) const noexcept
+	{
+		return doIsEqual( other );
+	}
+
+	//! \return Identifier of the type of the resource.
+	virtual const void * typeId() const noexcept
+	{
+		return nullptr;
+	}
+
+protected:
+	//! Allocate memory.
+	virtual void * doAllocate( std::size_t bytes, std::size_t alignment ) = 0;
+	//! Deallocate memory.
+	virtual void doDeallocate( void * p, std::size_t bytes,
+		std::size_t alignment ) = 0;
+	//! \return Is resources equal?
+	virtual bool doIsEqual( const MemoryResource & other ) const noexcept
+	{
+		return ( this == &other );
+	}
+}; // class MemoryResource
+
+
+//
+// NewDeleteResource
+//
+
+/*!
+	Memory resource that uses global operator new and operator delete.
+
+	Alignment greater than alignof( std::max_align_t ) is supported
+	with aligned operator new of C++17 only, without it such
+	allocation throws std::bad_alloc.
+*/
+class NewDeleteResource final
+	:	public MemoryResource
+{
+public:
+	//! \return Identifier of the type of the resource.
+	const void * typeId() const noexcept override
+	{
+		return details::resourceTypeId< NewDeleteResource > ();
+	}
+
+protected:
+	void * doAllocate( std::size_t bytes, std::size_t alignment ) override
+	{
+		if( alignment > alignof( std::max_align_t ) )
+		{
+#ifdef __cpp_aligned_new
+			return ::operator new( bytes, std::align_val_t( alignment ) );
+#else
+			throw std::bad_alloc();
+#endif
+		}
+
+		return ::operator new( bytes );
+	}
+
+	void doDeallocate( void * p, std::size_t, std::size_t alignment ) override
+	{
+#ifdef __cpp_aligned_new
+		if( alignment > alignof( std::max_align_t ) )
+			::operator delete( p, std::align_val_t( alignment ) );
+		else
+			::operator delete( p );
+#else
+		UNUSED( alignment )
+
+		::operator delete( p );
+#endif
+	}
+
+	bool doIsEqual( const MemoryResource & other ) const noexcept override
+	{
+		return ( other.typeId() == typeId() );
+	}
+}; // class NewDeleteResource
+
+//! \return Memory resource that uses global operator new and operator delete.
+inline MemoryResource *
+newDeleteResource()
+{
+	static NewDeleteResource resource;
+
+	return &resource;
+}
+
+
+//
+// MonotonicBuffer
+//
+
+/*!
+	Arena that releases memory only when it's destroyed or released.
+
+	Memory is taken from the initial buffer and then from the
+	chunks of the upstream resource with geometric growth.
+	Deallocation is no-op, release() frees everything at once,
+	so it should be called only when all users of the memory
+	(command line parsers) are destroyed.
+*/
+class MonotonicBuffer final
+	:	public MemoryResource
+{
+public:
+	explicit MonotonicBuffer( MemoryResource * upstream = newDeleteResource() )
+		:	MonotonicBuffer( nullptr, 0, upstream )
+	{
+	}
+
+	explicit MonotonicBuffer( std::size_t initialSize,
+		MemoryResource * upstream = newDeleteResource() )
+		:	MonotonicBuffer( nullptr, 0, upstream )
+	{
+		m_nextSize = std::max( initialSize, minChunkSize() );
+		m_initialSize = m_nextSize;
+	}
+
+	//! Use \a buffer first, buffer should outlive the arena.
+	MonotonicBuffer( void * buffer, std::size_t size,
+		MemoryResource * upstream = newDeleteResource() )
+		:	m_upstream( upstream )
+		,	m_buffer( buffer )
+		,	m_bufferSize( size )
+		,	m_current( buffer )
+		,	m_space( size )
+		,	m_chunks( nullptr )
+		,	m_nextSize( std::max( size, minChunkSize() ) )
+		,	m_initialSize( m_nextSize )
+		,	m_used( 0 )
+	{
+	}
+
+	~MonotonicBuffer()
+	{
+		release();
+	}
+
+	//! Release all allocated memory.
+	void release()
+	{
+		while( m_chunks )
+		{
+			Chunk * next = m_chunks->m_next;
+
+			m_upstream->deallocate( m_chunks, m_chunks->m_size,
+				alignof( std::max_align_t ) );
+
+			m_chunks = next;
+		}
+
+		m_current = m_buffer;
+		m_space = m_bufferSize;
+		m_nextSize = m_initialSize;
+		m_used = 0;
+	}
+
+	//! \return Count of bytes given out since creation or the last release().
+	std::size_t used() const
+	{
+		return m_used;
+	}
+
+	//! \return Upstream resource.
+	MemoryResource * upstream() const
+	{
+		return m_upstream;
+	}
+
+protected:
+	void * doAllocate( std::size_t bytes, std::size_t alignment ) override
+	{
+		void * p = ( m_current ?
+			std::align( alignment, bytes, m_current, m_space ) : nullptr );
+
+		if( !p )
+		{
+			const std::size_t size = std::max( m_nextSize,
+				sizeof( Chunk ) + bytes + alignment );
+
+			Chunk * chunk = static_cast< Chunk* > ( m_upstream->allocate(
+				size, alignof( std::max_align_t ) ) );
+
+			chunk->m_next = m_chunks;
+			chunk->m_size = size;
+			m_chunks = chunk;
+
+			m_current = chunk + 1;
+			m_space = size - sizeof( Chunk );
+			m_nextSize = size * 2;
+
+			p = std::align( alignment, bytes, m_current, m_space );
+		}
+
+		m_current = static_cast< char* > ( p ) + bytes;
+		m_space -= bytes;
+		m_used += bytes;
+
+		return p;
+	}
+
+	void doDeallocate( void *, std::size_t, std::size_t ) override
+	{
+	}
+
+private:
+	DISABLE_COPY( MonotonicBuffer )
+
+	//! Header of the chunk from the upstream.
+	struct alignas( std::max_align_t ) Chunk {
+		//! Previous chunk.
+		Chunk * m_next;
+		//! Size of the chunk.
+		std::size_t m_size;
+	}; // struct Chunk
+
+	//! \return Minimal size of the chunk.
+	static std::size_t minChunkSize()
+	{
+		return 1024;
+	}
+
+	//! Upstream.
+	MemoryResource * m_upstream;
+	//! Initial buffer.
+	void * m_buffer;
+	//! Size of the initial buffer.
+	std::size_t m_bufferSize;
+	//! Current position.
+	void * m_current;
+	//! Available space from the current position.
+	std::size_t m_space;
+	//! Chunks from the upstream.
+	Chunk * m_chunks;
+	//! Size of the next chunk.
+	std::size_t m_nextSize;
+	//! Size of the first chunk.
+	std::size_t m_initialSize;
+	//! Count of given out bytes.
+	std::size_t m_used;
+}; // class MonotonicBuffer
+
+
+#ifdef ARGS_HAS_PMR
+
+//
+// PmrResource
+//
+
+//! Adaptor of std::pmr::memory_resource.
+class PmrResource final
+	:	public MemoryResource
+{
+public:
+	explicit PmrResource( std::pmr::memory_resource * resource )
+		:	m_resource( resource )
+	{
+	}
+
+	//! \return Adapted resource.
+	std::pmr::memory_resource * resource() const
+	{
+		return m_resource;
+	}
+
+	//! \return Identifier of the type of the resource.
+	const void * typeId() const noexcept override
+	{
+		return details::resourceTypeId< PmrResource > ();
+	}
+
+protected:
+	void * doAllocate( std::size_t bytes, std::size_t alignment ) override
+	{
+		return m_resource->allocate( bytes, alignment );
+	}
+
+	void doDeallocate( void * p, std::size_t bytes,
+		std::size_t alignment ) override
+	{
+		m_resource->deallocate( p, bytes, alignment );
+	}
+
+	bool doIsEqual( const MemoryResource & other ) const noexcept override
+	{
+		if( other.typeId() != typeId() )
+			return false;
+
+		return m_resource->is_equal(
+			*static_cast< const PmrResource& > ( other ).m_resource );
+	}
+
+private:
+	//! Adapted resource.
+	std::pmr::memory_resource * m_resource;
+}; // class PmrResource
+
+#endif // ARGS_HAS_PMR
+
+
+//
+// PolymorphicAllocator
+//
+
+//! Allocator for standard containers that uses MemoryResource.
+template< typename T >
+class PolymorphicAllocator {
+public:
+	typedef T value_type;
+
+	PolymorphicAllocator() noexcept
+		:	m_resource( newDeleteResource() )
+	{
+	}
+
+	PolymorphicAllocator( MemoryResource * resource ) noexcept
+		:	m_resource( resource ? resource : newDeleteResource() )
+	{
+	}
+
+	template< typename U >
+	PolymorphicAllocator( const PolymorphicAllocator< U > & other ) noexcept
+		:	m_resource( other.resource() )
+	{
+	}
+
+	//! \return Allocated memory for \a n objects.
+	T * allocate( std::size_t n )
+	{
+		return static_cast< T* > ( m_resource->allocate( n * sizeof( T ),
+			alignof( T ) ) );
+	}
+
+	//! Deallocate memory of \a n objects.
+	void deallocate( T * p, std::size_t n )
+	{
+		m_resource->deallocate( p, n * sizeof( T ), alignof( T ) );
+	}
+
+	//! \return Memory resource.
+	MemoryResource * resource() const noexcept
+	{
+		return m_resource;
+	}
+
+private:
+	//! Memory resource.
+	MemoryResource * m_resource;
+}; // class PolymorphicAllocator
+
+template< typename T, typename U >
+inline bool
+operator == ( const PolymorphicAllocator< T > & a,
+	const PolymorphicAllocator< U > & b ) noexcept
+{
+	return ( a.resource() == b.resource() ||
+		a.resource()->isEqual( *b.resource() ) );
+}
+
+template< typename T, typename U >
+inline bool
+operator != ( const PolymorphicAllocator< T > & a,
+	const PolymorphicAllocator< U > & b ) noexcept
+{
+	return !( a == b );
+}
+
+} /* namespace Args */
+
+#endif // ARGS__MEMORY_RESOURCE_HPP__INCLUDED
@@ -36,11 +36,15 @@
 #include "context.hpp"
 #include "exceptions.hpp"
 #include "value_utils.hpp"
+#include "typed_value.hpp"
+#include "stream_source.hpp"
+#include "parse_status.hpp"
 #include "utils.hpp"
 #include "types.hpp"
 
 // C++ include.
 #include <utility>
+#include <vector>
 
 
 namespace Args {
@@ -94,9 +98,39 @@ public:
 	//! \return First value of this argument.
 	virtual const String & value() const;
 
-	//! \return All values for this argument.
+	/*!
+		\return All values for this argument.
+
+		Values are copied from the command line on the first call of
+		value() or values(), see LazyValues about thread safety.
+	*/
 	virtual const StringList & values() const;
 
+	/*!
+		\return All values converted to the type \a T.
+
+		Conversion is done once, converted values are cached till
+		the next change of the values. Cache is filled by this const
+		method, so it isn't thread-safe: concurrent calls on the same
+		argument should be synchronized.
+
+		\throw BaseException if any value can't be converted.
+	*/
+	template< typename T >
+	const std::vector< T > & valuesAs() const;
+
+	/*!
+		Convert all values to the type \a T without exceptions.
+
+		\return Is conversion successful? Details are in the \a status.
+	*/
+	template< typename T >
+	bool valuesAs(
+		//! Converted values.
+		std::vector< T > & values,
+		//! Status of the conversion.
+		ParseStatus & status ) const;
+
 	/*!
 		\return Count of times that this argument was presented
 		in the command line if argument without value or count of values
@@ -104,6 +138,16 @@ public:
 	*/
 	size_t count() const;
 
+	/*!
+		Set source of the values for the value "-" in the command line,
+		i.e. for "--files -". Words of the source are taken as values
+		of this argument while parsing. Source should outlive parsing.
+
+		Without value handler all the words are stored in the argument,
+		set it with setValueHandler() to process them with constant memory.
+	*/
+	void setStream( StreamSource * source );
+
 
 protected:
 	/*!
@@ -111,17 +155,31 @@ protected:
 		context. This method invokes exactly at that moment when
 		parser has found this argument.
 	*/
-	void process(
+	ParseError tryProcess(
 		//! Context of the command line.
 		Context & context ) override;
 
+	//! Clear state of the parsing: defined flag, values and counter.
+	void clear() override;
+
 private:
 	DISABLE_COPY( MultiArg )
 
+	/*!
+		\return Cached converted values.
+
+		\retval nullptr if any value can't be converted,
+			\a status contains details.
+	*/
+	template< typename T >
+	const std::vector< T > * convertValues( ParseStatus & status ) const;
+
 	//! Values of this argument.
-	StringList m_values;
+	LazyValues m_values;
 	//! Counter.
 	size_t m_count;
+	//! Source of the values for "-".
+	StreamSource * m_stream;
 }; // class MultiArg
 
 
@@ -134,6 +192,7 @@ MultiArg::MultiArg( Char flag, T && name,
 	bool isWithValue, bool isRequired )
 	:	Arg( flag, std::forward< T > ( name ), isWithValue, isRequired )
 	,	m_count( 0 )
+	,	m_stream( nullptr )
 {
 }
 
@@ -142,6 +201,7 @@ MultiArg::MultiArg( Char flag,
 	bool isWithValue, bool isRequired )
 	:	Arg( flag, isWithValue, isRequired )
 	,	m_count( 0 )
+	,	m_stream( nullptr )
 {
 }
 
@@ -150,6 +210,7 @@ MultiArg::MultiArg( T && name,
 	bool isWithValue, bool isRequired )
 	:	Arg( std::forward< T > ( name ), isWithValue, isRequired )
 	,	m_count( 0 )
+	,	m_stream( nullptr )
 {
 }
 
@@ -162,7 +223,7 @@ inline const String &
 MultiArg::value() const
 {
 	if( !m_values.empty() )
-		return m_values.front();
+		return m_values.values().front();
 	else
 		return Arg::value();
 }
@@ -170,27 +231,129 @@ MultiArg::value() const
 inline const StringList &
 MultiArg::values() const
 {
-	return m_values;
+	return m_values.values();
+}
+
+template< typename T >
+inline const std::vector< T > *
+MultiArg::convertValues( ParseStatus & status ) const
+{
+	const std::vector< T > * cached = valueCache().get< std::vector< T > > ();
+
+	if( cached )
+		return cached;
+
+	std::vector< T > converted;
+	converted.reserve( values().size() );
+
+	for( const auto & v : values() )
+	{
+		T value;
+
+		if( !ValueConverter< T >::convert( StringView( v ), value ) )
+		{
+			status = ParseStatus( ParseError::InvalidValue, this );
+			status.setWord( v );
+
+			return nullptr;
+		}
+
+		converted.push_back( std::move( value ) );
+	}
+
+	return &valueCache().set( std::move( converted ) );
+}
+
+template< typename T >
+inline const std::vector< T > &
+MultiArg::valuesAs() const
+{
+	ParseStatus status;
+
+	const std::vector< T > * converted = convertValues< T > ( status );
+
+	if( !converted )
+		throw BaseException( invalidValueDescription( status.word(), name() ) );
+
+	return *converted;
+}
+
+template< typename T >
+inline bool
+MultiArg::valuesAs( std::vector< T > & values, ParseStatus & status ) const
+{
+	const std::vector< T > * converted = convertValues< T > ( status );
+
+	if( !converted )
+		return false;
+
+	values = *converted;
+	status = ParseStatus();
+
+	return true;
 }
 
 inline size_t
 MultiArg::count() const
 {
-	if( !isWithValue() )
-		return m_count;
-	else
-		return m_values.size();
+	return m_count;
 }
 
 inline void
-MultiArg::process( Context & context )
+MultiArg::setStream( StreamSource * source )
+{
+	m_stream = source;
+}
+
+inline ParseError
+MultiArg::tryProcess( Context & context )
 {
 	if( isWithValue() )
 	{
-		setDefined( eatValues( context, m_values,
-			String( SL( "Argument \"" ) ) +
-				name() + SL( "\" require value that wasn't presented." ),
-			cmdLine() ) );
+		valueCache().clear();
+
+		const auto take = [ this ] ( const StringView & value, bool isTransient )
+		{
+			if( handleValue( value ) )
+			{
+				if( isTransient )
+					m_values.pushCopy( value );
+				else
+					m_values.push( value );
+			}
+
+			++m_count;
+		};
+
+		bool hasStreamError = false;
+
+		const ParseError error = consumeValues( context, cmdLine(),
+			[ this, &take, &hasStreamError, &context ] (
+				const StringView & value ) -> bool
+			{
+				if( m_stream && value.size() == 1 && value[ 0 ] == SL( '-' ) )
+				{
+					StringView word;
+
+					while( m_stream->next( word ) )
+						take( word, true );
+
+					hasStreamError = hasStreamError || m_stream->hasError();
+				}
+				else
+					take( value, context.isOwned() );
+
+				return true;
+			} );
+
+		if( error != ParseError::None )
+			return error;
+
+		// Values read before the error are kept, but parsing fails.
+		if( hasStreamError )
+			return ParseError::StreamReadError;
+
+		setDefined( true );
 	}
 	else
 	{
@@ -198,6 +361,196 @@ MultiArg::process( Context & context )
 
 		++m_count;
 	}
+
+	handleDefined();
+
+	return ParseError::None;
+}
+
+inline void
+MultiArg::clear()
+{
+	Arg::clear();
+
+	m_values.clear();
+	m_count = 0;
+}
+
+
+//
+// TypedMultiArg
+//
+
+/*!
+	TypedMultiArg is an argument that can be presented more than
+	once or can have more than one value, values are converted to
+	the type \a T as they are taken from the command line and are
+	stored contiguously, strings of the values are not kept.
+
+	Type \a T should be supported by ValueConverter. Argument is
+	always with value.
+*/
+template< typename T >
+class TypedMultiArg
+	:	public Arg
+{
+public:
+	//! Type of the values.
+	typedef T ValueType;
+
+	//! Construct argument with flag and name.
+	template< typename Name >
+	TypedMultiArg(
+		//! Flag for this argument.
+		Char flag,
+		//! Name for this argument.
+		Name && name,
+		//! Is this argument required?
+		bool isRequired = false );
+
+	//! Construct argument only with flag, without name.
+	explicit TypedMultiArg(
+		//! Flag for this argument.
+		Char flag,
+		//! Is this argument required?
+		bool isRequired = false );
+
+	//! Construct argument only with name, without flag.
+	template< typename Name >
+	explicit TypedMultiArg(
+		//! Name for this argument.
+		Name && name,
+		//! Is this argument required?
+		bool isRequired = false );
+
+	virtual ~TypedMultiArg();
+
+	//! \return All values for this argument.
+	Span< const T > values() const;
+
+	/*!
+		\return Count of values, including values passed only to
+		the value handler.
+	*/
+	size_t count() const;
+
+	//! Reserve place for the given count of values.
+	void reserve( size_t count );
+
+protected:
+	/*!
+		Process argument's staff, for example take values from
+		context. This method invokes exactly at that moment when
+		parser has found this argument.
+	*/
+	ParseError tryProcess(
+		//! Context of the command line.
+		Context & context ) override;
+
+	//! Clear state of the parsing: defined flag and values.
+	void clear() override;
+
+private:
+	DISABLE_COPY( TypedMultiArg )
+
+	//! Values of this argument.
+	std::vector< T > m_values;
+	//! Counter.
+	size_t m_count;
+}; // class TypedMultiArg
+
+
+//
+// TypedMultiArg
+//
+
+template< typename T >
+template< typename Name >
+TypedMultiArg< T >::TypedMultiArg( Char flag, Name && name, bool isRequired )
+	:	Arg( flag, std::forward< Name > ( name ), true, isRequired )
+	,	m_count( 0 )
+{
+}
+
+template< typename T >
+TypedMultiArg< T >::TypedMultiArg( Char flag, bool isRequired )
+	:	Arg( flag, true, isRequired )
+	,	m_count( 0 )
+{
+}
+
+template< typename T >
+template< typename Name >
+TypedMultiArg< T >::TypedMultiArg( Name && name, bool isRequired )
+	:	Arg( std::forward< Name > ( name ), true, isRequired )
+	,	m_count( 0 )
+{
+}
+
+template< typename T >
+TypedMultiArg< T >::~TypedMultiArg()
+{
+}
+
+template< typename T >
+Span< const T >
+TypedMultiArg< T >::values() const
+{
+	return Span< const T > ( m_values.data(), m_values.size() );
+}
+
+template< typename T >
+size_t
+TypedMultiArg< T >::count() const
+{
+	return m_count;
+}
+
+template< typename T >
+void
+TypedMultiArg< T >::reserve( size_t count )
+{
+	m_values.reserve( count );
+}
+
+template< typename T >
+ParseError
+TypedMultiArg< T >::tryProcess( Context & context )
+{
+	const ParseError error = consumeValues( context, cmdLine(),
+		[ this ] ( const StringView & value ) -> bool
+		{
+			T converted;
+
+			if( !ValueConverter< T >::convert( value, converted ) )
+				return false;
+
+			if( handleValue( value ) )
+				m_values.push_back( std::move( converted ) );
+
+			++m_count;
+
+			return true;
+		} );
+
+	if( error == ParseError::None )
+	{
+		setDefined( true );
+
+		handleDefined();
+	}
+
+	return error;
+}
+
+template< typename T >
+void
+TypedMultiArg< T >::clear()
+{
+	Arg::clear();
+
+	m_values.clear();
+	m_count = 0;
 }
 
 } /* namespace Args */
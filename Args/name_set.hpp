@@ -0,0 +1,138 @@
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ARGS__NAME_SET_HPP__INCLUDED
+#define ARGS__NAME_SET_HPP__INCLUDED
+
+// Args include.
+#include "utils.hpp"
+#include "memory_resource.hpp"
+#include "types.hpp"
+
+// C++ include.
+#include <unordered_set>
+#include <functional>
+
+
+namespace Args {
+
+//
+// NameSet
+//
+
+/*!
+	Hashed set of flags or names for the detection of redefinitions.
+	Set can have parent scope, names of the parent are visible in the
+	set, but names of the set are not added to the parent.
+
+	Memory is taken from the given resource, child set uses the
+	resource of the parent.
+*/
+class NameSet final {
+public:
+	explicit NameSet( MemoryResource * resource = newDeleteResource() )
+		:	m_parent( nullptr )
+		,	m_names( 0, StringHash(), std::equal_to< String > (),
+				Names::allocator_type( resource ) )
+	{
+	}
+
+	explicit NameSet( const NameSet * parent )
+		:	m_parent( parent )
+		,	m_names( 0, StringHash(), std::equal_to< String > (),
+				Names::allocator_type( parent ? parent->resource() :
+					newDeleteResource() ) )
+	{
+	}
+
+	//! \return Is there such name in the set or in the parent?
+	bool contains( const String & name ) const
+	{
+		for( const NameSet * set = this; set; set = set->m_parent )
+		{
+			if( set->m_names.find( name ) != set->m_names.cend() )
+				return true;
+		}
+
+		return false;
+	}
+
+	/*!
+		Add name.
+
+		\return false if name is already in the set or in the parent.
+	*/
+	bool insert( const String & name )
+	{
+		if( m_parent && m_parent->contains( name ) )
+			return false;
+
+		return m_names.insert( name ).second;
+	}
+
+	//! \return Names of the set and of the parent.
+	StringList toList() const
+	{
+		StringList list;
+
+		for( const NameSet * set = this; set; set = set->m_parent )
+			list.insert( list.cend(), set->m_names.cbegin(),
+				set->m_names.cend() );
+
+		return list;
+	}
+
+	//! Reserve place for the given count of names.
+	void reserve( std::size_t count )
+	{
+		m_names.reserve( count );
+	}
+
+	//! \return Memory resource.
+	MemoryResource * resource() const
+	{
+		return m_names.get_allocator().resource();
+	}
+
+private:
+	DISABLE_COPY( NameSet )
+
+	//! Set of the names.
+	typedef std::unordered_set< String, StringHash, std::equal_to< String >,
+		PolymorphicAllocator< String > > Names;
+
+	//! Parent.
+	const NameSet * m_parent;
+	//! Names.
+	Names m_names;
+}; // class NameSet
+
+} /* namespace Args */
+
+#endif // ARGS__NAME_SET_HPP__INCLUDED
@@ -0,0 +1,191 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ARGS__PARSE_STATS_HPP__INCLUDED
+#define ARGS__PARSE_STATS_HPP__INCLUDED
+
+/*!
+	Statistics of the parsing are collected only if ARGS_ENABLE_PARSE_STATS
+	is defined, otherwise ARGS_PARSE_STATS( ... ) expands to nothing.
+*/
+#ifdef ARGS_ENABLE_PARSE_STATS
+	#define ARGS_PARSE_STATS( ... ) __VA_ARGS__
+#else
+	#define ARGS_PARSE_STATS( ... )
+#endif
+
+#ifdef ARGS_ENABLE_PARSE_STATS
+
+// Args include.
+#include "utils.hpp"
+
+// C++ include.
+#include <chrono>
+#include <cstddef>
+
+
+namespace Args {
+
+//
+// ParseStats
+//
+
+/*!
+	Statistics of the parsing, they are accumulated by CmdLine till
+	CmdLine::resetParseStats().
+*/
+struct ParseStats final {
+	ParseStats()
+		:	m_beforeParsingTime( 0 )
+		,	m_tokenLoopTime( 0 )
+		,	m_valuesTime( 0 )
+		,	m_afterParsingTime( 0 )
+		,	m_findArgumentProbes( 0 )
+		,	m_tokens( 0 )
+		,	m_bytesCopied( 0 )
+	{
+	}
+
+	//! Time of the checkCorrectnessBeforeParsing() and building of index.
+	std::chrono::nanoseconds m_beforeParsingTime;
+	//! Time of the loop over tokens, including values.
+	std::chrono::nanoseconds m_tokenLoopTime;
+	//! Time of the processing of arguments: values eating.
+	std::chrono::nanoseconds m_valuesTime;
+	//! Time of the checkCorrectnessAfterParsing().
+	std::chrono::nanoseconds m_afterParsingTime;
+	//! Count of lookups of the arguments by name.
+	std::size_t m_findArgumentProbes;
+	//! Count of processed tokens: arguments and values.
+	std::size_t m_tokens;
+	//! Count of bytes copied while parsing.
+	std::size_t m_bytesCopied;
+}; // struct ParseStats
+
+
+namespace details {
+
+//! \return Statistics of the current parsing in this thread.
+inline ParseStats *& currentParseStats()
+{
+	static thread_local ParseStats * stats = nullptr;
+
+	return stats;
+}
+
+//! Add \a value to the counter of the current parsing.
+inline void addParseStat( std::size_t ParseStats::* counter,
+	std::size_t value = 1 )
+{
+	ParseStats * stats = currentParseStats();
+
+	if( stats )
+		stats->*counter += value;
+}
+
+//! Add size of the copied string to the statistics of the current parsing.
+inline void addCopiedBytes( const StringView & copied )
+{
+	addParseStat( &ParseStats::m_bytesCopied, copied.size() * sizeof( Char ) );
+}
+
+
+//
+// ParseStatsScope
+//
+
+//! Makes statistics current for this thread while alive.
+class ParseStatsScope final {
+public:
+	explicit ParseStatsScope( ParseStats & stats )
+		:	m_previous( currentParseStats() )
+	{
+		currentParseStats() = &stats;
+	}
+
+	~ParseStatsScope()
+	{
+		currentParseStats() = m_previous;
+	}
+
+private:
+	DISABLE_COPY( ParseStatsScope )
+
+	//! Previous statistics.
+	ParseStats * m_previous;
+}; // class ParseStatsScope
+
+
+//
+// ParseTimer
+//
+
+//! Adds time of its life to the timer of the current parsing.
+class ParseTimer final {
+public:
+	explicit ParseTimer( std::chrono::nanoseconds ParseStats::* timer )
+		:	m_timer( timer )
+		,	m_start( std::chrono::steady_clock::now() )
+	{
+	}
+
+	~ParseTimer()
+	{
+		stop();
+	}
+
+	//! Add time since the start, later calls do nothing.
+	void stop()
+	{
+		ParseStats * stats = currentParseStats();
+
+		if( stats && m_timer )
+			stats->*m_timer += std::chrono::duration_cast< std::chrono::nanoseconds > (
+				std::chrono::steady_clock::now() - m_start );
+
+		m_timer = nullptr;
+	}
+
+private:
+	DISABLE_COPY( ParseTimer )
+
+	//! Timer.
+	std::chrono::nanoseconds ParseStats::* m_timer;
+	//! Start time.
+	std::chrono::steady_clock::time_point m_start;
+}; // class ParseTimer
+
+} /* namespace details */
+
+} /* namespace Args */
+
+#endif // ARGS_ENABLE_PARSE_STATS
+
+#endif // ARGS__PARSE_STATS_HPP__INCLUDED
@@ -0,0 +1,222 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ARGS__PARSE_STATUS_HPP__INCLUDED
+#define ARGS__PARSE_STATUS_HPP__INCLUDED
+
+// Args include.
+#include "enums.hpp"
+#include "types.hpp"
+
+// C++ include.
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace Args {
+
+class ArgIface;
+
+
+//
+// ParseStatus
+//
+
+/*!
+	Result of the parsing of the command line. Allows to get
+	information about error without exceptions.
+*/
+class ParseStatus final {
+public:
+	//! Value of the token when error isn't related to the command line.
+	static const std::size_t npos = static_cast< std::size_t > ( -1 );
+
+	//! Construct successful status.
+	ParseStatus()
+		:	m_error( ParseError::None )
+		,	m_token( npos )
+		,	m_arg( nullptr )
+		,	m_other( nullptr )
+		,	m_group( nullptr )
+	{
+	}
+
+	//! Construct status with error related to the arguments.
+	explicit ParseStatus(
+		//! Error.
+		ParseError error,
+		//! Argument.
+		const ArgIface * arg = nullptr,
+		//! Another argument if error is about two arguments.
+		const ArgIface * other = nullptr,
+		//! Group if error is about group.
+		const ArgIface * group = nullptr )
+		:	m_error( error )
+		,	m_token( npos )
+		,	m_arg( arg )
+		,	m_other( other )
+		,	m_group( group )
+	{
+	}
+
+	//! Construct status with error related to the word in the command line.
+	ParseStatus(
+		//! Error.
+		ParseError error,
+		//! Index of the word in the command line.
+		std::size_t token,
+		//! Word.
+		String word )
+		:	m_error( error )
+		,	m_token( token )
+		,	m_word( std::move( word ) )
+		,	m_arg( nullptr )
+		,	m_other( nullptr )
+		,	m_group( nullptr )
+	{
+	}
+
+	//! \return Is parsing successful?
+	bool isOk() const
+	{
+		return ( m_error == ParseError::None );
+	}
+
+	//! \return Has help been printed?
+	bool isHelpPrinted() const
+	{
+		return ( m_error == ParseError::HelpHasBeenPrinted );
+	}
+
+	//! \return Error.
+	ParseError error() const
+	{
+		return m_error;
+	}
+
+	/*!
+		\return Index of the word in the command line where error occured.
+
+		Index doesn't count executable's name, i.e. argv[ 1 ] has index 0.
+		With CmdLine::ExpandResponseFiles it's an index in the words
+		after expansion, where words of the response file replace
+		the "@file" word, so it can differ from the index in argv.
+
+		\retval npos if error is not related to the concrete word.
+	*/
+	std::size_t token() const
+	{
+		return m_token;
+	}
+
+	//! Set index of the word in the command line.
+	void setToken( std::size_t token )
+	{
+		m_token = token;
+	}
+
+	/*!
+		\return Word from the command line that caused error.
+
+		For ParseError::ArgumentException it's the description of
+		the exception thrown by the argument.
+	*/
+	const String & word() const
+	{
+		return m_word;
+	}
+
+	//! Set word that caused error.
+	void setWord( const String & word )
+	{
+		m_word = word;
+	}
+
+	/*!
+		\return Names of the arguments that can be meant by the word,
+		i.e. for ambiguous abbreviation.
+	*/
+	const std::vector< String > & candidates() const
+	{
+		return m_candidates;
+	}
+
+	//! Set names of the arguments that can be meant by the word.
+	void setCandidates( std::vector< String > candidates )
+	{
+		m_candidates = std::move( candidates );
+	}
+
+	//! \return Argument that caused error.
+	const ArgIface * argument() const
+	{
+		return m_arg;
+	}
+
+	//! \return Another argument that caused error.
+	const ArgIface * otherArgument() const
+	{
+		return m_other;
+	}
+
+	//! \return Group that caused error.
+	const ArgIface * group() const
+	{
+		return m_group;
+	}
+
+	/*!
+		\return Human readable description of the error.
+
+		Description is built only on demand.
+	*/
+	String description() const;
+
+private:
+	//! Error.
+	ParseError m_error;
+	//! Index of the word in the command line.
+	std::size_t m_token;
+	//! Word.
+	String m_word;
+	//! Candidates for the word.
+	std::vector< String > m_candidates;
+	//! Argument.
+	const ArgIface * m_arg;
+	//! Another argument.
+	const ArgIface * m_other;
+	//! Group.
+	const ArgIface * m_group;
+}; // class ParseStatus
+
+} /* namespace Args */
+
+#endif // ARGS__PARSE_STATUS_HPP__INCLUDED
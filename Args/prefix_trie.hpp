@@ -0,0 +1,325 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef ARGS__PREFIX_TRIE_HPP__INCLUDED
+#define ARGS__PREFIX_TRIE_HPP__INCLUDED
+
+// Args include.
+#include "memory_resource.hpp"
+#include "types.hpp"
+
+// C++ include.
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+
+namespace Args {
+
+class ArgIface;
+
+
+//
+// PrefixTrie
+//
+
+/*!
+	Compressed trie of the names of the arguments for the lookup by
+	unambiguous prefix, i.e. "--verb" for "--verbose".
+
+	Every node knows whether all names below it belong to one argument,
+	so lookup is done in one walk over the prefix.
+
+	Nodes and the table of the names are allocated from the given
+	resource, characters of the long names are allocated by String.
+*/
+class PrefixTrie final {
+public:
+	explicit PrefixTrie( MemoryResource * resource = newDeleteResource() )
+		:	m_keys( Keys::allocator_type( resource ) )
+		,	m_nodes( Nodes::allocator_type( resource ) )
+	{
+		clear();
+	}
+
+	//! Remove all names.
+	void clear()
+	{
+		m_keys.clear();
+		m_nodes.clear();
+		m_nodes.push_back( Node( resource() ) );
+	}
+
+	//! \return Is there no names in the trie?
+	bool empty() const
+	{
+		return m_keys.empty();
+	}
+
+	/*!
+		Add name of the argument. If name is already in the trie
+		first added argument wins.
+	*/
+	void insert( const String & key, ArgIface * arg )
+	{
+		m_keys.push_back( key );
+
+		const std::size_t k = m_keys.size() - 1;
+		const StringView view( m_keys.back() );
+
+		std::size_t node = 0;
+		StringView::size_type pos = 0;
+
+		while( true )
+		{
+			addArg( m_nodes[ node ], arg );
+
+			if( pos == view.size() )
+			{
+				if( !m_nodes[ node ].m_arg )
+					m_nodes[ node ].m_arg = arg;
+
+				return;
+			}
+
+			const std::size_t child = findChild( node, view[ pos ] );
+
+			if( child == npos )
+			{
+				Node leaf( resource() );
+				leaf.m_key = k;
+				leaf.m_begin = pos;
+				leaf.m_length = view.size() - pos;
+				leaf.m_arg = arg;
+				leaf.m_unique = arg;
+
+				m_nodes.push_back( leaf );
+				m_nodes[ node ].m_children.push_back( m_nodes.size() - 1 );
+
+				return;
+			}
+
+			const StringView label = labelOf( child );
+			const StringView rest = view.substr( pos );
+
+			StringView::size_type common = 0;
+
+			while( common < label.size() && common < rest.size() &&
+				label[ common ] == rest[ common ] )
+					++common;
+
+			std::size_t next = child;
+
+			// Split the edge.
+			if( common < label.size() )
+			{
+				Node middle( resource() );
+				middle.m_key = m_nodes[ child ].m_key;
+				middle.m_begin = m_nodes[ child ].m_begin;
+				middle.m_length = common;
+				middle.m_unique = m_nodes[ child ].m_unique;
+				middle.m_isAmbiguous = m_nodes[ child ].m_isAmbiguous;
+				middle.m_children.push_back( child );
+
+				m_nodes[ child ].m_begin += common;
+				m_nodes[ child ].m_length -= common;
+
+				m_nodes.push_back( middle );
+				next = m_nodes.size() - 1;
+
+				std::replace( m_nodes[ node ].m_children.begin(),
+					m_nodes[ node ].m_children.end(), child, next );
+			}
+
+			pos += common;
+			node = next;
+		}
+	}
+
+	/*!
+		\return Argument which names start with the given prefix.
+
+		\retval nullptr if there is no such names or they belong
+			to different arguments, in the last case \a ambiguous
+			is set to true.
+	*/
+	ArgIface * find( const StringView & prefix, bool & ambiguous ) const
+	{
+		ambiguous = false;
+
+		const std::size_t node = findNode( prefix );
+
+		if( node == npos )
+			return nullptr;
+
+		if( m_nodes[ node ].m_isAmbiguous )
+		{
+			ambiguous = true;
+
+			return nullptr;
+		}
+
+		return m_nodes[ node ].m_unique;
+	}
+
+	//! Append names that start with the given prefix.
+	void collect( const StringView & prefix, std::vector< String > & to ) const
+	{
+		const std::size_t node = findNode( prefix );
+
+		if( node != npos )
+			collect( node, to );
+	}
+
+private:
+	//! Invalid index of the node.
+	static const std::size_t npos = static_cast< std::size_t > ( -1 );
+
+	//! Indexes of the children.
+	typedef std::vector< std::size_t, PolymorphicAllocator< std::size_t > >
+		Children;
+
+	//! Node of the trie.
+	struct Node {
+		explicit Node( MemoryResource * resource )
+			:	m_key( 0 )
+			,	m_begin( 0 )
+			,	m_length( 0 )
+			,	m_arg( nullptr )
+			,	m_unique( nullptr )
+			,	m_isAmbiguous( false )
+			,	m_children( Children::allocator_type( resource ) )
+		{
+		}
+
+		//! Index of the name that contains label of the edge.
+		std::size_t m_key;
+		//! Position of the label in the name.
+		StringView::size_type m_begin;
+		//! Length of the label.
+		StringView::size_type m_length;
+		//! Argument which name ends in this node.
+		ArgIface * m_arg;
+		//! Argument of all names below this node.
+		ArgIface * m_unique;
+		//! Do names below this node belong to different arguments?
+		bool m_isAmbiguous;
+		//! Children.
+		Children m_children;
+	}; // struct Node
+
+	//! Names.
+	typedef std::vector< String, PolymorphicAllocator< String > > Keys;
+	//! Nodes.
+	typedef std::vector< Node, PolymorphicAllocator< Node > > Nodes;
+
+	//! \return Memory resource.
+	MemoryResource * resource() const
+	{
+		return m_nodes.get_allocator().resource();
+	}
+
+	//! Add argument to the names below the node.
+	static void addArg( Node & node, ArgIface * arg )
+	{
+		if( !node.m_unique )
+			node.m_unique = arg;
+		else if( node.m_unique != arg )
+			node.m_isAmbiguous = true;
+	}
+
+	//! \return Label of the edge to the node.
+	StringView labelOf( std::size_t node ) const
+	{
+		const Node & n = m_nodes[ node ];
+
+		return StringView( m_keys[ n.m_key ] ).substr( n.m_begin, n.m_length );
+	}
+
+	//! \return Child which label starts with the given character.
+	std::size_t findChild( std::size_t node, Char c ) const
+	{
+		for( const auto & child : m_nodes[ node ].m_children )
+		{
+			if( labelOf( child )[ 0 ] == c )
+				return child;
+		}
+
+		return npos;
+	}
+
+	//! \return Node at the end of the prefix.
+	std::size_t findNode( const StringView & prefix ) const
+	{
+		std::size_t node = 0;
+		StringView::size_type pos = 0;
+
+		while( pos < prefix.size() )
+		{
+			node = findChild( node, prefix[ pos ] );
+
+			if( node == npos )
+				return npos;
+
+			const StringView label = labelOf( node );
+			const StringView::size_type length =
+				std::min( label.size(), prefix.size() - pos );
+
+			if( label.substr( 0, length ) != prefix.substr( pos, length ) )
+				return npos;
+
+			pos += length;
+		}
+
+		return node;
+	}
+
+	//! Append names below the node.
+	void collect( std::size_t node, std::vector< String > & to ) const
+	{
+		const Node & n = m_nodes[ node ];
+
+		if( n.m_arg )
+			to.push_back( StringView( m_keys[ n.m_key ] ).substr( 0,
+				n.m_begin + n.m_length ).toString() );
+
+		for( const auto & child : n.m_children )
+			collect( child, to );
+	}
+
+private:
+	//! Names.
+	Keys m_keys;
+	//! Nodes, the first one is the root.
+	Nodes m_nodes;
+}; // class PrefixTrie
+
+} /* namespace Args */
+
+#endif // ARGS__PREFIX_TRIE_HPP__INCLUDED
@@ -0,0 +1,556 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ARGS__RESPONSE_FILE_HPP__INCLUDED
+#define ARGS__RESPONSE_FILE_HPP__INCLUDED
+
+// Args include.
+#include "utils.hpp"
+#include "types.hpp"
+
+// C++ include.
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#ifdef _WIN32
+	// Macros are defined only for <windows.h>, user's ones are kept.
+	#ifndef NOMINMAX
+		#define NOMINMAX
+		#define ARGS_UNDEF_NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+		#define ARGS_UNDEF_WIN32_LEAN_AND_MEAN
+	#endif
+
+	#include <windows.h>
+
+	#ifdef ARGS_UNDEF_NOMINMAX
+		#undef NOMINMAX
+		#undef ARGS_UNDEF_NOMINMAX
+	#endif
+	#ifdef ARGS_UNDEF_WIN32_LEAN_AND_MEAN
+		#undef WIN32_LEAN_AND_MEAN
+		#undef ARGS_UNDEF_WIN32_LEAN_AND_MEAN
+	#endif
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+namespace Args {
+
+//
+// MappedFile
+//
+
+//! Read-only memory mapping of the file.
+class MappedFile final {
+public:
+	MappedFile()
+		:	m_data( nullptr )
+		,	m_size( 0 )
+	{
+	}
+
+	~MappedFile()
+	{
+		close();
+	}
+
+	MappedFile( MappedFile && other ) noexcept
+		:	m_data( other.m_data )
+		,	m_size( other.m_size )
+	{
+		other.m_data = nullptr;
+		other.m_size = 0;
+	}
+
+	MappedFile & operator = ( MappedFile && other ) noexcept
+	{
+		if( this != &other )
+		{
+			close();
+
+			std::swap( m_data, other.m_data );
+			std::swap( m_size, other.m_size );
+		}
+
+		return *this;
+	}
+
+	/*!
+		Map file with the given path in UTF-8.
+
+		\return Is file mapped?
+	*/
+	bool open( const std::string & path );
+
+	//! Unmap file.
+	void close();
+
+	//! \return Data of the file, it's not null for the opened empty file.
+	const char * data() const
+	{
+		return m_data;
+	}
+
+	//! \return Size of the file.
+	std::size_t size() const
+	{
+		return m_size;
+	}
+
+private:
+	MappedFile( const MappedFile & ) = delete;
+	MappedFile & operator = ( const MappedFile & ) = delete;
+
+	//! Data.
+	const char * m_data;
+	//! Size.
+	std::size_t m_size;
+}; // class MappedFile
+
+#ifdef _WIN32
+
+inline bool
+MappedFile::open( const std::string & path )
+{
+	close();
+
+	const int length = MultiByteToWideChar( CP_UTF8, 0, path.c_str(), -1,
+		nullptr, 0 );
+
+	if( length <= 0 )
+		return false;
+
+	std::wstring widePath( static_cast< std::size_t > ( length ), L'\0' );
+
+	MultiByteToWideChar( CP_UTF8, 0, path.c_str(), -1, &widePath[ 0 ], length );
+
+	HANDLE file = CreateFileW( widePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+	if( file == INVALID_HANDLE_VALUE )
+		return false;
+
+	LARGE_INTEGER size;
+
+	if( !GetFileSizeEx( file, &size ) )
+	{
+		CloseHandle( file );
+
+		return false;
+	}
+
+	// Empty file can't be mapped, its data is an empty string.
+	if( size.QuadPart == 0 )
+	{
+		CloseHandle( file );
+
+		m_data = "";
+
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0,
+		nullptr );
+
+	CloseHandle( file );
+
+	if( !mapping )
+		return false;
+
+	void * data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+
+	CloseHandle( mapping );
+
+	if( !data )
+		return false;
+
+	m_data = static_cast< const char* > ( data );
+	m_size = static_cast< std::size_t > ( size.QuadPart );
+
+	return true;
+}
+
+inline void
+MappedFile::close()
+{
+	if( m_size > 0 )
+		UnmapViewOfFile( m_data );
+
+	m_data = nullptr;
+	m_size = 0;
+}
+
+#else
+
+inline bool
+MappedFile::open( const std::string & path )
+{
+	close();
+
+	const int fd = ::open( path.c_str(), O_RDONLY );
+
+	if( fd < 0 )
+		return false;
+
+	struct stat st;
+
+	if( ::fstat( fd, &st ) != 0 || !S_ISREG( st.st_mode ) )
+	{
+		::close( fd );
+
+		return false;
+	}
+
+	// Empty file can't be mapped, its data is an empty string.
+	if( st.st_size == 0 )
+	{
+		::close( fd );
+
+		m_data = "";
+
+		return true;
+	}
+
+	void * data = ::mmap( nullptr, static_cast< std::size_t > ( st.st_size ),
+		PROT_READ, MAP_PRIVATE, fd, 0 );
+
+	::close( fd );
+
+	if( data == MAP_FAILED )
+		return false;
+
+	m_data = static_cast< const char* > ( data );
+	m_size = static_cast< std::size_t > ( st.st_size );
+
+	return true;
+}
+
+inline void
+MappedFile::close()
+{
+	if( m_size > 0 )
+		::munmap( const_cast< char* > ( m_data ), m_size );
+
+	m_data = nullptr;
+	m_size = 0;
+}
+
+#endif // _WIN32
+
+
+//
+// ResponseToken
+//
+
+//! Token of the response file.
+struct ResponseToken {
+	//! Begin of the token in the file.
+	const char * m_begin;
+	//! End of the token in the file.
+	const char * m_end;
+	//! Should quotes and escapes be removed from the token?
+	bool m_isQuoted;
+}; // struct ResponseToken
+
+
+namespace details {
+
+//! \return Is character a separator of the tokens in the text file?
+inline bool
+isResponseSpace( char c )
+{
+	return ( c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+		c == '\f' || c == '\v' );
+}
+
+/*!
+	Tokenize part of the response file.
+
+	\return Was chunk finished outside of the token, i.e. next chunk
+		can be tokenized independently?
+*/
+inline bool
+tokenizeResponseChunk( const char * first, const char * last,
+	bool isNulDelimited, std::vector< ResponseToken > & tokens )
+{
+	if( isNulDelimited )
+	{
+		while( first != last )
+		{
+			const char * end = static_cast< const char* > (
+				std::memchr( first, 0, static_cast< std::size_t > ( last - first ) ) );
+
+			if( !end )
+				end = last;
+
+			if( end != first )
+				tokens.push_back( { first, end, false } );
+
+			first = ( end == last ? last : end + 1 );
+		}
+
+		return true;
+	}
+
+	while( first != last )
+	{
+		while( first != last && isResponseSpace( *first ) )
+			++first;
+
+		if( first == last )
+			break;
+
+		const char * begin = first;
+		std::size_t specials = 0;
+		bool escape = false;
+		char quote = 0;
+
+		for( ; first != last; ++first )
+		{
+			if( escape )
+				escape = false;
+			else if( *first == '\\' )
+			{
+				escape = true;
+				++specials;
+			}
+			else if( quote )
+			{
+				if( *first == quote )
+				{
+					quote = 0;
+					++specials;
+				}
+			}
+			else if( *first == '\'' || *first == '"' )
+			{
+				quote = *first;
+				++specials;
+			}
+			else if( isResponseSpace( *first ) )
+				break;
+		}
+
+		// Unfinished token is taken as is.
+		if( escape || quote )
+		{
+			tokens.push_back( { begin, first, true } );
+
+			return false;
+		}
+
+		if( specials == 0 )
+			tokens.push_back( { begin, first, false } );
+		else if( specials == 2 && first - begin >= 2 &&
+			( *begin == '\'' || *begin == '"' ) && *( first - 1 ) == *begin )
+				tokens.push_back( { begin + 1, first - 1, false } );
+		else
+			tokens.push_back( { begin, first, true } );
+	}
+
+	return true;
+}
+
+/*!
+	\return Position after the first separator in [first, last) that
+		isn't escaped with backslash, or last. \a begin is the begin
+		of the file.
+*/
+inline const char *
+findResponseBound( const char * begin, const char * first, const char * last,
+	char separator )
+{
+	while( first != last )
+	{
+		const char * end = std::find( first, last, separator );
+
+		if( end == last )
+			return last;
+
+		// Separator is escaped by odd number of backslashes before it.
+		const char * escape = end;
+
+		while( separator != '\0' && escape != begin && *( escape - 1 ) == '\\' )
+			--escape;
+
+		if( ( end - escape ) % 2 == 0 )
+			return end + 1;
+
+		first = end + 1;
+	}
+
+	return last;
+}
+
+} /* namespace details */
+
+
+/*!
+	Split the response file into tokens.
+
+	If file contains NUL characters tokens are delimited with NUL,
+	else tokens are delimited with white spaces, white space can be
+	included in the token with single or double quotes, any character
+	can be included with backslash.
+
+	Files bigger than \a chunkSize are tokenized in parallel chunks,
+	not more than \a threads chunks at once. Zero \a threads means
+	number of the hardware threads.
+*/
+inline void
+tokenizeResponseFile( const char * first, const char * last,
+	std::vector< ResponseToken > & tokens,
+	std::size_t chunkSize = 1024 * 1024,
+	std::size_t threads = 0 )
+{
+	const std::size_t size = static_cast< std::size_t > ( last - first );
+	const bool isNulDelimited = ( std::memchr( first, 0, size ) != nullptr );
+	const char separator = ( isNulDelimited ? '\0' : '\n' );
+
+	const std::size_t hardware = ( threads > 0 ? threads :
+		std::max( 1u, std::thread::hardware_concurrency() ) );
+	const std::size_t count = std::min( hardware,
+		size / std::max< std::size_t > ( chunkSize, 1 ) );
+
+	if( count > 1 )
+	{
+		// Chunks begin after the not escaped separator.
+		std::vector< const char* > bounds( 1, first );
+
+		for( std::size_t i = 1; i < count; ++i )
+		{
+			const char * p = std::max( bounds.back(), first + size / count * i );
+
+			bounds.push_back( details::findResponseBound( first, p, last,
+				separator ) );
+		}
+
+		bounds.push_back( last );
+
+		std::vector< std::vector< ResponseToken > > chunks( count );
+		std::vector< char > isClean( count, 0 );
+
+		const auto tokenize = [ & ] ( std::size_t i )
+		{
+			isClean[ i ] = details::tokenizeResponseChunk( bounds[ i ],
+				bounds[ i + 1 ], isNulDelimited, chunks[ i ] );
+		};
+
+		std::vector< std::thread > workers;
+		workers.reserve( count - 1 );
+
+		try {
+			for( std::size_t i = 1; i < count; ++i )
+				workers.emplace_back( tokenize, i );
+		}
+		catch( const std::system_error & )
+		{
+		}
+
+		for( std::size_t i = workers.size() + 1; i < count; ++i )
+			tokenize( i );
+
+		tokenize( 0 );
+
+		for( auto & worker : workers )
+			worker.join();
+
+		// Token crosses the bound of the chunk, so it's tokenized again.
+		if( std::find( isClean.cbegin(), isClean.cend() - 1, 0 ) ==
+			isClean.cend() - 1 )
+		{
+			std::size_t total = tokens.size();
+
+			for( const auto & chunk : chunks )
+				total += chunk.size();
+
+			tokens.reserve( total );
+
+			for( const auto & chunk : chunks )
+				tokens.insert( tokens.end(), chunk.cbegin(), chunk.cend() );
+
+			return;
+		}
+	}
+
+	details::tokenizeResponseChunk( first, last, isNulDelimited, tokens );
+}
+
+//! \return Token with removed quotes and escapes in UTF-8.
+inline std::string
+unquoteResponseToken( const ResponseToken & token )
+{
+	std::string result;
+	result.reserve( static_cast< std::size_t > ( token.m_end - token.m_begin ) );
+
+	bool escape = false;
+	char quote = 0;
+
+	for( const char * p = token.m_begin; p != token.m_end; ++p )
+	{
+		if( escape )
+		{
+			result.push_back( *p );
+			escape = false;
+		}
+		else if( *p == '\\' )
+			escape = true;
+		else if( quote )
+		{
+			if( *p == quote )
+				quote = 0;
+			else
+				result.push_back( *p );
+		}
+		else if( *p == '\'' || *p == '"' )
+			quote = *p;
+		else
+			result.push_back( *p );
+	}
+
+	return result;
+}
+
+} /* namespace Args */
+
+#endif // ARGS__RESPONSE_FILE_HPP__INCLUDED
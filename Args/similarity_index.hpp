@@ -0,0 +1,358 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef ARGS__SIMILARITY_INDEX_HPP__INCLUDED
+#define ARGS__SIMILARITY_INDEX_HPP__INCLUDED
+
+// Args include.
+#include "typed_value.hpp"
+#include "types.hpp"
+
+// C++ include.
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+
+
+namespace Args {
+
+//
+// SimilarityIndex
+//
+
+/*!
+	Index of the names for the search of the similar names by the edit
+	distance, i.e. "--verbose" for "--verbos".
+
+	Names are indexed by pairs of adjacent characters (bigrams). One edit
+	breaks at most two bigrams, so name within distance k from the word
+	shares at least max( length ) - 1 - 2 * k bigrams with it. Common
+	bigrams are counted only for the names from the lists of the bigrams
+	of the word, and only names that pass this filter and have suitable
+	length are compared with the word, comparison stops as soon as
+	distance exceeds k. Short word can have no common bigrams with
+	similar name, for such word all names of suitable length are compared.
+
+	Many names can pass the filter if they are nearly identical, i.e.
+	"--option-1", "--option-2" and so on. Lists of up to
+	length - 2 - 2 * k most frequent bigrams of the word aren't looked
+	through, as name that has only these bigrams in common with the word
+	can't pass the filter. Names with more common bigrams are compared
+	first, and count of compared names can be limited.
+*/
+class SimilarityIndex final {
+public:
+	//! Distance to the word and name, name is valid till the change of the index.
+	using Match = std::pair< std::size_t, StringView >;
+
+	//! No limit of compared names.
+	static const std::size_t npos = static_cast< std::size_t > ( -1 );
+
+	SimilarityIndex()
+		:	m_generation( 0 )
+	{
+	}
+
+	//! Remove all names.
+	void clear()
+	{
+		m_names.clear();
+		m_bigrams.clear();
+		m_lengths.clear();
+		m_marks.clear();
+		m_shared.clear();
+		m_lists.clear();
+		m_offsets.clear();
+		m_order.clear();
+		m_generation = 0;
+	}
+
+	//! \return Is there no names in the index?
+	bool empty() const
+	{
+		return m_names.empty();
+	}
+
+	//! Add name.
+	void insert( const String & name )
+	{
+		const std::size_t index = m_names.size();
+
+		m_names.push_back( name );
+
+		const StringView view( m_names.back() );
+
+		for( StringView::size_type i = 1; i < view.size(); ++i )
+		{
+			auto & names = m_bigrams[ bigram( view, i ) ];
+
+			if( names.empty() || names.back() != index )
+				names.push_back( index );
+		}
+
+		if( m_lengths.size() <= view.size() )
+			m_lengths.resize( view.size() + 1 );
+
+		m_lengths[ view.size() ].push_back( index );
+	}
+
+	/*!
+		Append names within the given distance from the word. Not more
+		than \a maxCandidates names are compared with the word, names
+		with more common bigrams are preferred.
+
+		Isn't const because of the buffers reused between the searches.
+	*/
+	void find( const StringView & word, std::size_t maxDistance,
+		std::vector< Match > & to, std::size_t maxCandidates = npos )
+	{
+		if( ++m_generation == 0 )
+		{
+			std::fill( m_marks.begin(), m_marks.end(), 0 );
+			m_generation = 1;
+		}
+
+		m_marks.resize( m_names.size(), 0 );
+		m_shared.resize( m_names.size(), 0 );
+		m_touched.clear();
+
+		const auto compare = [ & ] ( std::size_t i )
+		{
+			const StringView name( m_names[ i ] );
+			const std::size_t d = distance( word, name, maxDistance, m_buffer );
+
+			if( d <= maxDistance )
+				to.push_back( std::make_pair( d, name ) );
+		};
+
+		// Similar name can have no common bigrams with the short word.
+		if( word.size() <= 1 + 2 * maxDistance )
+		{
+			const std::size_t first = ( word.size() > maxDistance ?
+				word.size() - maxDistance : 0 );
+			const std::size_t last = std::min( word.size() + maxDistance + 1,
+				m_lengths.size() );
+
+			for( std::size_t length = first; length < last; ++length )
+			{
+				for( const auto & i : m_lengths[ length ] )
+				{
+					if( maxCandidates == 0 )
+						return;
+
+					compare( i );
+					--maxCandidates;
+				}
+			}
+
+			return;
+		}
+
+		m_lists.clear();
+
+		for( StringView::size_type i = 1; i < word.size(); ++i )
+		{
+			const auto it = m_bigrams.find( bigram( word, i ) );
+
+			if( it != m_bigrams.cend() )
+				m_lists.push_back( &it->second );
+		}
+
+		// Name that has only skipped bigrams in common with the word is
+		// too far from it, so bigrams of the most names aren't counted.
+		// Every skipped bigram weakens the filter, so the ones that are
+		// rare enough to filter something are counted.
+		std::sort( m_lists.begin(), m_lists.end(),
+			[] ( const std::vector< std::size_t > * l1,
+				const std::vector< std::size_t > * l2 )
+					{ return l1->size() > l2->size(); } );
+
+		std::size_t skipped = 0;
+
+		while( skipped < m_lists.size() &&
+			skipped + 2 + 2 * maxDistance < word.size() &&
+			m_lists[ skipped ]->size() > m_names.size() / 4 )
+				++skipped;
+
+		for( std::size_t j = skipped; j < m_lists.size(); ++j )
+		{
+			for( const auto & name : *m_lists[ j ] )
+			{
+				if( m_marks[ name ] != m_generation )
+				{
+					m_marks[ name ] = m_generation;
+					m_shared[ name ] = 0;
+					m_touched.push_back( name );
+				}
+
+				++m_shared[ name ];
+			}
+		}
+
+		// Names that pass the filter are ordered by count of common
+		// bigrams, descending, with counting sort. Word has
+		// word.size() - 1 bigrams.
+		m_offsets.assign( word.size(), 0 );
+		m_order.clear();
+
+		for( const auto & i : m_touched )
+		{
+			const std::size_t longest = std::max(
+				StringView( m_names[ i ] ).size(), word.size() );
+
+			if( m_shared[ i ] + skipped + 1 + 2 * maxDistance >= longest )
+			{
+				m_order.push_back( i );
+				++m_offsets[ m_shared[ i ] ];
+			}
+		}
+
+		if( m_order.size() > maxCandidates )
+		{
+			std::size_t offset = 0;
+
+			for( std::size_t shared = m_offsets.size(); shared-- > 0; )
+			{
+				const std::size_t count = m_offsets[ shared ];
+				m_offsets[ shared ] = offset;
+				offset += count;
+			}
+
+			m_touched.resize( m_order.size() );
+
+			for( const auto & i : m_order )
+				m_touched[ m_offsets[ m_shared[ i ] ]++ ] = i;
+
+			m_touched.resize( maxCandidates );
+			m_order.swap( m_touched );
+		}
+
+		for( const auto & i : m_order )
+			compare( i );
+	}
+
+	//! \return Levenshtein distance between two strings.
+	static std::size_t distance( const StringView & s1, const StringView & s2 )
+	{
+		std::vector< std::size_t > buffer;
+
+		return distance( s1, s2, std::max( s1.size(), s2.size() ), buffer );
+	}
+
+private:
+	//! \return Bigram that ends at the given position.
+	static std::uint64_t bigram( const StringView & s, StringView::size_type i )
+	{
+		return ( static_cast< std::uint64_t > ( details::charCode( s[ i - 1 ] ) ) << 32 ) |
+			details::charCode( s[ i ] );
+	}
+
+	/*!
+		\return Levenshtein distance or maxDistance + 1 if distance
+		is greater.
+
+		Only cells of the matrix not farther than \a maxDistance
+		from the diagonal are computed, others can't give distance
+		within \a maxDistance.
+	*/
+	static std::size_t distance( const StringView & s1, const StringView & s2,
+		std::size_t maxDistance, std::vector< std::size_t > & buffer )
+	{
+		const std::size_t n = s1.size();
+		const std::size_t m = s2.size();
+		const std::size_t inf = maxDistance + 1;
+
+		if( std::max( n, m ) - std::min( n, m ) > maxDistance )
+			return inf;
+
+		buffer.assign( m + 1, inf );
+
+		for( std::size_t j = 0; j <= std::min( m, maxDistance ); ++j )
+			buffer[ j ] = j;
+
+		for( std::size_t i = 1; i <= n; ++i )
+		{
+			const std::size_t first = ( i > maxDistance ? i - maxDistance : 1 );
+			const std::size_t last = std::min( m, i + maxDistance );
+
+			std::size_t diagonal = buffer[ first - 1 ];
+			buffer[ first - 1 ] = ( first == 1 ? std::min( i, inf ) : inf );
+
+			std::size_t rowMin = buffer[ first - 1 ];
+
+			for( std::size_t j = first; j <= last; ++j )
+			{
+				const std::size_t up = buffer[ j ];
+
+				buffer[ j ] = std::min( { up + 1, buffer[ j - 1 ] + 1,
+					diagonal + ( s1[ i - 1 ] == s2[ j - 1 ] ? 0 : 1 ), inf } );
+
+				rowMin = std::min( rowMin, buffer[ j ] );
+				diagonal = up;
+			}
+
+			// Distance never decreases from row to row.
+			if( rowMin > maxDistance )
+				return inf;
+		}
+
+		return buffer[ m ];
+	}
+
+private:
+	//! Names.
+	std::vector< String > m_names;
+	//! Bigram -> indexes of the names that contain it.
+	std::unordered_map< std::uint64_t, std::vector< std::size_t > > m_bigrams;
+	//! Length -> indexes of the names of this length.
+	std::vector< std::vector< std::size_t > > m_lengths;
+	//! Generation of the search when the name was counted last time.
+	std::vector< std::size_t > m_marks;
+	//! Generation of the search.
+	std::size_t m_generation;
+	//! Count of common bigrams of the name and the word.
+	std::vector< std::size_t > m_shared;
+	//! Names that have common bigrams with the word.
+	std::vector< std::size_t > m_touched;
+	//! Lists of the names of the bigrams of the word.
+	std::vector< const std::vector< std::size_t > * > m_lists;
+	//! Count of common bigrams -> offset of such names in the order.
+	std::vector< std::size_t > m_offsets;
+	//! Names to compare with the word.
+	std::vector< std::size_t > m_order;
+	//! Row of the distance matrix.
+	std::vector< std::size_t > m_buffer;
+}; // class SimilarityIndex
+
+} /* namespace Args */
+
+#endif // ARGS__SIMILARITY_INDEX_HPP__INCLUDED
@@ -0,0 +1,952 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ARGS__STATIC_SCHEMA_HPP__INCLUDED
+#define ARGS__STATIC_SCHEMA_HPP__INCLUDED
+
+// Args include.
+#include "types.hpp"
+
+// C++ include.
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace Args {
+
+//! Character type of the string literals.
+using LiteralChar = std::remove_const< std::remove_reference<
+	decltype( SL( "" )[ 0 ] ) >::type >::type;
+
+
+//
+// StaticArgKind
+//
+
+//! Kind of the argument in the static schema.
+enum class StaticArgKind {
+	//! Argument with flag and/or name (Arg, MultiArg, Help).
+	Argument,
+	//! Command.
+	Command,
+	//! ArgAsCommand.
+	ArgAsCommand,
+	//! Group of arguments.
+	Group
+}; // enum class StaticArgKind
+
+
+//
+// StaticSchemaError
+//
+
+//! Errors in the static schema.
+enum class StaticSchemaError {
+	//! No error.
+	None = 0,
+	//! Argument without flag and name.
+	EmptyFlagAndName,
+	//! Flag with disallowed symbol.
+	DisallowedFlag,
+	//! Name with disallowed symbol.
+	DisallowedName,
+	//! Redefinition of the flag.
+	FlagRedefinition,
+	//! Redefinition of the name.
+	NameRedefinition,
+	//! There is no command or group with the given parent's name.
+	UnknownParent,
+	//! Commands can't be nested and groups can't be cyclic.
+	WrongParent,
+	//! Required argument in the group.
+	RequiredArgumentInGroup,
+	//! Perfect hash can't be built.
+	PerfectHashFailed
+}; // enum class StaticSchemaError
+
+
+//
+// StaticArgSpec
+//
+
+/*!
+	Description of the argument in the static schema.
+
+	Should be created with staticArg(), staticCommand(), staticArgAsCommand()
+	or staticGroup().
+*/
+class StaticArgSpec final {
+public:
+	constexpr StaticArgSpec()
+		:	m_kind( StaticArgKind::Argument )
+		,	m_flag( LiteralChar() )
+		,	m_name( nullptr )
+		,	m_parent( nullptr )
+		,	m_isWithValue( false )
+		,	m_isRequired( false )
+	{
+	}
+
+	constexpr StaticArgSpec( StaticArgKind kind, LiteralChar flag,
+		const LiteralChar * name )
+		:	m_kind( kind )
+		,	m_flag( flag )
+		,	m_name( name )
+		,	m_parent( nullptr )
+		,	m_isWithValue( false )
+		,	m_isRequired( false )
+	{
+	}
+
+	//! \return Copy of the spec with value.
+	constexpr StaticArgSpec withValue() const
+	{
+		StaticArgSpec spec = *this;
+		spec.m_isWithValue = true;
+
+		return spec;
+	}
+
+	//! \return Copy of the spec that is required.
+	constexpr StaticArgSpec required() const
+	{
+		StaticArgSpec spec = *this;
+		spec.m_isRequired = true;
+
+		return spec;
+	}
+
+	//! \return Copy of the spec that is a child of the command or group.
+	constexpr StaticArgSpec in( const LiteralChar * parent ) const
+	{
+		StaticArgSpec spec = *this;
+		spec.m_parent = parent;
+
+		return spec;
+	}
+
+	//! \return Kind.
+	constexpr StaticArgKind kind() const
+	{
+		return m_kind;
+	}
+
+	//! \return Flag, null character if there is no flag.
+	constexpr LiteralChar flag() const
+	{
+		return m_flag;
+	}
+
+	//! \return Has flag?
+	constexpr bool hasFlag() const
+	{
+		return !( m_flag == LiteralChar() );
+	}
+
+	//! \return Name, may be null.
+	constexpr const LiteralChar * name() const
+	{
+		return m_name;
+	}
+
+	//! \return Has name?
+	constexpr bool hasName() const
+	{
+		return ( m_name && !( m_name[ 0 ] == LiteralChar() ) );
+	}
+
+	//! \return Name of the parent, may be null.
+	constexpr const LiteralChar * parent() const
+	{
+		return m_parent;
+	}
+
+	//! \return Is with value?
+	constexpr bool isWithValue() const
+	{
+		return m_isWithValue;
+	}
+
+	//! \return Is required?
+	constexpr bool isRequired() const
+	{
+		return m_isRequired;
+	}
+
+private:
+	//! Kind.
+	StaticArgKind m_kind;
+	//! Flag.
+	LiteralChar m_flag;
+	//! Name.
+	const LiteralChar * m_name;
+	//! Name of the parent.
+	const LiteralChar * m_parent;
+	//! Is with value?
+	bool m_isWithValue;
+	//! Is required?
+	bool m_isRequired;
+}; // class StaticArgSpec
+
+
+//! \return Spec of the argument with flag and name.
+constexpr StaticArgSpec staticArg( LiteralChar flag, const LiteralChar * name )
+{
+	return StaticArgSpec( StaticArgKind::Argument, flag, name );
+}
+
+//! \return Spec of the argument with flag only.
+constexpr StaticArgSpec staticArg( LiteralChar flag )
+{
+	return StaticArgSpec( StaticArgKind::Argument, flag, nullptr );
+}
+
+//! \return Spec of the argument with name only.
+constexpr StaticArgSpec staticArg( const LiteralChar * name )
+{
+	return StaticArgSpec( StaticArgKind::Argument, LiteralChar(), name );
+}
+
+//! \return Spec of the command.
+constexpr StaticArgSpec staticCommand( const LiteralChar * name )
+{
+	return StaticArgSpec( StaticArgKind::Command, LiteralChar(), name );
+}
+
+//! \return Spec of the ArgAsCommand.
+constexpr StaticArgSpec staticArgAsCommand( const LiteralChar * name )
+{
+	return StaticArgSpec( StaticArgKind::ArgAsCommand, LiteralChar(), name );
+}
+
+//! \return Spec of the group.
+constexpr StaticArgSpec staticGroup( const LiteralChar * name )
+{
+	return StaticArgSpec( StaticArgKind::Group, LiteralChar(), name );
+}
+
+
+//
+// Hashing of the keys.
+//
+
+//! \return Initial hash for the scope.
+constexpr std::uint32_t staticHashInit( std::size_t scope )
+{
+	return ( 2166136261u ^ ( static_cast< std::uint32_t > ( scope ) * 2654435761u ) );
+}
+
+//! \return Hash with one more character (FNV-1a).
+constexpr std::uint32_t staticHashStep( std::uint32_t h, std::uint32_t ch )
+{
+	return ( ( h ^ ch ) * 16777619u );
+}
+
+//! \return Slot's hash of the key's hash with the displacement.
+constexpr std::uint32_t staticHashSlot( std::uint32_t h, std::uint32_t displacement )
+{
+	std::uint32_t x = h + displacement * 2654435769u;
+
+	x ^= x >> 16;
+	x *= 2246822507u;
+	x ^= x >> 13;
+	x *= 3266489909u;
+	x ^= x >> 16;
+
+	return x;
+}
+
+//! \return Code of the literal's character.
+constexpr std::uint32_t staticCharCode( LiteralChar ch )
+{
+	return static_cast< std::uint32_t > (
+		static_cast< typename std::make_unsigned< LiteralChar >::type > ( ch ) );
+}
+
+//! \return Code of the character.
+inline std::uint32_t staticCharCode( const StringView & word, std::size_t pos )
+{
+#ifdef ARGS_QSTRING_BUILD
+	return static_cast< std::uint32_t > ( word[ pos ].unicode() );
+#else
+	return staticCharCode( word[ pos ] );
+#endif
+}
+
+//! \return Is strings equal?
+constexpr bool staticIsEqual( const LiteralChar * s1, const LiteralChar * s2 )
+{
+	if( !s1 || !s2 )
+		return ( s1 == s2 );
+
+	std::size_t i = 0;
+
+	for( ; !( s1[ i ] == LiteralChar() ) && s1[ i ] == s2[ i ]; ++i ) {}
+
+	return ( s1[ i ] == s2[ i ] );
+}
+
+//! \return Is character allowed in the flag?
+constexpr bool staticIsCorrectFlag( LiteralChar ch )
+{
+	return ( ( ch >= SL( '0' ) && ch <= SL( '9' ) ) ||
+		( ch >= SL( 'a' ) && ch <= SL( 'z' ) ) ||
+		( ch >= SL( 'A' ) && ch <= SL( 'Z' ) ) );
+}
+
+//! \return Is name correct?
+constexpr bool staticIsCorrectName( const LiteralChar * name )
+{
+	if( !name || name[ 0 ] == LiteralChar() )
+		return false;
+
+	for( std::size_t i = 0; !( name[ i ] == LiteralChar() ); ++i )
+	{
+		if( !staticIsCorrectFlag( name[ i ] ) &&
+			!( name[ i ] == SL( '-' ) ) && !( name[ i ] == SL( '_' ) ) )
+				return false;
+	}
+
+	return true;
+}
+
+//! \return Power of 2 not less than the given number.
+constexpr std::size_t staticPow2( std::size_t n )
+{
+	std::size_t p = 1;
+
+	while( p < n )
+		p *= 2;
+
+	return p;
+}
+
+
+//
+// StaticSchemaView
+//
+
+/*!
+	Type erased static schema used by CmdLine.
+*/
+class StaticSchemaView final {
+public:
+	//! Not found spec.
+	static const std::size_t npos = static_cast< std::size_t > ( -1 );
+
+	StaticSchemaView()
+		:	m_specs( nullptr )
+		,	m_parents( nullptr )
+		,	m_count( 0 )
+		,	m_displacements( nullptr )
+		,	m_buckets( 0 )
+		,	m_slots( nullptr )
+		,	m_slotsCount( 0 )
+	{
+	}
+
+	StaticSchemaView( const StaticArgSpec * specs, const std::size_t * parents,
+		std::size_t count, const std::uint32_t * displacements,
+		std::size_t buckets, const std::uint32_t * slots, std::size_t slotsCount )
+		:	m_specs( specs )
+		,	m_parents( parents )
+		,	m_count( count )
+		,	m_displacements( displacements )
+		,	m_buckets( buckets )
+		,	m_slots( slots )
+		,	m_slotsCount( slotsCount )
+	{
+	}
+
+	//! \return Is there no schema?
+	bool isNull() const
+	{
+		return ( m_specs == nullptr );
+	}
+
+	//! \return Count of specs.
+	std::size_t size() const
+	{
+		return m_count;
+	}
+
+	//! \return Spec.
+	const StaticArgSpec & spec( std::size_t i ) const
+	{
+		return m_specs[ i ];
+	}
+
+	//! \return Index of the parent or npos.
+	std::size_t parent( std::size_t i ) const
+	{
+		return ( m_parents[ i ] == 0 ? npos : m_parents[ i ] - 1 );
+	}
+
+	/*!
+		\return Scope of the spec.
+
+		Scope is 0 for global arguments and commands and index of the
+		command plus one for children of the command.
+	*/
+	std::size_t scopeOf( std::size_t i ) const
+	{
+		if( m_specs[ i ].kind() == StaticArgKind::Command )
+			return 0;
+
+		for( std::size_t p = m_parents[ i ]; p != 0; p = m_parents[ p - 1 ] )
+		{
+			if( m_specs[ p - 1 ].kind() == StaticArgKind::Command )
+				return p;
+		}
+
+		return 0;
+	}
+
+	/*!
+		\return Index of the spec for the given word or npos.
+
+		Scope is 0 for global arguments and index of the command
+		plus one for children of the command.
+	*/
+	std::size_t find( std::size_t scope, const StringView & word ) const
+	{
+		if( isNull() || word.empty() )
+			return npos;
+
+		const std::size_t key = keyOf( hashOf( staticHashInit( scope ), word ),
+			scope );
+
+		if( key == npos || m_specs[ key / 2 ].kind() == StaticArgKind::Group )
+			return npos;
+
+		const StaticArgSpec & s = m_specs[ key / 2 ];
+
+		if( key % 2 == 0 )
+		{
+			if( word.size() == 2 && word[ 0 ] == SL( '-' ) &&
+				word[ 1 ] == s.flag() )
+					return key / 2;
+			else
+				return npos;
+		}
+
+		const std::size_t prefix = ( s.kind() == StaticArgKind::Argument ? 2 : 0 );
+
+		for( std::size_t j = 0; j < prefix; ++j )
+			if( j >= word.size() || !( word[ j ] == SL( '-' ) ) )
+				return npos;
+
+		return ( isNameOf( key / 2, word.substr( prefix ) ) ? key / 2 : npos );
+	}
+
+	//! \return Index of the argument with the given flag without dash or npos.
+	std::size_t findFlag( std::size_t scope, const StringView & flag ) const
+	{
+		if( isNull() || flag.size() != 1 )
+			return npos;
+
+		const std::size_t key = keyOf( hashOf( staticHashStep(
+			staticHashInit( scope ), staticCharCode( SL( '-' ) ) ), flag ), scope );
+
+		return ( key != npos && key % 2 == 0 &&
+			flag[ 0 ] == m_specs[ key / 2 ].flag() ? key / 2 : npos );
+	}
+
+	//! \return Index of the argument with the given name without dashes or npos.
+	std::size_t findName( std::size_t scope, const StringView & name ) const
+	{
+		if( isNull() || name.empty() )
+			return npos;
+
+		std::uint32_t h = staticHashInit( scope );
+		h = staticHashStep( h, staticCharCode( SL( '-' ) ) );
+		h = staticHashStep( h, staticCharCode( SL( '-' ) ) );
+
+		const std::size_t key = keyOf( hashOf( h, name ), scope );
+
+		return ( key != npos && key % 2 == 1 &&
+			m_specs[ key / 2 ].kind() == StaticArgKind::Argument &&
+			isNameOf( key / 2, name ) ? key / 2 : npos );
+	}
+
+	//! \return Index of the group with the given name or npos.
+	std::size_t findGroup( std::size_t scope, const StringView & name ) const
+	{
+		if( isNull() || name.empty() )
+			return npos;
+
+		const std::size_t key = keyOf( hashOf( staticHashStep(
+			staticHashInit( scope ), 0u ), name ), scope );
+
+		return ( key != npos &&
+			m_specs[ key / 2 ].kind() == StaticArgKind::Group &&
+			isNameOf( key / 2, name ) ? key / 2 : npos );
+	}
+
+private:
+	//! \return Hash with the characters of the word.
+	static std::uint32_t hashOf( std::uint32_t h, const StringView & word )
+	{
+		for( std::size_t i = 0; i < word.size(); ++i )
+			h = staticHashStep( h, staticCharCode( word, i ) );
+
+		return h;
+	}
+
+	//! \return Key in the slot of the hash or npos.
+	std::size_t keyOf( std::uint32_t h, std::size_t scope ) const
+	{
+		const std::uint32_t d =
+			m_displacements[ h & static_cast< std::uint32_t > ( m_buckets - 1 ) ];
+		const std::uint32_t key = m_slots[ staticHashSlot( h, d ) &
+			static_cast< std::uint32_t > ( m_slotsCount - 1 ) ];
+
+		// Keys of other scopes may take the probed slot.
+		if( key == 0 || scopeOf( ( key - 1 ) / 2 ) != scope )
+			return npos;
+
+		return key - 1;
+	}
+
+	//! \return Is name of the spec equal to the word?
+	bool isNameOf( std::size_t i, const StringView & word ) const
+	{
+		const LiteralChar * name = m_specs[ i ].name();
+
+		std::size_t j = 0;
+
+		for( ; j < word.size(); ++j )
+			if( name[ j ] == LiteralChar() || !( word[ j ] == name[ j ] ) )
+				return false;
+
+		return ( name[ j ] == LiteralChar() );
+	}
+
+	//! Specs.
+	const StaticArgSpec * m_specs;
+	//! Parents.
+	const std::size_t * m_parents;
+	//! Count of specs.
+	std::size_t m_count;
+	//! Displacements.
+	const std::uint32_t * m_displacements;
+	//! Count of buckets.
+	std::size_t m_buckets;
+	//! Slots.
+	const std::uint32_t * m_slots;
+	//! Count of slots.
+	std::size_t m_slotsCount;
+}; // class StaticSchemaView
+
+
+//
+// StaticSchema
+//
+
+/*!
+	Schema of the arguments known at compile time.
+
+	Schema is validated at compile time and contains perfect hash
+	table of flags and names. Use ARGS_STATIC_SCHEMA to declare schema
+	and CmdLine::setSchema() to use it.
+
+	Key of the flag is "-f", key of the argument's name is "--name",
+	key of the command and ArgAsCommand is its name. Children of commands
+	are in the scope of their command.
+*/
+template< std::size_t N >
+class StaticSchema final {
+public:
+	//! Count of buckets.
+	static constexpr std::size_t c_buckets = staticPow2( N );
+	//! Count of slots.
+	static constexpr std::size_t c_slots = staticPow2( N * 4 );
+	//! Max displacement to try.
+	static constexpr std::uint32_t c_maxDisplacement = 4096;
+
+	constexpr explicit StaticSchema( const StaticArgSpec ( & specs )[ N ] )
+		:	m_specs{}
+		,	m_parents{}
+		,	m_displacements{}
+		,	m_slots{}
+		,	m_error( StaticSchemaError::None )
+	{
+		for( std::size_t i = 0; i < N; ++i )
+			m_specs[ i ] = specs[ i ];
+
+		m_error = resolveParents();
+
+		if( m_error == StaticSchemaError::None )
+			m_error = validate();
+
+		if( m_error == StaticSchemaError::None )
+			m_error = buildTable();
+	}
+
+	//! \return Error in the schema.
+	constexpr StaticSchemaError error() const
+	{
+		return m_error;
+	}
+
+	//! \return Type erased view of the schema.
+	StaticSchemaView view() const
+	{
+		return StaticSchemaView( m_specs, m_parents, N, m_displacements,
+			c_buckets, m_slots, c_slots );
+	}
+
+private:
+	//! \return Index of the command or group with the given name or N.
+	constexpr std::size_t findParent( const LiteralChar * name ) const
+	{
+		for( std::size_t i = 0; i < N; ++i )
+		{
+			if( ( m_specs[ i ].kind() == StaticArgKind::Command ||
+					m_specs[ i ].kind() == StaticArgKind::Group ) &&
+				staticIsEqual( m_specs[ i ].name(), name ) )
+					return i;
+		}
+
+		return N;
+	}
+
+	//! Resolve parents.
+	constexpr StaticSchemaError resolveParents()
+	{
+		for( std::size_t i = 0; i < N; ++i )
+		{
+			if( m_specs[ i ].parent() )
+			{
+				const std::size_t p = findParent( m_specs[ i ].parent() );
+
+				if( p == N )
+					return StaticSchemaError::UnknownParent;
+
+				if( p == i || m_specs[ i ].kind() == StaticArgKind::Command )
+					return StaticSchemaError::WrongParent;
+
+				m_parents[ i ] = p + 1;
+			}
+		}
+
+		// Cycles of groups.
+		for( std::size_t i = 0; i < N; ++i )
+		{
+			std::size_t p = m_parents[ i ];
+
+			for( std::size_t depth = 0; p != 0; ++depth )
+			{
+				if( depth == N )
+					return StaticSchemaError::WrongParent;
+
+				p = m_parents[ p - 1 ];
+			}
+		}
+
+		return StaticSchemaError::None;
+	}
+
+	//! \return Scope of the spec.
+	constexpr std::size_t scope( std::size_t i ) const
+	{
+		if( m_specs[ i ].kind() == StaticArgKind::Command )
+			return 0;
+
+		for( std::size_t p = m_parents[ i ]; p != 0; p = m_parents[ p - 1 ] )
+		{
+			if( m_specs[ p - 1 ].kind() == StaticArgKind::Command )
+				return p;
+		}
+
+		return 0;
+	}
+
+	//! \return Do scopes intersect?
+	constexpr bool isSameScope( std::size_t i, std::size_t j ) const
+	{
+		return ( scope( i ) == scope( j ) || scope( i ) == 0 || scope( j ) == 0 );
+	}
+
+	//! Validate specs.
+	constexpr StaticSchemaError validate() const
+	{
+		for( std::size_t i = 0; i < N; ++i )
+		{
+			const StaticArgSpec & s = m_specs[ i ];
+
+			switch( s.kind() )
+			{
+				case StaticArgKind::Argument :
+				{
+					if( !s.hasFlag() && !s.hasName() )
+						return StaticSchemaError::EmptyFlagAndName;
+
+					if( s.hasFlag() && !staticIsCorrectFlag( s.flag() ) )
+						return StaticSchemaError::DisallowedFlag;
+
+					if( s.hasName() && !staticIsCorrectName( s.name() ) )
+						return StaticSchemaError::DisallowedName;
+				}
+					break;
+
+				default :
+				{
+					if( !staticIsCorrectName( s.name() ) ||
+						s.name()[ 0 ] == SL( '-' ) )
+							return StaticSchemaError::DisallowedName;
+				}
+					break;
+			}
+
+			if( s.isRequired() && m_parents[ i ] != 0 &&
+				m_specs[ m_parents[ i ] - 1 ].kind() == StaticArgKind::Group )
+					return StaticSchemaError::RequiredArgumentInGroup;
+
+			for( std::size_t j = 0; j < i; ++j )
+			{
+				const StaticArgSpec & o = m_specs[ j ];
+
+				if( s.kind() == StaticArgKind::Group ||
+					o.kind() == StaticArgKind::Group )
+				{
+					if( s.kind() == o.kind() ||
+						o.kind() == StaticArgKind::Command ||
+						s.kind() == StaticArgKind::Command )
+					{
+						if( staticIsEqual( s.name(), o.name() ) )
+							return StaticSchemaError::NameRedefinition;
+					}
+
+					continue;
+				}
+
+				if( !isSameScope( i, j ) )
+					continue;
+
+				if( s.hasFlag() && o.hasFlag() && s.flag() == o.flag() )
+					return StaticSchemaError::FlagRedefinition;
+
+				if( s.hasName() && o.hasName() &&
+					staticIsEqual( s.name(), o.name() ) )
+						return StaticSchemaError::NameRedefinition;
+			}
+		}
+
+		return StaticSchemaError::None;
+	}
+
+	//! \return Hash of the key.
+	constexpr std::uint32_t keyHash( std::size_t key ) const
+	{
+		const StaticArgSpec & s = m_specs[ key / 2 ];
+
+		std::uint32_t h = staticHashInit( scope( key / 2 ) );
+
+		if( key % 2 == 0 )
+		{
+			h = staticHashStep( h, staticCharCode( SL( '-' ) ) );
+
+			return staticHashStep( h, staticCharCode( s.flag() ) );
+		}
+
+		if( s.kind() == StaticArgKind::Argument )
+		{
+			h = staticHashStep( h, staticCharCode( SL( '-' ) ) );
+			h = staticHashStep( h, staticCharCode( SL( '-' ) ) );
+		}
+		// Group's name can be equal to the word of ArgAsCommand.
+		else if( s.kind() == StaticArgKind::Group )
+			h = staticHashStep( h, 0u );
+
+		for( std::size_t i = 0; !( s.name()[ i ] == LiteralChar() ); ++i )
+			h = staticHashStep( h, staticCharCode( s.name()[ i ] ) );
+
+		return h;
+	}
+
+	/*!
+		\return Does key exist? Even keys are flags, odd keys are names.
+		Groups are in the table too, so arguments are bound to them
+		without search.
+	*/
+	constexpr bool isKey( std::size_t key ) const
+	{
+		const StaticArgSpec & s = m_specs[ key / 2 ];
+
+		if( s.kind() == StaticArgKind::Group )
+			return ( key % 2 == 1 );
+		else if( key % 2 == 0 )
+			return s.hasFlag();
+		else
+			return s.hasName();
+	}
+
+	//! Build perfect hash table with "hash and displace".
+	constexpr StaticSchemaError buildTable()
+	{
+		std::uint32_t hashes[ N * 2 ] = {};
+		std::size_t sizes[ c_buckets ] = {};
+		std::size_t maxSize = 0;
+
+		for( std::size_t k = 0; k < N * 2; ++k )
+		{
+			if( isKey( k ) )
+			{
+				hashes[ k ] = keyHash( k );
+
+				const std::size_t b = hashes[ k ] & ( c_buckets - 1 );
+
+				++sizes[ b ];
+
+				if( sizes[ b ] > maxSize )
+					maxSize = sizes[ b ];
+			}
+		}
+
+		// Biggest buckets first.
+		for( std::size_t size = maxSize; size > 0; --size )
+		{
+			for( std::size_t b = 0; b < c_buckets; ++b )
+			{
+				if( sizes[ b ] != size )
+					continue;
+
+				bool placed = false;
+
+				for( std::uint32_t d = 0; d < c_maxDisplacement && !placed; ++d )
+				{
+					placed = true;
+
+					for( std::size_t k = 0; k < N * 2 && placed; ++k )
+					{
+						if( !isKey( k ) || ( hashes[ k ] & ( c_buckets - 1 ) ) != b )
+							continue;
+
+						const std::size_t slot =
+							staticHashSlot( hashes[ k ], d ) & ( c_slots - 1 );
+
+						if( m_slots[ slot ] != 0 )
+							placed = false;
+						else
+							m_slots[ slot ] = static_cast< std::uint32_t > ( k + 1 );
+					}
+
+					if( placed )
+						m_displacements[ b ] = d;
+					else
+					{
+						// Rollback.
+						for( std::size_t k = 0; k < N * 2; ++k )
+						{
+							if( isKey( k ) && ( hashes[ k ] & ( c_buckets - 1 ) ) == b )
+							{
+								const std::size_t slot =
+									staticHashSlot( hashes[ k ], d ) & ( c_slots - 1 );
+
+								if( m_slots[ slot ] == k + 1 )
+									m_slots[ slot ] = 0;
+							}
+						}
+					}
+				}
+
+				if( !placed )
+					return StaticSchemaError::PerfectHashFailed;
+			}
+		}
+
+		return StaticSchemaError::None;
+	}
+
+private:
+	//! Specs.
+	StaticArgSpec m_specs[ N ];
+	//! Index of the parent plus one, 0 if there is no parent.
+	std::size_t m_parents[ N ];
+	//! Displacements of the buckets.
+	std::uint32_t m_displacements[ c_buckets ];
+	//! Slots, key plus one or 0 for empty slot.
+	std::uint32_t m_slots[ c_slots ];
+	//! Error.
+	StaticSchemaError m_error;
+}; // class StaticSchema
+
+template< std::size_t N >
+constexpr std::size_t StaticSchema< N >::c_buckets;
+
+template< std::size_t N >
+constexpr std::size_t StaticSchema< N >::c_slots;
+
+template< std::size_t N >
+constexpr std::uint32_t StaticSchema< N >::c_maxDisplacement;
+
+
+//! \return Static schema.
+template< std::size_t N >
+constexpr StaticSchema< N > makeStaticSchema( const StaticArgSpec ( & specs )[ N ] )
+{
+	return StaticSchema< N >( specs );
+}
+
+
+//
+// ARGS_STATIC_SCHEMA
+//
+
+/*!
+	Declare constexpr schema with the given name from the array
+	of StaticArgSpec and validate it at compile time.
+*/
+#define ARGS_STATIC_SCHEMA( Name, Specs ) \
+	constexpr auto Name = ::Args::makeStaticSchema( Specs ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::EmptyFlagAndName, \
+		"Arguments with empty flag and name are dissallowed." ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::DisallowedFlag, \
+		"Dissallowed flag in the schema." ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::DisallowedName, \
+		"Dissallowed name in the schema." ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::FlagRedefinition, \
+		"Redefinition of the flag in the schema." ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::NameRedefinition, \
+		"Redefinition of the name in the schema." ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::UnknownParent, \
+		"Unknown command or group in the schema." ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::WrongParent, \
+		"Nested command or cyclic group in the schema." ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::RequiredArgumentInGroup, \
+		"Required argument is not allowed to be in group." ); \
+	static_assert( Name.error() != ::Args::StaticSchemaError::PerfectHashFailed, \
+		"Perfect hash can't be built for the schema." );
+
+} /* namespace Args */
+
+#endif // ARGS__STATIC_SCHEMA_HPP__INCLUDED
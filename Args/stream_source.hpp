@@ -0,0 +1,267 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ARGS__STREAM_SOURCE_HPP__INCLUDED
+#define ARGS__STREAM_SOURCE_HPP__INCLUDED
+
+// Args include.
+#include "utils.hpp"
+#include "types.hpp"
+
+// C++ include.
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#ifdef _WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
+
+
+namespace Args {
+
+//
+// StreamSource
+//
+
+/*!
+	Source of the words from the file descriptor (standard input by
+	default), i.e. for "find -print0 | tool --files -".
+
+	Words are read lazily in big chunks with constant memory: buffer
+	grows only if one word doesn't fit in it. Word is valid till the
+	next call of next().
+*/
+class StreamSource final {
+public:
+	//! Delimiter of the words.
+	enum Delimiter {
+		/*!
+			NUL if the first chunk with delimiters contains NUL,
+			newline otherwise.
+		*/
+		Auto,
+		//! NUL.
+		Nul,
+		//! Newline, "\r\n" is supported too.
+		Newline
+	}; // enum Delimiter
+
+	explicit StreamSource(
+		//! File descriptor.
+		int fd = 0,
+		//! Delimiter of the words.
+		Delimiter delimiter = Auto,
+		//! Size of the chunk.
+		std::size_t chunkSize = 64 * 1024 )
+		:	m_fd( fd )
+		,	m_delimiter( delimiter )
+		,	m_buffer( std::max< std::size_t > ( chunkSize, 16 ) )
+		,	m_begin( 0 )
+		,	m_end( 0 )
+		,	m_isEof( false )
+		,	m_hasError( false )
+	{
+	}
+
+	/*!
+		Read next word. Empty words are skipped. Last word is dropped
+		if it can't be read completely because of the read error.
+
+		\return false if there are no more words.
+	*/
+	bool next( StringView & word );
+
+	//! \return Was there a read error?
+	bool hasError() const
+	{
+		return m_hasError;
+	}
+
+	/*!
+		\return Delimiter, if it was Auto it's known after reading of
+		the first delimiter.
+	*/
+	Delimiter delimiter() const
+	{
+		return m_delimiter;
+	}
+
+private:
+	DISABLE_COPY( StreamSource )
+
+	//! Read next chunk. \return Was anything read?
+	bool fill();
+
+	//! File descriptor.
+	int m_fd;
+	//! Delimiter.
+	Delimiter m_delimiter;
+	//! Buffer.
+	std::vector< char > m_buffer;
+	//! Begin of the not taken data in the buffer.
+	std::size_t m_begin;
+	//! End of the data in the buffer.
+	std::size_t m_end;
+	//! Is end of the stream reached?
+	bool m_isEof;
+	//! Was there a read error?
+	bool m_hasError;
+#if defined( ARGS_WSTRING_BUILD ) || defined( ARGS_QSTRING_BUILD )
+	//! Decoded word.
+	String m_word;
+#endif
+}; // class StreamSource
+
+
+//
+// StreamSource
+//
+
+inline bool
+StreamSource::fill()
+{
+	if( m_isEof )
+		return false;
+
+	if( m_begin > 0 )
+	{
+		std::memmove( m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin );
+		m_end -= m_begin;
+		m_begin = 0;
+	}
+
+	// Word doesn't fit in the buffer.
+	if( m_end == m_buffer.size() )
+		m_buffer.resize( m_buffer.size() * 2 );
+
+	for( ; ; )
+	{
+#ifdef _WIN32
+		const int bytes = ::_read( m_fd, m_buffer.data() + m_end,
+			static_cast< unsigned int > ( std::min< std::size_t > (
+				m_buffer.size() - m_end, 0x7FFFFFFF ) ) );
+#else
+		const ssize_t bytes = ::read( m_fd, m_buffer.data() + m_end,
+			m_buffer.size() - m_end );
+#endif
+
+		if( bytes < 0 && errno == EINTR )
+			continue;
+
+		if( bytes <= 0 )
+		{
+			m_hasError = ( bytes < 0 );
+			m_isEof = true;
+
+			return false;
+		}
+
+		// Previous chunks don't have delimiters at all.
+		if( m_delimiter == Auto )
+		{
+			const char * data = m_buffer.data() + m_end;
+			const std::size_t size = static_cast< std::size_t > ( bytes );
+
+			if( std::memchr( data, 0, size ) )
+				m_delimiter = Nul;
+			else if( std::memchr( data, '\n', size ) )
+				m_delimiter = Newline;
+		}
+
+		m_end += static_cast< std::size_t > ( bytes );
+
+		return true;
+	}
+}
+
+inline bool
+StreamSource::next( StringView & word )
+{
+	for( ; ; )
+	{
+		const char separator = ( m_delimiter == Nul ? '\0' : '\n' );
+		const char * data = m_buffer.data();
+
+		const char * end = ( m_delimiter == Auto ? nullptr :
+			static_cast< const char* > ( std::memchr( data + m_begin, separator,
+				m_end - m_begin ) ) );
+
+		const char * first = data + m_begin;
+		const char * last = nullptr;
+
+		if( end )
+		{
+			last = end;
+			m_begin = static_cast< std::size_t > ( end - data ) + 1;
+		}
+		else if( !fill() )
+		{
+			// Last word without delimiter, it's incomplete on read error.
+			if( m_begin == m_end || m_hasError )
+			{
+				m_begin = m_end;
+
+				return false;
+			}
+
+			first = m_buffer.data() + m_begin;
+			last = m_buffer.data() + m_end;
+			m_begin = m_end;
+		}
+		else
+			continue;
+
+		if( m_delimiter != Nul && last != first && *( last - 1 ) == '\r' )
+			--last;
+
+		if( last == first )
+			continue;
+
+		const std::size_t size = static_cast< std::size_t > ( last - first );
+
+#if defined( ARGS_WSTRING_BUILD ) || defined( ARGS_QSTRING_BUILD )
+		m_word = details::fromUtf8( first, size );
+		word = StringView( m_word );
+#else
+		word = StringView( first, size );
+#endif
+
+		return true;
+	}
+}
+
+} /* namespace Args */
+
+#endif // ARGS__STREAM_SOURCE_HPP__INCLUDED
@@ -0,0 +1,819 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ARGS__TYPED_VALUE_HPP__INCLUDED
+#define ARGS__TYPED_VALUE_HPP__INCLUDED
+
+// Args include.
+#include "utils.hpp"
+#include "types.hpp"
+
+// C++ include.
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined( __has_include )
+	#if __has_include( <charconv> ) && ( __cplusplus >= 201703L || \
+		( defined( _MSVC_LANG ) && _MSVC_LANG >= 201703L ) )
+		#define ARGS_HAS_FROM_CHARS
+		#include <charconv>
+		#include <system_error>
+
+		#ifdef __cpp_lib_to_chars
+			#define ARGS_HAS_FLOAT_FROM_CHARS
+		#endif
+	#endif
+#endif
+
+
+namespace Args {
+
+//
+// ByteSize
+//
+
+/*!
+	Size in bytes with optional suffix in the command line:
+	B, K (KiB), M (MiB), G (GiB), T (TiB) are powers of 1024,
+	KB, MB, GB, TB are powers of 1000.
+*/
+class ByteSize final {
+public:
+	explicit ByteSize( std::uint64_t bytes = 0 )
+		:	m_bytes( bytes )
+	{
+	}
+
+	//! \return Count of bytes.
+	std::uint64_t bytes() const
+	{
+		return m_bytes;
+	}
+
+	friend bool operator == ( const ByteSize & s1, const ByteSize & s2 )
+	{
+		return ( s1.m_bytes == s2.m_bytes );
+	}
+
+	friend bool operator != ( const ByteSize & s1, const ByteSize & s2 )
+	{
+		return !( s1 == s2 );
+	}
+
+private:
+	//! Count of bytes.
+	std::uint64_t m_bytes;
+}; // class ByteSize
+
+
+//! \return Description of the value that can't be converted.
+inline String
+invalidValueDescription( const String & value, const String & argName )
+{
+	return String( SL( "Value \"" ) ) + value + SL( "\" of argument \"" ) +
+		argName + SL( "\" is invalid." );
+}
+
+
+namespace details {
+
+#ifdef ARGS_QSTRING_BUILD
+//! \return Code of the character.
+inline unsigned int
+charCode( const QChar & ch )
+{
+	return ch.unicode();
+}
+#endif
+
+//! \return Code of the character.
+template< typename C >
+inline unsigned int
+charCode( C ch )
+{
+	return static_cast< unsigned int > ( std::char_traits< C >::to_int_type( ch ) );
+}
+
+
+//
+// AsciiValue
+//
+
+/*!
+	Value as a sequence of chars for the conversion. Narrow strings
+	are used as is, wide strings are copied into the internal buffer.
+*/
+class AsciiValue final {
+public:
+	explicit AsciiValue( const StringView & value )
+		:	m_begin( nullptr )
+		,	m_end( nullptr )
+		,	m_isValid( false )
+	{
+		init( value.data(), value.size() );
+	}
+
+	//! \return Is value can be presented with ASCII?
+	bool isValid() const
+	{
+		return m_isValid;
+	}
+
+	//! \return Begin of the value.
+	const char * begin() const
+	{
+		return m_begin;
+	}
+
+	//! \return End of the value.
+	const char * end() const
+	{
+		return m_end;
+	}
+
+private:
+	DISABLE_COPY( AsciiValue )
+
+	//! Use narrow string as is.
+	void init( const char * data, std::size_t size )
+	{
+		m_begin = data;
+		m_end = data + size;
+		m_isValid = true;
+	}
+
+	//! Copy wide string.
+	template< typename C >
+	void init( const C * data, std::size_t size )
+	{
+		if( size > sizeof( m_buffer ) )
+			return;
+
+		for( std::size_t i = 0; i < size; ++i )
+		{
+			const unsigned int code = charCode( data[ i ] );
+
+			if( code > 127 )
+				return;
+
+			m_buffer[ i ] = static_cast< char > ( code );
+		}
+
+		init( m_buffer, size );
+	}
+
+	//! Buffer for the wide strings.
+	char m_buffer[ 128 ];
+	//! Begin.
+	const char * m_begin;
+	//! End.
+	const char * m_end;
+	//! Is valid?
+	bool m_isValid;
+}; // class AsciiValue
+
+
+//! Convert string to integer.
+template< typename T >
+inline bool
+parseInteger( const char * first, const char * last, T & value )
+{
+#ifdef ARGS_HAS_FROM_CHARS
+	const auto r = std::from_chars( first, last, value );
+
+	return ( r.ec == std::errc() && r.ptr == last );
+#else
+	typedef typename std::make_unsigned< T >::type Unsigned;
+
+	if( first == last )
+		return false;
+
+	const bool negative = ( *first == '-' );
+
+	if( negative )
+	{
+		if( !std::is_signed< T >::value || ++first == last )
+			return false;
+	}
+
+	const Unsigned limit = static_cast< Unsigned > (
+		static_cast< Unsigned > ( std::numeric_limits< T >::max() ) +
+			( negative ? 1u : 0u ) );
+
+	Unsigned result = 0;
+
+	for( ; first != last; ++first )
+	{
+		if( *first < '0' || *first > '9' )
+			return false;
+
+		const Unsigned digit = static_cast< Unsigned > ( *first - '0' );
+
+		if( result > static_cast< Unsigned > ( ( limit - digit ) / 10u ) )
+			return false;
+
+		result = static_cast< Unsigned > ( result * 10u + digit );
+	}
+
+	value = static_cast< T > ( negative ?
+		static_cast< Unsigned > ( 0u - result ) : result );
+
+	return true;
+#endif
+}
+
+/*!
+	Convert beginning of the string to finite floating point number in
+	the classic locale. Infinity and NaN are accepted by std::from_chars()
+	only, so they are rejected to have the same result with any standard.
+
+	\return End of the number or nullptr if there is no number.
+*/
+template< typename T >
+inline const char *
+parseFloatPrefix( const char * first, const char * last, T & value )
+{
+#ifdef ARGS_HAS_FLOAT_FROM_CHARS
+	const auto r = std::from_chars( first, last, value );
+
+	if( r.ec != std::errc() )
+		return nullptr;
+
+	const char * end = r.ptr;
+#else
+	if( first == last || !( ( *first >= '0' && *first <= '9' ) ||
+		*first == '-' || *first == '.' ) )
+			return nullptr;
+
+	std::istringstream stream( std::string( first, last ) );
+	stream.imbue( std::locale::classic() );
+
+	stream >> value;
+
+	if( stream.fail() )
+		return nullptr;
+
+	const char * end = ( stream.eof() ? last :
+		first + static_cast< std::streamoff > ( stream.tellg() ) );
+#endif
+
+	return ( std::isfinite( value ) ? end : nullptr );
+}
+
+//! Convert string to finite floating point number in the classic locale.
+template< typename T >
+inline bool
+parseFloat( const char * first, const char * last, T & value )
+{
+	return ( parseFloatPrefix( first, last, value ) == last );
+}
+
+//! \return Position of the suffix (first letter) in the value.
+inline const char *
+findSuffix( const char * first, const char * last )
+{
+	for( ; first != last; ++first )
+	{
+		if( ( *first >= 'a' && *first <= 'z' ) ||
+			( *first >= 'A' && *first <= 'Z' ) )
+				break;
+	}
+
+	return first;
+}
+
+/*!
+	Convert integer at the beginning of the string.
+
+	\return Position of the suffix or nullptr if there is no number.
+*/
+template< typename T >
+inline const char *
+parseNumberPrefix( const char * first, const char * last, T & value,
+	std::true_type )
+{
+	const char * suffix = findSuffix( first, last );
+
+	return ( parseInteger( first, suffix, value ) ? suffix : nullptr );
+}
+
+/*!
+	Convert floating point number at the beginning of the string,
+	so exponent, i.e. "1e3ms", isn't taken as the suffix.
+
+	\return Position of the suffix or nullptr if there is no number.
+*/
+template< typename T >
+inline const char *
+parseNumberPrefix( const char * first, const char * last, T & value,
+	std::false_type )
+{
+	return parseFloatPrefix( first, last, value );
+}
+
+//! \return Is string equal to the given null-terminated one?
+inline bool
+isEqual( const char * first, const char * last, const char * suffix )
+{
+	for( ; first != last; ++first, ++suffix )
+	{
+		if( *first != *suffix )
+			return false;
+	}
+
+	return ( *suffix == 0 );
+}
+
+//! \return Greatest common divisor.
+inline std::intmax_t
+gcd( std::intmax_t a, std::intmax_t b )
+{
+	while( b != 0 )
+	{
+		const std::intmax_t t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+//! Convert count of units to the duration with integral representation.
+template< typename Rep >
+inline bool
+scaleDuration( Rep count, std::intmax_t num, std::intmax_t den, Rep & result,
+	std::true_type )
+{
+	if( count % den != 0 )
+		return false;
+
+	count /= den;
+
+	if( count > std::numeric_limits< Rep >::max() / num ||
+		count < std::numeric_limits< Rep >::min() / num )
+			return false;
+
+	result = static_cast< Rep > ( count * num );
+
+	return true;
+}
+
+//! Convert count of units to the duration with floating point representation.
+template< typename Rep >
+inline bool
+scaleDuration( Rep count, std::intmax_t num, std::intmax_t den, Rep & result,
+	std::false_type )
+{
+	result = count * static_cast< Rep > ( num ) / static_cast< Rep > ( den );
+
+	return true;
+}
+
+} /* namespace details */
+
+
+//
+// ValueConverter
+//
+
+/*!
+	Conversion of the value of the argument to the type \a T.
+
+	Specialize it for own types, specialization should have
+	static bool convert( const StringView & value, T & result ).
+*/
+template< typename T, typename Enable = void >
+struct ValueConverter;
+
+//! Conversion to integer.
+template< typename T >
+struct ValueConverter< T, typename std::enable_if<
+	std::is_integral< T >::value && !std::is_same< T, bool >::value >::type >
+{
+	static bool convert( const StringView & value, T & result )
+	{
+		const details::AsciiValue ascii( value );
+
+		return ( ascii.isValid() &&
+			details::parseInteger( ascii.begin(), ascii.end(), result ) );
+	}
+}; // struct ValueConverter
+
+//! Conversion to floating point number.
+template< typename T >
+struct ValueConverter< T, typename std::enable_if<
+	std::is_floating_point< T >::value >::type >
+{
+	static bool convert( const StringView & value, T & result )
+	{
+		const details::AsciiValue ascii( value );
+
+		return ( ascii.isValid() &&
+			details::parseFloat( ascii.begin(), ascii.end(), result ) );
+	}
+}; // struct ValueConverter
+
+//! Conversion to bool: true, false, yes, no, on, off, 1, 0.
+template<>
+struct ValueConverter< bool >
+{
+	static bool convert( const StringView & value, bool & result )
+	{
+		const details::AsciiValue ascii( value );
+
+		if( !ascii.isValid() )
+			return false;
+
+		static const char * const c_true[] = { "true", "yes", "on", "1" };
+		static const char * const c_false[] = { "false", "no", "off", "0" };
+
+		for( std::size_t i = 0; i < 4; ++i )
+		{
+			if( details::isEqual( ascii.begin(), ascii.end(), c_true[ i ] ) )
+			{
+				result = true;
+
+				return true;
+			}
+			else if( details::isEqual( ascii.begin(), ascii.end(),
+				c_false[ i ] ) )
+			{
+				result = false;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+}; // struct ValueConverter< bool >
+
+/*!
+	Conversion to duration: count with optional suffix
+	ns, us, ms, s, m (min), h, d. Count without suffix is in the
+	units of the duration. Conversion that loses precision fails.
+*/
+template< typename Rep, typename Period >
+struct ValueConverter< std::chrono::duration< Rep, Period > >
+{
+	static bool convert( const StringView & value,
+		std::chrono::duration< Rep, Period > & result )
+	{
+		const details::AsciiValue ascii( value );
+
+		if( !ascii.isValid() )
+			return false;
+
+		typedef std::integral_constant< bool,
+			std::is_integral< Rep >::value > IsIntegral;
+
+		Rep count = 0;
+
+		const char * suffix = details::parseNumberPrefix( ascii.begin(),
+			ascii.end(), count, IsIntegral() );
+
+		if( !suffix )
+			return false;
+
+		struct Unit {
+			const char * m_suffix;
+			std::intmax_t m_num;
+			std::intmax_t m_den;
+		};
+
+		static const Unit c_units[] = {
+			{ "", Period::num, Period::den },
+			{ "ns", 1, 1000000000 },
+			{ "us", 1, 1000000 },
+			{ "ms", 1, 1000 },
+			{ "s", 1, 1 },
+			{ "m", 60, 1 },
+			{ "min", 60, 1 },
+			{ "h", 3600, 1 },
+			{ "d", 86400, 1 }
+		};
+
+		for( const auto & unit : c_units )
+		{
+			if( details::isEqual( suffix, ascii.end(), unit.m_suffix ) )
+			{
+				std::intmax_t num = unit.m_num * Period::den;
+				std::intmax_t den = unit.m_den * Period::num;
+				const std::intmax_t d = details::gcd( num, den );
+				num /= d;
+				den /= d;
+
+				Rep scaled = 0;
+
+				if( !details::scaleDuration( count, num, den, scaled,
+					IsIntegral() ) )
+						return false;
+
+				result = std::chrono::duration< Rep, Period > ( scaled );
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+}; // struct ValueConverter< std::chrono::duration >
+
+//! Conversion to size in bytes.
+template<>
+struct ValueConverter< ByteSize >
+{
+	static bool convert( const StringView & value, ByteSize & result )
+	{
+		const details::AsciiValue ascii( value );
+
+		if( !ascii.isValid() )
+			return false;
+
+		const char * suffix = details::findSuffix( ascii.begin(), ascii.end() );
+
+		std::uint64_t count = 0;
+
+		if( !details::parseInteger( ascii.begin(), suffix, count ) )
+			return false;
+
+		struct Unit {
+			const char * m_suffix;
+			std::uint64_t m_factor;
+		};
+
+		static const Unit c_units[] = {
+			{ "", 1ull },
+			{ "B", 1ull },
+			{ "K", 1ull << 10 },
+			{ "KiB", 1ull << 10 },
+			{ "KB", 1000ull },
+			{ "M", 1ull << 20 },
+			{ "MiB", 1ull << 20 },
+			{ "MB", 1000000ull },
+			{ "G", 1ull << 30 },
+			{ "GiB", 1ull << 30 },
+			{ "GB", 1000000000ull },
+			{ "T", 1ull << 40 },
+			{ "TiB", 1ull << 40 },
+			{ "TB", 1000000000000ull }
+		};
+
+		for( const auto & unit : c_units )
+		{
+			if( details::isEqual( suffix, ascii.end(), unit.m_suffix ) )
+			{
+				if( count > std::numeric_limits< std::uint64_t >::max() /
+					unit.m_factor )
+						return false;
+
+				result = ByteSize( count * unit.m_factor );
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+}; // struct ValueConverter< ByteSize >
+
+//! Conversion to string.
+template<>
+struct ValueConverter< String >
+{
+	static bool convert( const StringView & value, String & result )
+	{
+		assignString( result, value );
+
+		return true;
+	}
+}; // struct ValueConverter< String >
+
+
+//
+// Span
+//
+
+//! View of the contiguous sequence of objects.
+template< typename T >
+class Span final {
+public:
+	typedef T element_type;
+	typedef typename std::remove_cv< T >::type value_type;
+	typedef std::size_t size_type;
+	typedef T * iterator;
+	typedef T * const_iterator;
+
+	Span()
+		:	m_data( nullptr )
+		,	m_size( 0 )
+	{
+	}
+
+	Span( T * data, size_type size )
+		:	m_data( data )
+		,	m_size( size )
+	{
+	}
+
+	//! \return Pointer to the first object.
+	T * data() const
+	{
+		return m_data;
+	}
+
+	//! \return Count of objects.
+	size_type size() const
+	{
+		return m_size;
+	}
+
+	//! \return Is span empty?
+	bool empty() const
+	{
+		return ( m_size == 0 );
+	}
+
+	iterator begin() const
+	{
+		return m_data;
+	}
+
+	iterator end() const
+	{
+		return m_data + m_size;
+	}
+
+	T & operator [] ( size_type i ) const
+	{
+		return m_data[ i ];
+	}
+
+	//! \return First object.
+	T & front() const
+	{
+		return m_data[ 0 ];
+	}
+
+	//! \return Last object.
+	T & back() const
+	{
+		return m_data[ m_size - 1 ];
+	}
+
+private:
+	//! Data.
+	T * m_data;
+	//! Size.
+	size_type m_size;
+}; // class Span
+
+
+//
+// ValueCache
+//
+
+/*!
+	Cache of the converted value of the argument. Holds one value
+	of any type, small values are stored in place.
+*/
+class ValueCache final {
+public:
+	ValueCache()
+		:	m_type( nullptr )
+		,	m_value( nullptr )
+		,	m_destroy( nullptr )
+	{
+	}
+
+	~ValueCache()
+	{
+		clear();
+	}
+
+	//! \return Cached value of the type \a T or nullptr.
+	template< typename T >
+	const T * get() const
+	{
+		if( m_type == typeTag< T > () )
+			return static_cast< const T* > ( m_value );
+		else
+			return nullptr;
+	}
+
+	//! Cache value. \return Cached value.
+	template< typename T >
+	const T & set( T value )
+	{
+		clear();
+
+		m_value = construct( std::move( value ),
+			std::integral_constant< bool, sizeof( T ) <= sizeof( Buffer ) &&
+				alignof( T ) <= alignof( Buffer ) &&
+				std::is_nothrow_move_constructible< T >::value > () );
+		m_type = typeTag< T > ();
+		m_destroy = &destroy< T >;
+
+		return *static_cast< const T* > ( m_value );
+	}
+
+	//! Clear cache.
+	void clear()
+	{
+		if( m_destroy )
+			m_destroy( m_value, m_value == &m_buffer );
+
+		m_type = nullptr;
+		m_value = nullptr;
+		m_destroy = nullptr;
+	}
+
+private:
+	DISABLE_COPY( ValueCache )
+
+	//! \return Unique tag of the type.
+	template< typename T >
+	static const void * typeTag()
+	{
+		static const char tag = 0;
+
+		return &tag;
+	}
+
+	//! Construct value in place.
+	template< typename T >
+	void * construct( T && value, std::true_type )
+	{
+		return new( &m_buffer ) T( std::move( value ) );
+	}
+
+	//! Construct value on the heap.
+	template< typename T >
+	void * construct( T && value, std::false_type )
+	{
+		return new T( std::move( value ) );
+	}
+
+	//! Destroy value.
+	template< typename T >
+	static void destroy( void * value, bool inPlace )
+	{
+		if( inPlace )
+			static_cast< T* > ( value )->~T();
+		else
+			delete static_cast< T* > ( value );
+	}
+
+	//! Buffer for the small values.
+	typedef std::aligned_storage< 16,
+		alignof( std::max_align_t ) >::type Buffer;
+
+	//! Type of the cached value.
+	const void * m_type;
+	//! Cached value.
+	void * m_value;
+	//! Destroyer of the value.
+	void ( * m_destroy )( void *, bool );
+	//! Buffer for the small values.
+	Buffer m_buffer;
+}; // class ValueCache
+
+} /* namespace Args */
+
+#endif // ARGS__TYPED_VALUE_HPP__INCLUDED
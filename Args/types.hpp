@@ -37,12 +37,17 @@
 #include <string>
 #include <list>
 #include <iostream>
+#include <functional>
 
 #elif defined( ARGS_QSTRING_BUILD )
 
 // Qt include.
 #include <QString>
 #include <QTextStream>
+#include <QHash>
+
+// C++ include.
+#include <list>
 
 #else
 
@@ -50,9 +55,14 @@
 #include <string>
 #include <list>
 #include <iostream>
+#include <functional>
 
 #endif
 
+// C++ include.
+#include <cstddef>
+#include <algorithm>
+
 
 namespace Args {
 
@@ -67,6 +77,9 @@ using Char = String::value_type;
 //! List of strings.
 using StringList = std::list< String >;
 
+//! Hash of the string.
+using StringHash = std::hash< String >;
+
 //! Out stream type.
 using OutStreamType = std::wostream;
 
@@ -192,6 +205,11 @@ public:
 		return m_str.length();
 	}
 
+	const Char * data() const
+	{
+		return m_str.constData();
+	}
+
 	String substr( size_type pos, size_type count = npos ) const
 	{
 		return m_str.mid( pos, count );
@@ -202,6 +220,11 @@ public:
 		return ( s1.m_str == s2.m_str );
 	}
 
+	friend bool operator != ( const String & s1, const String & s2 )
+	{
+		return ( s1.m_str != s2.m_str );
+	}
+
 	friend String operator + ( const String & s1, const String & s2 )
 	{
 		return String( s1.m_str + s2.m_str );
@@ -267,6 +290,14 @@ private:
 //! List of strings.
 using StringList = std::list< String >;
 
+//! Hash of the string.
+struct StringHash {
+	std::size_t operator () ( const String & s ) const
+	{
+		return qHash( QString( s ) );
+	}
+}; // struct StringHash
+
 //! Output stream.
 static OutStreamType & outStream()
 {
@@ -288,6 +319,9 @@ using Char = String::value_type;
 //! List of strings.
 using StringList = std::list< String >;
 
+//! Hash of the string.
+using StringHash = std::hash< String >;
+
 //! Out stream type.
 using OutStreamType = std::ostream;
 
@@ -301,6 +335,187 @@ static OutStreamType & outStream()
 
 #endif
 
+
+//
+// StringView
+//
+
+/*!
+	Non-owning view of the sequence of characters.
+
+	View doesn't hold the data, so the data must outlive the view.
+*/
+class StringView final {
+public:
+	using size_type = std::size_t;
+
+	static const size_type npos = static_cast< size_type > ( -1 );
+
+	StringView()
+		:	m_data( nullptr )
+		,	m_size( 0 )
+	{
+	}
+
+	StringView( const Char * data, size_type size )
+		:	m_data( data )
+		,	m_size( size )
+	{
+	}
+
+	//! Null-terminated string.
+	explicit StringView( const Char * str )
+		:	m_data( str )
+		,	m_size( 0 )
+	{
+		if( str )
+			while( !( str[ m_size ] == Char() ) )
+				++m_size;
+	}
+
+	StringView( const String & str )
+		:	m_data( str.data() )
+		,	m_size( static_cast< size_type > ( str.length() ) )
+	{
+	}
+
+	//! \return Pointer to the first character.
+	const Char * data() const
+	{
+		return m_data;
+	}
+
+	//! \return Count of characters.
+	size_type size() const
+	{
+		return m_size;
+	}
+
+	//! \return Is view empty?
+	bool empty() const
+	{
+		return ( m_size == 0 );
+	}
+
+	const Char * begin() const
+	{
+		return m_data;
+	}
+
+	const Char * end() const
+	{
+		return m_data + m_size;
+	}
+
+	const Char & operator [] ( size_type pos ) const
+	{
+		return m_data[ pos ];
+	}
+
+	//! \return Position of the character or npos.
+	size_type find( Char ch, size_type pos = 0 ) const
+	{
+		if( pos >= m_size )
+			return npos;
+
+#ifdef ARGS_QSTRING_BUILD
+		for( ; pos < m_size; ++pos )
+			if( m_data[ pos ] == ch )
+				return pos;
+
+		return npos;
+#else
+		// memchr()/wmemchr() are vectorized by the C library.
+		const Char * found = std::char_traits< Char >::find( m_data + pos,
+			m_size - pos, ch );
+
+		return ( found ? static_cast< size_type > ( found - m_data ) : npos );
+#endif
+	}
+
+	//! \return Sub-view.
+	StringView substr( size_type pos, size_type count = npos ) const
+	{
+		if( pos > m_size )
+			pos = m_size;
+
+		return StringView( m_data + pos, std::min( count, m_size - pos ) );
+	}
+
+	//! \return Owning copy of the view.
+	String toString() const
+	{
+		if( empty() )
+			return String();
+		else
+			return String( m_data, static_cast< String::size_type > ( m_size ) );
+	}
+
+	friend bool operator == ( const StringView & v1, const StringView & v2 )
+	{
+		return ( v1.m_size == v2.m_size &&
+			std::equal( v1.begin(), v1.end(), v2.begin() ) );
+	}
+
+	friend bool operator == ( const StringView & v, const String & s )
+	{
+		return ( v == StringView( s ) );
+	}
+
+	friend bool operator != ( const StringView & v1, const StringView & v2 )
+	{
+		return !( v1 == v2 );
+	}
+
+	friend bool operator != ( const StringView & v, const String & s )
+	{
+		return !( v == s );
+	}
+
+private:
+	//! Data.
+	const Char * m_data;
+	//! Size.
+	size_type m_size;
+}; // class StringView
+
+
+//! Assign view to the string, buffer of the string is reused if possible.
+inline void
+assignString( String & to, const StringView & from )
+{
+#ifdef ARGS_QSTRING_BUILD
+	to = from.toString();
+#else
+	to.assign( from.data(), from.size() );
+#endif
+}
+
+
+//
+// StringViewHash
+//
+
+//! Hash of the string view (FNV-1a).
+struct StringViewHash {
+	std::size_t operator () ( const StringView & v ) const
+	{
+		std::size_t h = 14695981039346656037ULL & static_cast< std::size_t > ( -1 );
+
+		for( const Char & ch : v )
+		{
+#ifdef ARGS_QSTRING_BUILD
+			h ^= static_cast< std::size_t > ( ch.unicode() );
+#else
+			h ^= static_cast< std::size_t > ( ch );
+#endif
+			h *= static_cast< std::size_t > ( 1099511628211ULL );
+		}
+
+		return h;
+	}
+}; // struct StringViewHash
+
 } /* namespace Args */
 
 #endif // ARGS__TYPES_HPP__INCLUDED
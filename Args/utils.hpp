@@ -31,21 +31,16 @@
 #ifndef ARGS__UTILS_HPP__INCLUDED
 #define ARGS__UTILS_HPP__INCLUDED
 
-#ifndef ARGS_QSTRING_BUILD
-
-// C++ include.
-#include <regex>
-
-#else
-
-// Qt include.
-#include <QRegExp>
-
-#endif
-
 // Args include.
 #include "types.hpp"
 
+// C++ include.
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 
 namespace Args {
 
@@ -73,14 +68,17 @@ namespace Args {
 
 //! \return Is word an argument?
 static inline bool
-isArgument( const String & word )
+isArgument( const StringView & word )
 {
-	const String::size_type it = word.find( SL( "--" ) );
+	return ( word.size() >= 2 && word[ 0 ] == SL( '-' ) &&
+		word[ 1 ] == SL( '-' ) );
+} // isArgument
 
-	if( it == 0 )
-		return true;
-	else
-		return false;
+//! \return Is word an argument?
+static inline bool
+isArgument( const String & word )
+{
+	return isArgument( StringView( word ) );
 } // isArgument
 
 
@@ -90,17 +88,16 @@ isArgument( const String & word )
 
 //! \return Is word a flag?
 static inline bool
-isFlag( const String & word )
+isFlag( const StringView & word )
 {
-	if( !isArgument( word ) )
-	{
-		const String::size_type it = word.find( SL( '-' ) );
-
-		if( it == 0 )
-			return true;
-	}
+	return ( !word.empty() && word[ 0 ] == SL( '-' ) && !isArgument( word ) );
+} // isFlag
 
-	return false;
+//! \return Is word a flag?
+static inline bool
+isFlag( const String & word )
+{
+	return isFlag( StringView( word ) );
 } // isFlag
 
 
@@ -137,23 +134,7 @@ isCorrectName( const String & name )
 	if( name.empty() )
 		return false;
 
-#ifndef ARGS_QSTRING_BUILD
-
-#ifdef ARGS_WSTRING_BUILD
-	std::wregex r( L"\\s" );
-#else
-	std::regex r( "\\s" );
-#endif
-
-	if( std::regex_search( name, r ) )
-		return false;
-#else
-	QRegExp r( "\\s" );
-
-	if( r.indexIn( name ) != -1 )
-		return false;
-#endif
-
+	// Whitespaces are not in the available symbols.
 	static const String availableSymbols( SL( "0123456789"
 		"abcdefghijklmnopqrstuvwxyz"
 		"ABCDEFGHIJKLMNOPQRSTUVWXYZ-_" ) );
@@ -167,6 +148,244 @@ isCorrectName( const String & name )
 	return true;
 } // isCorrectName
 
+
+
+//
+// FunctionRef
+//
+
+template< typename Signature >
+class FunctionRef;
+
+/*!
+	Non-owning reference to the callable object. It's lighter than
+	std::function: no allocation and no copy of the callable.
+
+	Only lvalues can be referenced, so callable should outlive
+	the reference.
+*/
+template< typename R, typename... Params >
+class FunctionRef< R ( Params... ) > final {
+public:
+	FunctionRef()
+		:	m_call( nullptr )
+	{
+		m_callable.m_object = nullptr;
+	}
+
+	//! Reference callable object.
+	template< typename F, typename = typename std::enable_if<
+		!std::is_same< typename std::remove_cv< F >::type,
+			FunctionRef >::value &&
+		!std::is_function< F >::value >::type >
+	FunctionRef( F & f )
+		:	m_call( &callObject< F > )
+	{
+		m_callable.m_object = const_cast< void* > (
+			static_cast< const void* > ( std::addressof( f ) ) );
+	}
+
+	//! Reference function.
+	FunctionRef( R ( * f )( Params... ) )
+		:	m_call( f ? &callFunction : nullptr )
+	{
+		m_callable.m_function = f;
+	}
+
+	//! \return Is there referenced callable?
+	explicit operator bool () const
+	{
+		return ( m_call != nullptr );
+	}
+
+	//! Call referenced callable.
+	R operator () ( Params... args ) const
+	{
+		return m_call( m_callable, std::forward< Params > ( args )... );
+	}
+
+private:
+	//! Referenced callable.
+	union Callable {
+		//! Callable object.
+		void * m_object;
+		//! Function.
+		R ( * m_function )( Params... );
+	}; // union Callable
+
+	//! Call object.
+	template< typename F >
+	static R callObject( const Callable & c, Params... args )
+	{
+		return ( *static_cast< F* > ( c.m_object ) )(
+			std::forward< Params > ( args )... );
+	}
+
+	//! Call function.
+	static R callFunction( const Callable & c, Params... args )
+	{
+		return c.m_function( std::forward< Params > ( args )... );
+	}
+
+	//! Referenced callable.
+	Callable m_callable;
+	//! Caller.
+	R ( * m_call )( const Callable &, Params... );
+}; // class FunctionRef
+
+
+//
+// ValueHandler
+//
+
+//! Handler that is invoked for each value of the argument while parsing.
+using ValueHandler = FunctionRef< void ( const StringView & ) >;
+
+
+namespace details {
+
+#ifdef ARGS_WSTRING_BUILD
+
+//! \return Wide string from UTF-8.
+inline String
+fromUtf8( const char * data, std::size_t size )
+{
+	String result;
+	result.reserve( size );
+
+	for( std::size_t i = 0; i < size; )
+	{
+		const unsigned char c = static_cast< unsigned char > ( data[ i ] );
+		std::size_t length = 1;
+		unsigned long code = c;
+
+		if( c >= 0xF0 && c < 0xF8 )
+		{
+			length = 4;
+			code = c & 0x07;
+		}
+		else if( c >= 0xE0 )
+		{
+			length = ( c < 0xF0 ? 3 : 1 );
+			code = ( c < 0xF0 ? c & 0x0F : 0xFFFD );
+		}
+		else if( c >= 0xC0 )
+		{
+			length = 2;
+			code = c & 0x1F;
+		}
+		else if( c >= 0x80 )
+			code = 0xFFFD;
+
+		if( i + length > size )
+		{
+			length = size - i;
+			code = 0xFFFD;
+		}
+		else
+		{
+			for( std::size_t j = 1; j < length; ++j )
+				code = ( code << 6 ) | ( static_cast< unsigned char > (
+					data[ i + j ] ) & 0x3F );
+		}
+
+		if( sizeof( wchar_t ) == 2 && code > 0xFFFF )
+		{
+			code -= 0x10000;
+			result.push_back( static_cast< wchar_t > ( 0xD800 + ( code >> 10 ) ) );
+			result.push_back( static_cast< wchar_t > ( 0xDC00 + ( code & 0x3FF ) ) );
+		}
+		else
+			result.push_back( static_cast< wchar_t > ( code ) );
+
+		i += length;
+	}
+
+	return result;
+}
+
+//! \return UTF-8 string from the wide one.
+inline std::string
+toUtf8( const StringView & s )
+{
+	std::string result;
+	result.reserve( s.size() );
+
+	for( std::size_t i = 0; i < s.size(); ++i )
+	{
+		unsigned long code = static_cast< unsigned long > ( s[ i ] );
+
+		if( sizeof( wchar_t ) == 2 && code >= 0xD800 && code < 0xDC00 &&
+			i + 1 < s.size() )
+		{
+			code = 0x10000 + ( ( code - 0xD800 ) << 10 ) +
+				( static_cast< unsigned long > ( s[ ++i ] ) - 0xDC00 );
+		}
+
+		if( code < 0x80 )
+			result.push_back( static_cast< char > ( code ) );
+		else if( code < 0x800 )
+		{
+			result.push_back( static_cast< char > ( 0xC0 | ( code >> 6 ) ) );
+			result.push_back( static_cast< char > ( 0x80 | ( code & 0x3F ) ) );
+		}
+		else if( code < 0x10000 )
+		{
+			result.push_back( static_cast< char > ( 0xE0 | ( code >> 12 ) ) );
+			result.push_back( static_cast< char > ( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+			result.push_back( static_cast< char > ( 0x80 | ( code & 0x3F ) ) );
+		}
+		else
+		{
+			result.push_back( static_cast< char > ( 0xF0 | ( code >> 18 ) ) );
+			result.push_back( static_cast< char > ( 0x80 | ( ( code >> 12 ) & 0x3F ) ) );
+			result.push_back( static_cast< char > ( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+			result.push_back( static_cast< char > ( 0x80 | ( code & 0x3F ) ) );
+		}
+	}
+
+	return result;
+}
+
+#elif defined( ARGS_QSTRING_BUILD )
+
+//! \return String from UTF-8.
+inline String
+fromUtf8( const char * data, std::size_t size )
+{
+	return QString::fromUtf8( data, static_cast< int > ( size ) );
+}
+
+//! \return UTF-8 string.
+inline std::string
+toUtf8( const StringView & s )
+{
+	const QByteArray utf8 = QString( s.toString() ).toUtf8();
+
+	return std::string( utf8.constData(),
+		static_cast< std::size_t > ( utf8.size() ) );
+}
+
+#else
+
+//! \return String from UTF-8.
+inline String
+fromUtf8( const char * data, std::size_t size )
+{
+	return String( data, size );
+}
+
+//! \return UTF-8 string.
+inline std::string
+toUtf8( const StringView & s )
+{
+	return std::string( s.data(), s.size() );
+}
+
+#endif
+
+} /* namespace details */
+
 } /* namespace Args */
 
 #endif // ARGS__UTILS_HPP__INCLUDED
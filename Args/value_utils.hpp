@@ -33,23 +33,190 @@
 
 // Args include.
 #include "utils.hpp"
+#include "enums.hpp"
 #include "exceptions.hpp"
+#include "parse_stats.hpp"
 #include "types.hpp"
 
 // C++ include.
-#include <algorithm>
+#include <vector>
 
 
 namespace Args {
 
 //
-// eatValues
+// isValue
 //
 
-//! Eat values in context.
-template< typename Container, typename Cmd, typename Ctx >
-bool eatValues( Ctx & context, Container & container,
-	const String & errorDescription, Cmd * cmdLine )
+/*!
+	\return Is item of the context a value? Uses classification
+	of the item, so the word is not scanned again.
+*/
+template< typename Cmd, typename Ctx, typename Iterator >
+bool isValue( const Ctx & context, Iterator it, Cmd * cmdLine )
+{
+	switch( context.token( it ).kind() )
+	{
+		case TokenKind::Value :
+		case TokenKind::Operand :
+			return true;
+
+		case TokenKind::Word :
+			return ( cmdLine->tryFindArgument( *it ) == nullptr );
+
+		default :
+			return false;
+	}
+}
+
+
+//
+// appendValue
+//
+
+/*!
+	Append value to the container. Element of the spare container is
+	reused if there is one, so no allocation happens for the value
+	that fits in the buffer of the reused element.
+*/
+template< typename Container >
+void appendValue( Container & container, Container & spare,
+	const StringView & value )
+{
+	ARGS_PARSE_STATS( details::addCopiedBytes( value ); )
+
+	if( spare.empty() )
+		container.push_back( value.toString() );
+	else
+	{
+		container.splice( container.end(), spare, spare.begin() );
+
+		assignString( container.back(), value );
+	}
+}
+
+
+//
+// LazyValues
+//
+
+/*!
+	Values of the argument. Values are kept as views into the context
+	while parsing and are copied to the strings only on the first
+	access, so values that nobody reads cost nothing. Views are
+	kept only into the source of the command line (argv or container),
+	it should outlive the access to the values. Words stored in the
+	context are copied immediately with pushCopy().
+
+	First call of const values() modifies the object, so it isn't
+	thread-safe: concurrent readers of the same argument should be
+	synchronized or values should be read once before sharing it.
+*/
+class LazyValues final {
+public:
+	LazyValues()
+	{
+	}
+
+	//! Add value, it will be copied on the first access.
+	void push( const StringView & value )
+	{
+		m_views.push_back( value );
+	}
+
+	//! Add value that is valid only now, it's copied immediately.
+	void pushCopy( const StringView & value )
+	{
+		materialize();
+
+		appendValue( m_values, m_spare, value );
+	}
+
+	//! \return Values.
+	const StringList & values() const
+	{
+		materialize();
+
+		return m_values;
+	}
+
+	//! \return Is there no values?
+	bool empty() const
+	{
+		return ( m_views.empty() && m_values.empty() );
+	}
+
+	//! Clear values, buffers are kept for the reuse.
+	void clear()
+	{
+		m_views.clear();
+		m_spare.splice( m_spare.end(), m_values );
+	}
+
+private:
+	DISABLE_COPY( LazyValues )
+
+	//! Copy views to the strings.
+	void materialize() const
+	{
+		for( const auto & view : m_views )
+			appendValue( m_values, m_spare, view );
+
+		m_views.clear();
+	}
+
+	//! Copied values.
+	mutable StringList m_values;
+	//! Cleared values that can be reused.
+	mutable StringList m_spare;
+	//! Values that are not copied yet.
+	mutable std::vector< StringView > m_views;
+}; // class LazyValues
+
+
+//
+// takeValue
+//
+
+/*!
+	Pass value to the \a handler and add it to the values
+	if there is no handler or values should be stored anyway.
+	Transient value is copied immediately.
+*/
+inline void takeValue( const StringView & value, bool isTransient,
+	const ValueHandler & handler, bool storeValues, LazyValues & values )
+{
+	if( handler )
+		handler( value );
+
+	if( !handler || storeValues )
+	{
+		if( isTransient )
+			values.pushCopy( value );
+		else
+			values.push( value );
+	}
+}
+
+
+//
+// consumeValues
+//
+
+/*!
+	Eat values in context and pass each of them to the \a consume
+	function, that returns false if value is incorrect. Incorrect
+	value is left in the context as the next item. End of options
+	"--" is skipped, all the words after it are values.
+
+	\retval ParseError::None if at least one value was eaten.
+	\retval ParseError::ValueRequired if there are no values.
+	\retval ParseError::InvalidValue if value is incorrect.
+
+	\throw BaseException if argument is not under command line parser.
+*/
+template< typename Cmd, typename Ctx, typename Consumer >
+ParseError consumeValues( Ctx & context, Cmd * cmdLine, Consumer && consume )
 {
 	if( !cmdLine )
 		throw BaseException( SL( "Argument is not under command line parser." ) );
@@ -57,34 +224,36 @@ bool eatValues( Ctx & context, Container & container,
 	if( !context.atEnd() )
 	{
 		auto begin = context.begin();
+		auto last = begin;
+		bool hasValues = false;
 
-		auto last = std::find_if( context.begin(), context.end(),
-			[ & ] ( const String & v ) -> bool
-			{
-				if( isArgument( v ) || isFlag( v ) )
-					return true;
-				else
-				{
-					try {
-						cmdLine->findArgument( v );
+		for( ; last != context.end(); ++last )
+		{
+			if( context.token( last ).kind() == TokenKind::EndOfOptions )
+				continue;
+			else if( !isValue( context, last, cmdLine ) )
+				break;
 
-						return true;
-					}
-					catch( const BaseException & )
-					{
-						return false;
-					}
-				}
-			}
-		);
+			hasValues = true;
+		}
 
-		if( last != begin )
+		if( hasValues )
 		{
 			begin = context.next();
 
 			while( begin != last )
 			{
-				container.push_back( *begin );
+				if( context.token( begin ).kind() != TokenKind::EndOfOptions )
+				{
+					ARGS_PARSE_STATS( details::addParseStat( &ParseStats::m_tokens ); )
+
+					if( !consume( *begin ) )
+					{
+						context.putBack();
+
+						return ParseError::InvalidValue;
+					}
+				}
 
 				begin = context.next();
 			}
@@ -92,13 +261,34 @@ bool eatValues( Ctx & context, Container & container,
 			if( last != context.end() )
 				context.putBack();
 
-			return true;
+			return ParseError::None;
 		}
-		else
-			throw BaseException( errorDescription );
 	}
-	else
-		throw BaseException( errorDescription );
+
+	return ParseError::ValueRequired;
+}
+
+
+//
+// eatValues
+//
+
+/*!
+	Eat values in context.
+
+	\return Was at least one value eaten?
+*/
+template< typename Container, typename Cmd, typename Ctx >
+bool eatValues( Ctx & context, Container & container, Container & spare,
+	Cmd * cmdLine )
+{
+	return ( consumeValues( context, cmdLine,
+		[ &container, &spare ] ( const StringView & value ) -> bool
+		{
+			appendValue( container, spare, value );
+
+			return true;
+		} ) == ParseError::None );
 }
 
 
@@ -106,9 +296,15 @@ bool eatValues( Ctx & context, Container & container,
 // eatOneValue
 //
 
-//! Eat one value.
+/*!
+	Eat one value. End of options "--" before the value is skipped.
+
+	\return Was value eaten?
+
+	\throw BaseException if argument is not under command line parser.
+*/
 template< typename Cmd, typename Ctx >
-String eatOneValue( Ctx & context, Cmd * cmdLine )
+bool eatOneValue( Ctx & context, Cmd * cmdLine, StringView & value )
 {
 	if( !cmdLine )
 		throw BaseException( SL( "Argument is not under command line parser." ) );
@@ -116,24 +312,48 @@ String eatOneValue( Ctx & context, Cmd * cmdLine )
 	if( !context.atEnd() )
 	{
 		auto val = context.next();
+		const bool skipped = ( !context.atEnd() &&
+			context.token( val ).kind() == TokenKind::EndOfOptions );
 
-		if( !isArgument( *val ) && !isFlag( *val ) )
+		if( skipped )
+			val = context.next();
+
+		if( isValue( context, val, cmdLine ) )
 		{
-			try {
-				cmdLine->findArgument( *val );
-			}
-			catch( const BaseException & )
-			{
-				return *val;
-			}
+			ARGS_PARSE_STATS( details::addParseStat( &ParseStats::m_tokens ); )
+
+			value = *val;
+
+			return true;
 		}
 
 		context.putBack();
 
-		throw BaseException( SL( "Can't eat value." ) );
+		if( skipped )
+			context.putBack();
 	}
-	else
-		throw BaseException( SL( "Can't eat value." ) );
+
+	return false;
+}
+
+/*!
+	Eat one value.
+
+	\return Was value eaten?
+*/
+template< typename Cmd, typename Ctx >
+bool eatOneValue( Ctx & context, Cmd * cmdLine, String & value )
+{
+	StringView view;
+
+	if( eatOneValue( context, cmdLine, view ) )
+	{
+		assignString( value, view );
+
+		return true;
+	}
+
+	return false;
 }
 
 } /* namespace Args */
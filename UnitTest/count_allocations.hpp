@@ -0,0 +1,152 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef UNITTEST__COUNT_ALLOCATIONS_HPP__INCLUDED
+#define UNITTEST__COUNT_ALLOCATIONS_HPP__INCLUDED
+
+// C++ include.
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+
+/*
+	Counting of allocations with operator new for tests and benchmarks.
+
+	Global operators new and delete are replaced in this file, so it
+	should be included only in one translation unit.
+*/
+
+
+//
+// allocationsCount
+//
+
+/*!
+	\return Count of allocations with operator new since the start
+	of the program.
+*/
+inline std::atomic< std::size_t > & allocationsCount()
+{
+	static std::atomic< std::size_t > count( 0 );
+
+	return count;
+}
+
+
+//
+// allocatedBytes
+//
+
+/*!
+	\return Count of bytes allocated with operator new since the start
+	of the program.
+*/
+inline std::atomic< std::size_t > & allocatedBytes()
+{
+	static std::atomic< std::size_t > bytes( 0 );
+
+	return bytes;
+}
+
+
+//
+// Replaced operators new and delete
+//
+
+// GCC warns about mismatched new and delete when it sees malloc() and
+// free() of the replaced operators, so they shouldn't be inlined.
+#if defined( __GNUC__ ) && !defined( __clang__ )
+	#define UNIT_TEST_ALLOCATIONS_NOINLINE __attribute__(( noinline ))
+#else
+	#define UNIT_TEST_ALLOCATIONS_NOINLINE
+#endif
+
+UNIT_TEST_ALLOCATIONS_NOINLINE
+void * operator new( std::size_t size )
+{
+	++allocationsCount();
+	allocatedBytes() += size;
+
+	void * p = std::malloc( size ? size : 1 );
+
+	if( !p )
+		throw std::bad_alloc();
+
+	return p;
+}
+
+UNIT_TEST_ALLOCATIONS_NOINLINE
+void * operator new[]( std::size_t size )
+{
+	return operator new( size );
+}
+
+UNIT_TEST_ALLOCATIONS_NOINLINE
+void * operator new( std::size_t size, const std::nothrow_t & ) noexcept
+{
+	++allocationsCount();
+	allocatedBytes() += size;
+
+	return std::malloc( size ? size : 1 );
+}
+
+UNIT_TEST_ALLOCATIONS_NOINLINE
+void * operator new[]( std::size_t size, const std::nothrow_t & tag ) noexcept
+{
+	return operator new( size, tag );
+}
+
+UNIT_TEST_ALLOCATIONS_NOINLINE
+void operator delete( void * p ) noexcept
+{
+	std::free( p );
+}
+
+UNIT_TEST_ALLOCATIONS_NOINLINE
+void operator delete[]( void * p ) noexcept
+{
+	std::free( p );
+}
+
+UNIT_TEST_ALLOCATIONS_NOINLINE
+void operator delete( void * p, std::size_t ) noexcept
+{
+	std::free( p );
+}
+
+UNIT_TEST_ALLOCATIONS_NOINLINE
+void operator delete[]( void * p, std::size_t ) noexcept
+{
+	std::free( p );
+}
+
+#endif // UNITTEST__COUNT_ALLOCATIONS_HPP__INCLUDED
@@ -41,6 +41,24 @@
 #include <exception>
 #include <iostream>
 
+/*
+	Allocations are counted only if UNIT_TEST_COUNT_ALLOCATIONS is
+	defined before including this file, global operators new and delete
+	are replaced then, so it should be done only in one translation unit.
+*/
+#ifdef UNIT_TEST_COUNT_ALLOCATIONS
+	#include "count_allocations.hpp"
+#endif
+
+// Name of the exception's type is available only with RTTI.
+#if defined( __GXX_RTTI ) || defined( _CPPRTTI ) || defined( __cpp_rtti )
+	#include <typeinfo>
+
+	#define UNIT_TEST_TYPE_NAME( x ) typeid( x ).name()
+#else
+	#define UNIT_TEST_TYPE_NAME( x ) "std::exception"
+#endif
+
 
 //
 // Test
@@ -214,7 +232,7 @@ void TestName##Class::testBody()
 		stream << "     file: \"" << __FILE__ \
 			<< "\" line: " << __LINE__ << "\n" \
 			<< "     expected exception: " << #Exception << "\n" \
-			<< "     but caught: " << typeid( x ).name() << " [FAILED]"; \
+			<< "     but caught: " << UNIT_TEST_TYPE_NAME( x ) << " [FAILED]"; \
  \
 		throw std::runtime_error( stream.str() ); \
 	} \
@@ -239,6 +257,37 @@ void TestName##Class::testBody()
 }
 
 
+#ifdef UNIT_TEST_COUNT_ALLOCATIONS
+
+//
+// CHECK_ALLOCATIONS_AT_MOST
+//
+
+//! Check that \a Code allocates at most \a Count times.
+#define CHECK_ALLOCATIONS_AT_MOST( Count, Code ) \
+{ \
+	const std::size_t allocations_before__ = allocationsCount(); \
+ \
+	Code; \
+ \
+	const std::size_t allocations__ = allocationsCount() - allocations_before__; \
+ \
+	if( allocations__ > static_cast< std::size_t > ( Count ) ) \
+	{ \
+		std::ostringstream stream; \
+		stream << "     file: \"" << __FILE__ \
+			<< "\" line: " << __LINE__ << "\n" \
+			<< "     ( " << #Code << " ) allocated " << allocations__ \
+			<< " times, expected at most " << ( Count ) << " [FAILED]"; \
+ \
+		throw std::runtime_error( stream.str() ); \
+	} \
+}
+
+
+#endif // UNIT_TEST_COUNT_ALLOCATIONS
+
+
 //
 // Test
 //
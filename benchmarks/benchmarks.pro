@@ -0,0 +1,12 @@
+
+TEMPLATE = app
+TARGET = bench.args
+CONFIG += console c++14
+QT -= core gui
+
+include( ../Args/Args.pri )
+include( ../config.pri )
+
+INCLUDEPATH = ..
+
+SOURCES = main.cpp
@@ -0,0 +1,637 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// Args include.
+#include <Args/all.hpp>
+
+// UnitTest include.
+#include <UnitTest/count_allocations.hpp>
+
+// C++ include.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef ARGS_QSTRING_BUILD
+	#include <QTextStream>
+#endif
+
+
+namespace Bench {
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = Args::String::value_type;
+	static const char * const c_backend = "wstring";
+#elif defined( ARGS_QSTRING_BUILD )
+	using CHAR = char;
+	static const char * const c_backend = "qstring";
+#else
+	using CHAR = char;
+	static const char * const c_backend = "std";
+#endif
+
+//! Results of the operations, so they aren't optimized out.
+static std::size_t g_sink = 0;
+
+
+//
+// Options
+//
+
+//! Options of the benchmarks.
+struct Options {
+	Options()
+		:	m_minTime( 0.2 )
+		,	m_iterations( 0 )
+	{
+	}
+
+	//! \return Should benchmark with the given name be run?
+	bool isSelected( const std::string & name ) const
+	{
+		return ( m_filter.empty() || name.find( m_filter ) != std::string::npos );
+	}
+
+	//! Only benchmarks which names contain this string are run.
+	std::string m_filter;
+	//! Minimal time of the measurement in seconds.
+	double m_minTime;
+	//! Fixed count of iterations, 0 means calibration by time.
+	std::size_t m_iterations;
+}; // struct Options
+
+
+//
+// CommandLine
+//
+
+//! Command line for the parsing.
+class CommandLine final {
+public:
+	CommandLine()
+	{
+		add( "bench" );
+	}
+
+	//! Add word.
+	void add( const std::string & word )
+	{
+		m_words.push_back( std::basic_string< CHAR > ( word.begin(), word.end() ) );
+		m_argv.clear();
+	}
+
+	//! \return Count of words.
+	int argc() const
+	{
+		return static_cast< int > ( m_words.size() );
+	}
+
+	//! \return Words.
+	const CHAR * const * argv()
+	{
+		if( m_argv.empty() )
+		{
+			m_argv.reserve( m_words.size() );
+
+			for( const auto & w : m_words )
+				m_argv.push_back( w.c_str() );
+		}
+
+		return m_argv.data();
+	}
+
+private:
+	//! Words.
+	std::vector< std::basic_string< CHAR > > m_words;
+	//! Pointers to the words.
+	std::vector< const CHAR* > m_argv;
+}; // class CommandLine
+
+
+//! \return String from the ASCII string.
+inline Args::String string( const std::string & s )
+{
+#ifdef ARGS_QSTRING_BUILD
+	return Args::String( s.c_str() );
+#else
+	return Args::String( s.begin(), s.end() );
+#endif
+}
+
+
+//
+// run
+//
+
+/*!
+	Run operation till minimal time is reached and print result as
+	JSON line: nanoseconds, allocations and allocated bytes per operation.
+
+	Operation returns false on error, it's checked once before measurement.
+*/
+template< typename Operation >
+void run( const Options & opts, const std::string & name, Operation && op )
+{
+	if( !opts.isSelected( name ) )
+		return;
+
+	if( !op() )
+	{
+		std::fprintf( stderr, "Benchmark \"%s\" failed.\n", name.c_str() );
+
+		std::exit( 1 );
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	std::size_t iterations = ( opts.m_iterations ? opts.m_iterations : 1 );
+
+	for( ; ; )
+	{
+		const std::size_t allocations = allocationsCount();
+		const std::size_t bytes = allocatedBytes();
+		const auto start = Clock::now();
+
+		for( std::size_t i = 0; i < iterations; ++i )
+			g_sink += static_cast< std::size_t > ( op() );
+
+		const double elapsed = std::chrono::duration< double > (
+			Clock::now() - start ).count();
+
+		if( opts.m_iterations || elapsed >= opts.m_minTime )
+		{
+			const double count = static_cast< double > ( iterations );
+
+			std::printf( "{\"name\":\"%s\",\"backend\":\"%s\",\"iterations\":%zu,"
+				"\"ns_per_op\":%.1f,\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f}\n",
+				name.c_str(), c_backend, iterations, elapsed * 1e9 / count,
+				static_cast< double > ( allocationsCount() - allocations ) / count,
+				static_cast< double > ( allocatedBytes() - bytes ) / count );
+			std::fflush( stdout );
+
+			return;
+		}
+
+		// Predict count of iterations with 20% reserve, but not too fast.
+		const double predicted = ( elapsed > 0.0 ?
+			opts.m_minTime * 1.2 * static_cast< double > ( iterations ) / elapsed :
+			static_cast< double > ( iterations ) * 100.0 );
+
+		iterations = std::max( iterations + 1, std::min( iterations * 100,
+			static_cast< std::size_t > ( predicted ) ) );
+	}
+}
+
+
+//
+// Help output
+//
+
+#ifdef ARGS_QSTRING_BUILD
+//! Output of the help.
+class HelpOutput final {
+public:
+	HelpOutput()
+		:	m_stream( &m_buffer )
+	{
+	}
+
+	//! \return Stream.
+	Args::OutStreamType & stream()
+	{
+		return m_stream;
+	}
+
+	//! Clear output. \return Size of the output.
+	std::size_t clear()
+	{
+		m_stream.flush();
+
+		const std::size_t size = static_cast< std::size_t > ( m_buffer.size() );
+		m_buffer.clear();
+
+		return size;
+	}
+
+private:
+	QString m_buffer;
+	QTextStream m_stream;
+}; // class HelpOutput
+#else
+//! Output of the help.
+class HelpOutput final {
+public:
+	//! \return Stream.
+	Args::OutStreamType & stream()
+	{
+		return m_stream;
+	}
+
+	//! Clear output. \return Size of the output.
+	std::size_t clear()
+	{
+		const std::size_t size = m_stream.str().size();
+		m_stream.str( {} );
+
+		return size;
+	}
+
+private:
+#ifdef ARGS_WSTRING_BUILD
+	std::wostringstream m_stream;
+#else
+	std::ostringstream m_stream;
+#endif
+}; // class HelpOutput
+#endif
+
+
+//
+// Scenarios
+//
+
+//! Parsing and lookup with many registered arguments.
+void benchArgs( const Options & opts, std::size_t count )
+{
+	const std::string suffix = "/args=" + std::to_string( count );
+
+	if( !opts.isSelected( "parse" + suffix ) && !opts.isSelected( "lookup" + suffix ) &&
+		!opts.isSelected( "suggest" + suffix ) )
+			return;
+
+	// Ten arguments from the whole range are used in the command line.
+	const std::size_t step = std::max< std::size_t > ( count / 10, 1 );
+
+	CommandLine line;
+	std::vector< Args::String > names;
+	std::vector< Args::String > typos;
+
+	for( std::size_t i = 0; i < count; i += step )
+	{
+		line.add( "--option-" + std::to_string( i ) );
+		line.add( "value-" + std::to_string( i ) );
+		names.push_back( string( "--option-" + std::to_string( i ) ) );
+		typos.push_back( string( "--opiton-" + std::to_string( i ) ) );
+	}
+
+	Args::CmdLine cmd( line.argc(), line.argv() );
+	std::vector< std::unique_ptr< Args::Arg > > args;
+	args.reserve( count );
+
+	for( std::size_t i = 0; i < count; ++i )
+	{
+		args.emplace_back( new Args::Arg(
+			string( "option-" + std::to_string( i ) ), true ) );
+		cmd.addArg( *args.back() );
+	}
+
+	cmd.seal();
+
+	Args::ParseStatus status;
+
+	run( opts, "parse" + suffix, [ & ] ()
+		{ return cmd.parse( line.argc(), line.argv(), status ); } );
+
+	run( opts, "lookup" + suffix, [ & ] ()
+		{
+			bool found = true;
+
+			for( const auto & name : names )
+				found = ( cmd.tryFindArgument( name ) != nullptr ) && found;
+
+			return found;
+		} );
+
+	run( opts, "suggest" + suffix, [ & ] ()
+		{
+			bool found = true;
+
+			for( const auto & typo : typos )
+				found = !cmd.suggestions( typo ).empty() && found;
+
+			return found;
+		} );
+}
+
+//! Suggestions among the names that differ only in a number.
+void benchSimilarNames( const Options & opts, std::size_t count )
+{
+	const std::string name = "suggest/similar/names=" + std::to_string( count );
+
+	if( !opts.isSelected( name ) )
+		return;
+
+	const std::size_t step = std::max< std::size_t > ( count / 10, 1 );
+
+	std::vector< Args::String > names;
+	std::vector< Args::String > typos;
+
+	for( std::size_t i = 0; i < count; i += step )
+	{
+		names.push_back( string( "--connection-timeout-" + std::to_string( i ) ) );
+		typos.push_back( string( "--conection-timeout-" + std::to_string( i ) ) );
+	}
+
+	CommandLine line;
+	Args::CmdLine cmd( line.argc(), line.argv() );
+	std::vector< std::unique_ptr< Args::Arg > > args;
+	args.reserve( count );
+
+	for( std::size_t i = 0; i < count; ++i )
+	{
+		args.emplace_back( new Args::Arg(
+			string( "connection-timeout-" + std::to_string( i ) ), true ) );
+		cmd.addArg( *args.back() );
+	}
+
+	cmd.seal();
+
+	run( opts, name, [ & ] ()
+		{
+			bool found = true;
+
+			for( std::size_t i = 0; i < typos.size(); ++i )
+			{
+				const auto similar = cmd.suggestions( typos[ i ] );
+
+				found = !similar.empty() && similar.front() == names[ i ] && found;
+			}
+
+			return found;
+		} );
+}
+
+//! Parsing of the long combos of flags.
+void benchFlags( const Options & opts )
+{
+	const std::string name = "flags/combo";
+
+	if( !opts.isSelected( name ) )
+		return;
+
+	const std::string combo = "-abcdefghijklmnopqrstuvwxyz";
+
+	CommandLine line;
+
+	for( int i = 0; i < 16; ++i )
+		line.add( combo );
+
+	Args::CmdLine cmd( line.argc(), line.argv() );
+	std::vector< std::unique_ptr< Args::MultiArg > > args;
+
+	for( std::size_t i = 1; i < combo.size(); ++i )
+	{
+		args.emplace_back( new Args::MultiArg(
+			Args::Char( static_cast< CHAR > ( combo[ i ] ) ) ) );
+		cmd.addArg( *args.back() );
+	}
+
+	cmd.seal();
+
+	Args::ParseStatus status;
+
+	run( opts, name, [ & ] ()
+		{ return cmd.parse( line.argc(), line.argv(), status ); } );
+}
+
+//! MultiArg with many values.
+void benchMultiArg( const Options & opts, std::size_t count )
+{
+	const std::string suffix = "/values=" + std::to_string( count );
+
+	if( !opts.isSelected( "multi_arg/parse" + suffix ) &&
+		!opts.isSelected( "multi_arg/values" + suffix ) )
+			return;
+
+	CommandLine line;
+	line.add( "--values" );
+
+	for( std::size_t i = 0; i < count; ++i )
+		line.add( "value-" + std::to_string( i ) );
+
+	Args::CmdLine cmd( line.argc(), line.argv() );
+	Args::MultiArg values( string( "values" ), true );
+	cmd.addArg( values );
+	cmd.seal();
+
+	Args::ParseStatus status;
+
+	// Values are not read, so they are not copied.
+	run( opts, "multi_arg/parse" + suffix, [ & ] ()
+		{ return cmd.parse( line.argc(), line.argv(), status ); } );
+
+	run( opts, "multi_arg/values" + suffix, [ & ] ()
+		{
+			return ( cmd.parse( line.argc(), line.argv(), status ) &&
+				values.values().size() == count );
+		} );
+}
+
+//! Commands with deep trees of groups.
+class CommandTree final {
+public:
+	CommandTree( std::size_t commands, std::size_t depth )
+	{
+		const std::string last = "cmd-" + std::to_string( commands - 1 );
+		const std::string option = "--" + last + "-arg-" + std::to_string( depth - 1 );
+
+		m_line.add( last );
+		m_line.add( option );
+		m_line.add( "value" );
+		m_line.add( "-v" );
+
+		m_cmd.reset( new Args::CmdLine( m_line.argc(), m_line.argv(),
+			Args::CmdLine::CommandIsRequired ) );
+
+		m_verbose.reset( new Args::Arg( Args::Char( SL( 'v' ) ),
+			string( "verbose" ) ) );
+		m_verbose->setDescription( SL( "Verbose output." ) );
+		m_cmd->addArg( *m_verbose );
+
+		for( std::size_t c = 0; c < commands; ++c )
+		{
+			const std::string name = "cmd-" + std::to_string( c );
+
+			m_commands.emplace_back( new Args::Command( string( name ) ) );
+			m_commands.back()->setDescription(
+				string( "Description of the command " + name + "." ) );
+
+			Args::GroupIface * parent = nullptr;
+
+			for( std::size_t d = 0; d < depth; ++d )
+			{
+				const std::string arg = name + "-arg-" + std::to_string( d );
+
+				m_groups.emplace_back( new Args::OnlyOneGroup(
+					string( name + "-group-" + std::to_string( d ) ) ) );
+				m_args.emplace_back( new Args::Arg( string( arg ), true ) );
+				m_args.back()->setDescription(
+					string( "Description of the argument " + arg +
+						", long enough to be split to the several lines of the help." ) );
+				m_groups.back()->addArg( *m_args.back() );
+
+				if( parent )
+					parent->addArg( *m_groups.back() );
+				else
+					m_commands.back()->addArg( *m_groups.back() );
+
+				parent = m_groups.back().get();
+			}
+
+			m_cmd->addArg( *m_commands.back() );
+		}
+
+		m_cmd->seal();
+	}
+
+	//! \return Command line parser.
+	Args::CmdLine & cmdLine()
+	{
+		return *m_cmd;
+	}
+
+	//! \return Command line.
+	CommandLine & line()
+	{
+		return m_line;
+	}
+
+private:
+	//! Command line.
+	CommandLine m_line;
+	//! Parser.
+	std::unique_ptr< Args::CmdLine > m_cmd;
+	//! Global argument.
+	std::unique_ptr< Args::Arg > m_verbose;
+	//! Commands.
+	std::vector< std::unique_ptr< Args::Command > > m_commands;
+	//! Groups.
+	std::vector< std::unique_ptr< Args::OnlyOneGroup > > m_groups;
+	//! Arguments.
+	std::vector< std::unique_ptr< Args::Arg > > m_args;
+}; // class CommandTree
+
+//! Parsing of the commands with deep trees of groups and help printing.
+void benchCommands( const Options & opts, std::size_t commands, std::size_t depth )
+{
+	const std::string suffix = "/commands=" + std::to_string( commands ) +
+		"/depth=" + std::to_string( depth );
+
+	if( !opts.isSelected( "commands/parse" + suffix ) &&
+		!opts.isSelected( "help/full" + suffix ) &&
+		!opts.isSelected( "help/command" + suffix ) )
+			return;
+
+	CommandTree tree( commands, depth );
+	Args::ParseStatus status;
+
+	run( opts, "commands/parse" + suffix, [ & ] ()
+		{
+			return tree.cmdLine().parse( tree.line().argc(), tree.line().argv(),
+				status );
+		} );
+
+	Args::HelpPrinter printer;
+	printer.setExecutable( SL( "bench" ) );
+	printer.setAppDescription( SL( "Benchmark of the help printing." ) );
+	printer.setCmdLine( &tree.cmdLine() );
+
+	HelpOutput output;
+
+	run( opts, "help/full" + suffix, [ & ] ()
+		{
+			printer.print( output.stream() );
+
+			return ( output.clear() > 0 );
+		} );
+
+	const Args::String command = string( "cmd-" + std::to_string( commands - 1 ) );
+
+	run( opts, "help/command" + suffix, [ & ] ()
+		{
+			printer.print( command, output.stream() );
+
+			return ( output.clear() > 0 );
+		} );
+}
+
+} /* namespace Bench */
+
+
+/*!
+	Usage: bench.args [--filter substring] [--min-time seconds]
+		[--iterations count]
+*/
+int main( int argc, char ** argv )
+{
+	Bench::Options opts;
+
+	for( int i = 1; i + 1 < argc; i += 2 )
+	{
+		if( std::strcmp( argv[ i ], "--filter" ) == 0 )
+			opts.m_filter = argv[ i + 1 ];
+		else if( std::strcmp( argv[ i ], "--min-time" ) == 0 )
+			opts.m_minTime = std::atof( argv[ i + 1 ] );
+		else if( std::strcmp( argv[ i ], "--iterations" ) == 0 )
+			opts.m_iterations = static_cast< std::size_t > (
+				std::strtoull( argv[ i + 1 ], nullptr, 10 ) );
+		else
+		{
+			std::fprintf( stderr, "Unknown option \"%s\".\n", argv[ i ] );
+
+			return 1;
+		}
+	}
+
+	try {
+		Bench::benchArgs( opts, 10 );
+		Bench::benchArgs( opts, 1000 );
+		Bench::benchArgs( opts, 10000 );
+		Bench::benchSimilarNames( opts, 8000 );
+		Bench::benchFlags( opts );
+		Bench::benchMultiArg( opts, 1000000 );
+		Bench::benchCommands( opts, 10, 4 );
+		Bench::benchCommands( opts, 100, 8 );
+	}
+	catch( const Args::BaseException & x )
+	{
+		Args::outStream() << x.desc() << SL( "\n" );
+
+		return 1;
+	}
+
+	return 0;
+}
@@ -9,4 +9,5 @@ MxxRu::Cpp::composite_target( Mxx_ru::BUILD_ROOT ) {
 
 	required_prj( "tests/prj.rb" )
 	required_prj( "samples/prj.rb" )
+	required_prj( "benchmarks/prj.rb" )
 }
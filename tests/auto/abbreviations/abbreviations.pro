@@ -0,0 +1,10 @@
+
+TEMPLATE = app
+CONFIG += console c++14
+QT -= core gui
+
+INCLUDEPATH = ../../..
+
+include( ../../../config.pri )
+
+SOURCES = main.cpp
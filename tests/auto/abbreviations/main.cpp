@@ -0,0 +1,328 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+TEST( AbbreviationsCase, TestTrie )
+{
+	Arg verbose( String( SL( "verbose" ) ) );
+	Arg version( String( SL( "version" ) ) );
+	Arg output( String( SL( "output" ) ) );
+	Command add( SL( "add" ) );
+
+	PrefixTrie trie;
+
+	CHECK_CONDITION( trie.empty() )
+
+	trie.insert( SL( "--verbose" ), &verbose );
+	trie.insert( SL( "--version" ), &version );
+	trie.insert( SL( "--output" ), &output );
+	trie.insert( SL( "--out" ), &output );
+	trie.insert( SL( "add" ), &add );
+
+	bool ambiguous = false;
+
+	CHECK_CONDITION( trie.find( String( SL( "--verb" ) ), ambiguous ) == &verbose )
+	CHECK_CONDITION( !ambiguous )
+	CHECK_CONDITION( trie.find( String( SL( "--versi" ) ), ambiguous ) == &version )
+	CHECK_CONDITION( trie.find( String( SL( "--version" ) ), ambiguous ) == &version )
+	CHECK_CONDITION( trie.find( String( SL( "--o" ) ), ambiguous ) == &output )
+	CHECK_CONDITION( !ambiguous )
+	CHECK_CONDITION( trie.find( String( SL( "a" ) ), ambiguous ) == &add )
+	CHECK_CONDITION( trie.find( String( SL( "--versions" ) ), ambiguous ) == nullptr )
+	CHECK_CONDITION( !ambiguous )
+	CHECK_CONDITION( trie.find( String( SL( "--x" ) ), ambiguous ) == nullptr )
+	CHECK_CONDITION( !ambiguous )
+
+	CHECK_CONDITION( trie.find( String( SL( "--ver" ) ), ambiguous ) == nullptr )
+	CHECK_CONDITION( ambiguous )
+	CHECK_CONDITION( trie.find( String( SL( "--" ) ), ambiguous ) == nullptr )
+	CHECK_CONDITION( ambiguous )
+
+	std::vector< String > names;
+	trie.collect( String( SL( "--ver" ) ), names );
+
+	CHECK_CONDITION( names.size() == 2 )
+
+	names.clear();
+	trie.collect( String( SL( "--ou" ) ), names );
+
+	CHECK_CONDITION( names.size() == 2 )
+}
+
+TEST( AbbreviationsCase, TestParse )
+{
+	const int argc = 6;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "--verb" ), SL( "--out=a.txt" ), SL( "ad" ), SL( "--sou" ),
+		SL( "b.txt" ) };
+
+	CmdLine cmd( argc, argv, CmdLine::AllowAbbreviations );
+
+	Arg verbose( String( SL( "verbose" ) ) );
+	Arg version( String( SL( "version" ) ) );
+	Arg output( Char( SL( 'o' ) ), String( SL( "output" ) ), true );
+	Command add( SL( "add" ) );
+	Command remove( SL( "remove" ) );
+	Arg source( String( SL( "source" ) ), true );
+
+	add.addArg( source );
+
+	cmd.addArg( verbose );
+	cmd.addArg( version );
+	cmd.addArg( output );
+	cmd.addArg( add );
+	cmd.addArg( remove );
+
+	cmd.parse();
+
+	CHECK_CONDITION( verbose.isDefined() )
+	CHECK_CONDITION( !version.isDefined() )
+	CHECK_CONDITION( output.value() == SL( "a.txt" ) )
+	CHECK_CONDITION( add.isDefined() )
+	CHECK_CONDITION( source.value() == SL( "b.txt" ) )
+}
+
+TEST( AbbreviationsCase, TestExactMatch )
+{
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "--verb" ) };
+
+	CmdLine cmd( argc, argv, CmdLine::AllowAbbreviations );
+
+	Arg verb( String( SL( "verb" ) ) );
+	Arg verbose( String( SL( "verbose" ) ) );
+
+	cmd.addArg( verb );
+	cmd.addArg( verbose );
+
+	cmd.parse();
+
+	CHECK_CONDITION( verb.isDefined() )
+	CHECK_CONDITION( !verbose.isDefined() )
+}
+
+TEST( AbbreviationsCase, TestAmbiguous )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "--ver" ) };
+
+	CmdLine cmd( argc, argv, CmdLine::AllowAbbreviations );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg verbose( String( SL( "verbose" ) ) );
+	Arg version( String( SL( "version" ) ) );
+
+	cmd.addArg( a );
+	cmd.addArg( verbose );
+	cmd.addArg( version );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::AmbiguousArgument )
+	CHECK_CONDITION( status.token() == 1 )
+	CHECK_CONDITION( status.word() == SL( "--ver" ) )
+	CHECK_CONDITION( status.candidates().size() == 2 )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Ambiguous argument \"--ver\", it can be \"--verbose\" "
+			"or \"--version\"." ) ) )
+}
+
+TEST( AbbreviationsCase, TestWordsAreNotLongNames )
+{
+	Arg a( Char( SL( 'a' ) ) );
+	MultiArg files( String( SL( "files" ) ), true );
+	Arg verbose( String( SL( "verbose" ) ) );
+	Arg verbosity( String( SL( "verbosity" ) ), true );
+	Arg output( String( SL( "output" ) ), true );
+	Command add( SL( "add" ) );
+
+	const auto parse = [ & ] ( int argc, const CHAR * argv[],
+		ParseStatus & status ) -> bool
+	{
+		CmdLine cmd( argc, argv, CmdLine::AllowAbbreviations );
+
+		cmd.addArg( a );
+		cmd.addArg( files );
+		cmd.addArg( verbose );
+		cmd.addArg( verbosity );
+		cmd.addArg( output );
+		cmd.addArg( add );
+
+		return cmd.parse( status );
+	};
+
+	ParseStatus status;
+
+	{
+		const int argc = 3;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "-a" ),
+			SL( "-" ) };
+
+		CHECK_CONDITION( parse( argc, argv, status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+		CHECK_CONDITION( status.word() == SL( "-" ) )
+	}
+
+	{
+		const int argc = 3;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "--" ),
+			SL( "--verb" ) };
+
+		CHECK_CONDITION( parse( argc, argv, status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+		CHECK_CONDITION( status.word() == SL( "--verb" ) )
+	}
+
+	{
+		const int argc = 4;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "--files" ),
+			SL( "-" ), SL( "a.txt" ) };
+
+		const StringList values = { SL( "-" ), SL( "a.txt" ) };
+
+		CHECK_CONDITION( parse( argc, argv, status ) == true )
+		CHECK_CONDITION( files.values() == values )
+	}
+
+	{
+		const int argc = 3;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "--out" ),
+			SL( "ad" ) };
+
+		CHECK_CONDITION( parse( argc, argv, status ) == true )
+		CHECK_CONDITION( output.value() == SL( "ad" ) )
+		CHECK_CONDITION( !add.isDefined() )
+	}
+}
+
+TEST( AbbreviationsCase, TestScopeOfCommand )
+{
+	const int argc = 4;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "--fo" ), SL( "add" ), SL( "--fo" ) };
+
+	CmdLine cmd( argc, argv, CmdLine::AllowAbbreviations );
+
+	Arg force( String( SL( "force" ) ) );
+	Command add( SL( "add" ) );
+	Command amend( SL( "amend" ) );
+	Arg format( String( SL( "format" ) ) );
+
+	add.addArg( format );
+
+	cmd.addArg( force );
+	cmd.addArg( add );
+	cmd.addArg( amend );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( force.isDefined() )
+	CHECK_CONDITION( status.error() == ParseError::AmbiguousArgument )
+	CHECK_CONDITION( status.token() == 2 )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Ambiguous argument \"--fo\", it can be \"--force\" "
+			"or \"--format\"." ) ) )
+
+	const CHAR * argv2[ 2 ] = { SL( "program.exe" ), SL( "a" ) };
+
+	CHECK_CONDITION( cmd.parse( 2, argv2, status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::AmbiguousArgument )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Ambiguous argument \"a\", it can be \"add\" "
+			"or \"amend\"." ) ) )
+}
+
+TEST( AbbreviationsCase, TestDisabled )
+{
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "--verb" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg verbose( String( SL( "verbose" ) ) );
+
+	cmd.addArg( verbose );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+}
+
+TEST( AbbreviationsCase, TestTrieWithResource )
+{
+	Arg verbose( String( SL( "verbose" ) ) );
+	Arg version( String( SL( "version" ) ) );
+
+	alignas( std::max_align_t ) char buffer[ 4 * 1024 ];
+
+	MonotonicBuffer arena( buffer, sizeof( buffer ) );
+
+	PrefixTrie trie( &arena );
+
+	const std::size_t used = arena.used();
+
+	CHECK_CONDITION( used > 0 )
+
+	trie.insert( SL( "--verbose" ), &verbose );
+	trie.insert( SL( "--version" ), &version );
+
+	CHECK_CONDITION( arena.used() > used )
+
+	bool ambiguous = false;
+
+	CHECK_CONDITION( trie.find( String( SL( "--verb" ) ), ambiguous ) == &verbose )
+	CHECK_CONDITION( trie.find( String( SL( "--vers" ) ), ambiguous ) == &version )
+}
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
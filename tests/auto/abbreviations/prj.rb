@@ -0,0 +1,9 @@
+
+require 'mxx_ru/cpp'
+
+Mxx_ru::Cpp::exe_target {
+    
+	target( "tests/test.abbreviations" )
+
+	cpp_source( "main.cpp" )
+}
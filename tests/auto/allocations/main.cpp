@@ -0,0 +1,265 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define UNIT_TEST_COUNT_ALLOCATIONS
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+// C++ include.
+#include <vector>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+//! Argument with public isItYou().
+class TestArg
+	:	public Arg
+{
+public:
+	using Arg::Arg;
+	using Arg::isItYou;
+}; // class TestArg
+
+
+/*
+	Qt strings are allocated by Qt itself, so allocations are checked
+	only for std::string and std::wstring.
+*/
+#ifndef ARGS_QSTRING_BUILD
+
+TEST( AllocationsCase, TestCheck )
+{
+	CHECK_ALLOCATIONS_AT_MOST( 0, int i = 0; UNUSED( i ) )
+	CHECK_ALLOCATIONS_AT_MOST( 1, std::unique_ptr< int > p( new int( 1 ) ) )
+	CHECK_THROW( CHECK_ALLOCATIONS_AT_MOST( 0, std::unique_ptr< int > p( new int( 1 ) ) ),
+		std::runtime_error )
+}
+
+TEST( AllocationsCase, TestReparse )
+{
+	const int argc = 14;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "--port=4545" ), SL( "--files" ), SL( "a.txt" ),
+		SL( "b.txt" ), SL( "--timeout" ), SL( "100" ), SL( "-v" ), SL( "-v" ),
+		SL( "add" ), SL( "x" ), SL( "y" ), SL( "-bv" ) };
+
+	const int argc2 = 11;
+	const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+		SL( "--port" ), SL( "80" ), SL( "--files" ), SL( "c.txt" ),
+		SL( "--timeout=5" ), SL( "-vvv" ), SL( "add" ), SL( "z" ), SL( "-b" ),
+		SL( "-a" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ) );
+	Arg port( String( SL( "port" ) ), true );
+	MultiArg files( String( SL( "files" ) ), true );
+	TypedMultiArg< int > timeout( String( SL( "timeout" ) ) );
+	MultiArg verbose( Char( SL( 'v' ) ) );
+	OnlyOneGroup g( SL( "group" ) );
+	Command add( SL( "add" ), ValueOptions::ManyValues );
+
+	timeout.reserve( 4 );
+
+	g.addArg( a );
+	add.addArg( b );
+
+	cmd.addArg( g );
+	cmd.addArg( port );
+	cmd.addArg( files );
+	cmd.addArg( timeout );
+	cmd.addArg( verbose );
+	cmd.addArg( add );
+
+	cmd.seal();
+
+	ParseStatus status;
+
+	// Warm up: buffers of values and containers are allocated.
+	for( int i = 0; i < 2; ++i )
+	{
+		CHECK_CONDITION( cmd.parse( argc, argv, status ) )
+		CHECK_CONDITION( files.values().size() == 2 )
+		CHECK_CONDITION( add.values().size() == 2 )
+		CHECK_CONDITION( port.valueAs< int > () == 4545 )
+
+		CHECK_CONDITION( cmd.parse( argc2, argv2, status ) )
+		CHECK_CONDITION( files.values().size() == 1 )
+		CHECK_CONDITION( port.valueAs< int > () == 80 )
+	}
+
+	CHECK_ALLOCATIONS_AT_MOST( 0, cmd.parse( argc, argv, status ) )
+	CHECK_CONDITION( status.isOk() )
+
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( port.value() == SL( "4545" ) ) )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( port.valueAs< int > () == 4545 ) )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( files.values().back() == SL( "b.txt" ) ) )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( add.values().front() == SL( "x" ) ) )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( timeout.values()[ 0 ] == 100 ) )
+	CHECK_CONDITION( verbose.count() == 3 )
+	CHECK_CONDITION( a.isDefined() && b.isDefined() )
+
+	CHECK_ALLOCATIONS_AT_MOST( 0, cmd.parse( argc2, argv2, status ) )
+	CHECK_CONDITION( status.isOk() )
+
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( files.value() == SL( "c.txt" ) ) )
+	CHECK_CONDITION( verbose.count() == 3 )
+}
+
+TEST( AllocationsCase, TestHelpLookup )
+{
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "add" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg file( Char( SL( 'f' ) ), String( SL( "file" ) ), true );
+	Command add( SL( "add" ) );
+	add.addArg( file );
+
+	cmd.addArg( add );
+
+	cmd.parse();
+
+	const String longName( SL( "--file" ) );
+	const String shortName( SL( "-f" ) );
+
+	TestArg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+
+	const String timeoutName( SL( "--timeout" ) );
+	const String timeoutFlag( SL( "-t" ) );
+
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( timeout.isItYou( timeoutName ) == &timeout ) )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( timeout.isItYou( timeoutFlag ) == &timeout ) )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( timeout.isItYou( longName ) == nullptr ) )
+
+	// Lookup of the command's arguments by name as help printer does.
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( cmd.findArgument( longName ) == &file ) )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( cmd.findArgument( shortName ) == &file ) )
+}
+
+TEST( AllocationsCase, TestName )
+{
+	Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+	Arg flag( Char( SL( 'f' ) ) );
+	Command add( SL( "add" ) );
+
+	const String * name = nullptr;
+
+	CHECK_ALLOCATIONS_AT_MOST( 0, name = &timeout.name() )
+	CHECK_CONDITION( *name == SL( "--timeout" ) )
+	CHECK_CONDITION( &timeout.name() == name )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( flag.name() == SL( "-f" ) ) )
+	CHECK_ALLOCATIONS_AT_MOST( 0,
+		CHECK_CONDITION( add.name() == SL( "add" ) ) )
+
+	flag.setArgumentName( SL( "force" ) );
+	CHECK_CONDITION( flag.name() == SL( "--force" ) )
+
+	timeout.setArgumentName( String() );
+	CHECK_CONDITION( timeout.name() == SL( "-t" ) )
+
+	timeout.setFlag( SL( 'o' ) );
+	CHECK_CONDITION( timeout.name() == SL( "-o" ) )
+}
+
+constexpr StaticArgSpec c_longNamesSpecs[] = {
+	staticArg( SL( 'v' ), SL( "very-long-argument-name" ) ),
+	staticGroup( SL( "very-long-group-name" ) ),
+	staticArg( SL( "another-long-argument-name" ) ).withValue()
+		.in( SL( "very-long-group-name" ) )
+};
+
+ARGS_STATIC_SCHEMA( c_longNamesSchema, c_longNamesSpecs )
+
+TEST( AllocationsCase, TestBindSchema )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "--another-long-argument-name" ), SL( "value" ) };
+
+	alignas( std::max_align_t ) char buffer[ 16 * 1024 ];
+
+	MonotonicBuffer arena( buffer, sizeof( buffer ) );
+
+	CmdLine cmd( argc, argv, CmdLine::Empty, &arena );
+
+	Arg v( Char( SL( 'v' ) ), String( SL( "very-long-argument-name" ) ) );
+	OnlyOneGroup g( String( SL( "very-long-group-name" ) ) );
+	Arg another( String( SL( "another-long-argument-name" ) ), true );
+
+	g.addArg( another );
+
+	cmd.addArg( v );
+	cmd.addArg( g );
+
+	cmd.setSchema( c_longNamesSchema );
+
+	ParseStatus status;
+
+	// Arguments are bound to the schema without building of the keys.
+	CHECK_ALLOCATIONS_AT_MOST( 0, cmd.parse( status ) )
+	CHECK_CONDITION( status.isOk() )
+	CHECK_CONDITION( another.value() == SL( "value" ) )
+}
+
+#endif // ARGS_QSTRING_BUILD
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
@@ -34,6 +34,9 @@
 // Args include.
 #include <Args/all.hpp>
 
+// C++ include.
+#include <vector>
+
 
 using namespace Args;
 
@@ -135,6 +138,235 @@ TEST( ArgTestCase, TestUndefinedRequiredArg )
 	CHECK_CONDITION( false )
 }
 
+TEST( ArgTestCase, TestAddArgs )
+{
+	const int argc = 5;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-t" ), SL( "100" ),
+		SL( "--host" ), SL( "any" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+	Arg port( Char( SL( 'p' ) ), String( SL( "port" ) ), true );
+	Arg host( Char( SL( 'h' ) ), String( SL( "host" ) ), true );
+
+	std::vector< ArgIface* > args = { &timeout, &port, &host };
+
+	cmd.addArgs( args );
+
+	CHECK_CONDITION( cmd.arguments().size() == 3 )
+
+	cmd.parse();
+
+	CHECK_CONDITION( timeout.value() == SL( "100" ) )
+	CHECK_CONDITION( host.value() == SL( "any" ) )
+	CHECK_CONDITION( !port.isDefined() )
+
+	CHECK_THROW( cmd.addArg( port ), BaseException )
+}
+
+TEST( ArgTestCase, TestAddArgsIncorrect )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+	Arg port( Char( SL( 'p' ) ), String( SL( "port" ) ), true );
+	Arg time( Char( SL( 't' ) ), String( SL( "time" ) ), true );
+
+	cmd.addArg( timeout );
+
+	ArgIface * args[] = { &port, &time };
+
+	CHECK_THROW( cmd.addArgs( args ), BaseException )
+
+	CHECK_CONDITION( cmd.arguments().size() == 1 )
+
+	ArgIface * duplicates[] = { &port, &port };
+
+	CHECK_THROW( cmd.addArgs( duplicates ), BaseException )
+
+	CHECK_CONDITION( cmd.arguments().size() == 1 )
+
+	cmd.addArgs( std::begin( args ), std::begin( args ) + 1 );
+
+	CHECK_CONDITION( cmd.arguments().size() == 2 )
+}
+
+TEST( ArgTestCase, TestNamesInCommands )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg verbose( Char( SL( 'v' ) ), String( SL( "verbose" ) ), false );
+	Command add( SL( "add" ) );
+	Arg addFile( Char( SL( 'f' ) ), String( SL( "file" ) ), true );
+	Command del( SL( "del" ) );
+	Arg delFile( Char( SL( 'f' ) ), String( SL( "file" ) ), true );
+
+	add.addArg( addFile );
+	del.addArg( delFile );
+
+	ArgIface * args[] = { &verbose, &add, &del };
+
+	cmd.addArgs( args );
+
+	CHECK_CONDITION( cmd.arguments().size() == 3 )
+
+	Command rm( SL( "rm" ) );
+	Arg rmVerbose( Char( SL( 'v' ) ), String( SL( "really-verbose" ) ), false );
+
+	rm.addArg( rmVerbose );
+
+	ArgIface * incorrect[] = { &rm };
+
+	CHECK_THROW( cmd.addArgs( incorrect ), BaseException )
+
+	CHECK_CONDITION( cmd.arguments().size() == 3 )
+}
+
+TEST( ArgTestCase, TestHandlers )
+{
+	const int argc = 6;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-t" ), SL( "100" ), SL( "--files" ), SL( "a" ), SL( "b" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg t( Char( SL( 't' ) ), true );
+	MultiArg files( String( SL( "files" ) ), true );
+
+	cmd.addArg( t );
+	cmd.addArg( files );
+
+	String timeout;
+	int filesCount = 0;
+	int definedCount = 0;
+
+	auto onTimeout = [ &timeout ] ( const StringView & value )
+		{ timeout = value.toString(); };
+	auto onFile = [ &filesCount ] ( const StringView & )
+		{ ++filesCount; };
+	auto onDefined = [ &definedCount ] ( ArgIface & )
+		{ ++definedCount; };
+
+	t.setValueHandler( onTimeout );
+	t.setDefinedHandler( onDefined );
+	files.setValueHandler( onFile, true );
+	files.setDefinedHandler( onDefined );
+
+	cmd.parse();
+
+	CHECK_CONDITION( timeout == SL( "100" ) )
+	CHECK_CONDITION( t.isDefined() )
+	CHECK_CONDITION( t.value().empty() )
+	CHECK_CONDITION( filesCount == 2 )
+	CHECK_CONDITION( files.values().size() == 2 )
+	CHECK_CONDITION( definedCount == 2 )
+}
+
+TEST( ArgTestCase, TestAliases )
+{
+	const int argc = 6;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "--out=a.txt" ), SL( "-vV" ), SL( "add" ), SL( "--src" ),
+		SL( "b.txt" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg output( Char( SL( 'o' ) ), String( SL( "output" ) ), true );
+	MultiArg verbose( Char( SL( 'v' ) ) );
+	Command add( SL( "add" ) );
+	Arg source( String( SL( "source" ) ), true );
+
+	output.addAlias( SL( "--out" ) );
+	output.addAlias( SL( "-O" ) );
+	verbose.addAlias( SL( "-V" ) );
+	source.addAlias( SL( "--src" ) );
+
+	add.addArg( source );
+
+	cmd.addArg( output );
+	cmd.addArg( verbose );
+	cmd.addArg( add );
+
+	cmd.parse();
+
+	CHECK_CONDITION( output.aliases().size() == 2 )
+	CHECK_CONDITION( output.value() == SL( "a.txt" ) )
+	CHECK_CONDITION( verbose.count() == 2 )
+	CHECK_CONDITION( source.value() == SL( "b.txt" ) )
+
+	CHECK_CONDITION( cmd.findArgument( SL( "-O" ) ) == &output )
+	CHECK_CONDITION( cmd.findArgument( SL( "--output" ) ) == &output )
+	CHECK_CONDITION( cmd.findArgument( SL( "--src" ) ) == &source )
+
+	CHECK_THROW( output.addAlias( SL( "out" ) ), BaseException )
+}
+
+TEST( ArgTestCase, TestAliasesIncorrect )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	{
+		CmdLine cmd( argc, argv );
+
+		Arg a( Char( SL( 'a' ) ) );
+		Arg b( Char( SL( 'b' ) ) );
+		b.addAlias( SL( "-a" ) );
+
+		cmd.addArg( a );
+		cmd.addArg( b );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::FlagRedefinition )
+		CHECK_CONDITION( status.argument() == &b )
+		CHECK_CONDITION( status.description() ==
+			String( SL( "Redefinition of argument with flag \"-a\"." ) ) )
+	}
+
+	{
+		CmdLine cmd( argc, argv );
+
+		Arg a( String( SL( "output" ) ) );
+		a.addAlias( SL( "--out" ) );
+		a.addAlias( SL( "--out" ) );
+
+		cmd.addArg( a );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::NameRedefinition )
+		CHECK_CONDITION( status.description() ==
+			String( SL( "Redefinition of argument with name \"--out\"." ) ) )
+	}
+
+	{
+		CmdLine cmd( argc, argv );
+
+		Arg a( Char( SL( 'a' ) ) );
+		a.addAlias( SL( "--out put" ) );
+
+		cmd.addArg( a );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::DisallowedName )
+		CHECK_CONDITION( status.description() ==
+			String( SL( "Dissallowed name \"--out put\"." ) ) )
+	}
+}
+
 
 int main()
 {
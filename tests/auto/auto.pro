@@ -7,5 +7,17 @@ SUBDIRS = arg \
 	multi_arg \
 	groups \
 	command \
-	arg_as_command
+	arg_as_command \
+	parse_status \
+	static_schema \
+	reset \
+	memory_resource \
+	typed_value \
+	response_file \
+	stream_source \
+	parse_stats \
+	allocations \
+	no_rtti \
+	abbreviations \
+	suggestions
 	
\ No newline at end of file
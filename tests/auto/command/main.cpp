@@ -34,6 +34,9 @@
 // Args include.
 #include <Args/all.hpp>
 
+// C++ include.
+#include <vector>
+
 
 using namespace Args;
 
@@ -252,6 +255,150 @@ TEST( CommandCase, TestAllIsOk4 )
 	CHECK_CONDITION( d.isDefined() == false )
 }
 
+TEST( CommandCase, TestFindArgument )
+{
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "add" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg g( Char( SL( 'g' ) ), SL( "global" ) );
+
+	Arg f( Char( SL( 'f' ) ), SL( "file" ), true );
+	Arg n( SL( "name" ), true );
+
+	OnlyOneGroup group( SL( "group" ) );
+	group.addArg( n );
+
+	Command c( SL( "add" ) );
+	c.addArg( f );
+	c.addArg( group );
+
+	Command d( SL( "del" ) );
+
+	cmd.addArg( g );
+	cmd.addArg( c );
+	cmd.addArg( d );
+
+	CHECK_CONDITION( cmd.findArgument( SL( "-g" ) ) == &g )
+	CHECK_CONDITION( cmd.findArgument( SL( "--global" ) ) == &g )
+	CHECK_CONDITION( cmd.findArgument( SL( "add" ) ) == &c )
+	CHECK_CONDITION( cmd.findArgument( SL( "del" ) ) == &d )
+
+	CHECK_THROW( cmd.findArgument( SL( "-f" ) ), BaseException )
+	CHECK_THROW( cmd.findArgument( SL( "--name" ) ), BaseException )
+
+	cmd.parse();
+
+	CHECK_CONDITION( cmd.findArgument( SL( "-f" ) ) == &f )
+	CHECK_CONDITION( cmd.findArgument( SL( "--file" ) ) == &f )
+	CHECK_CONDITION( cmd.findArgument( SL( "--name" ) ) == &n )
+
+	CHECK_THROW( cmd.findArgument( SL( "--unknown" ) ), BaseException )
+	CHECK_THROW( cmd.findArgument( SL( "-n" ) ), BaseException )
+
+	CHECK_CONDITION( cmd.tryFindArgument( SL( "--name" ) ) == &n )
+	CHECK_CONDITION( cmd.tryFindArgument( SL( "--unknown" ) ) == nullptr )
+	CHECK_CONDITION( cmd.tryFindArgument( SL( "value" ) ) == nullptr )
+}
+
+TEST( CommandCase, TestHandlers )
+{
+	const int argc = 8;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "add" ), SL( "1" ), SL( "2" ), SL( "3" ),
+		SL( "-f" ), SL( "file" ), SL( "last" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg f( Char( SL( 'f' ) ), true );
+	Command c( SL( "add" ), ValueOptions::ManyValues );
+	ArgAsCommand l( SL( "last" ) );
+
+	c.addArg( f );
+	c.addArg( l );
+
+	cmd.addArg( c );
+
+	std::vector< String > values;
+	std::vector< ArgIface* > defined;
+
+	auto onValue = [ &values ] ( const StringView & value )
+		{ values.push_back( value.toString() ); };
+	auto onDefined = [ &defined ] ( ArgIface & arg )
+		{ defined.push_back( &arg ); };
+
+	c.setValueHandler( onValue );
+	c.setDefinedHandler( onDefined );
+	f.setValueHandler( onValue, true );
+	f.setDefinedHandler( onDefined );
+	l.setDefinedHandler( onDefined );
+
+	cmd.parse();
+
+	const std::vector< String > expectedValues = { SL( "1" ), SL( "2" ),
+		SL( "3" ), SL( "file" ) };
+	const std::vector< ArgIface* > expectedDefined = { &c, &f, &l };
+
+	CHECK_CONDITION( values == expectedValues )
+	CHECK_CONDITION( defined == expectedDefined )
+	CHECK_CONDITION( c.isDefined() )
+	CHECK_CONDITION( c.values().empty() )
+	CHECK_CONDITION( f.value() == SL( "file" ) )
+	CHECK_CONDITION( l.isDefined() )
+}
+
+TEST( CommandCase, TestFlagsCombo )
+{
+	const int argc = 4;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "run" ), SL( "-bac" ) };
+
+	CmdLine cmd( argc, argv );
+
+	MultiArg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ) );
+	Arg c( Char( SL( 'c' ) ) );
+	Arg other( Char( SL( 'b' ) ) );
+	Command run( SL( "run" ) );
+	Command stop( SL( "stop" ) );
+
+	run.addArg( b );
+	run.addArg( c );
+	stop.addArg( other );
+
+	cmd.addArg( a );
+	cmd.addArg( run );
+	cmd.addArg( stop );
+
+	cmd.seal();
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) )
+	CHECK_CONDITION( a.count() == 2 )
+	CHECK_CONDITION( b.isDefined() && c.isDefined() )
+	CHECK_CONDITION( !other.isDefined() )
+
+	// Flags of the command are unknown before the command.
+	const int argc2 = 3;
+	const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+		SL( "-ab" ), SL( "run" ) };
+
+	CHECK_CONDITION( !cmd.parse( argc2, argv2, status ) )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	CHECK_CONDITION( status.word() == SL( "-b" ) )
+
+	const int argc3 = 3;
+	const CHAR * argv3[ argc3 ] = { SL( "program.exe" ),
+		SL( "stop" ), SL( "-ba" ) };
+
+	CHECK_CONDITION( cmd.parse( argc3, argv3, status ) )
+	CHECK_CONDITION( other.isDefined() && !b.isDefined() )
+	CHECK_CONDITION( a.count() == 1 )
+}
+
 
 int main()
 {
@@ -36,6 +36,7 @@
 
 // C++ include.
 #include <utility>
+#include <vector>
 
 
 using namespace Args;
@@ -77,6 +78,185 @@ TEST( ContextTestCase, TestContext )
 	CHECK_CONDITION( ctx.atEnd() == true )
 }
 
+TEST( ContextTestCase, TestWordsAreNotCopied )
+{
+	const String words[] = { SL( "-a" ), SL( "--timeout=100" ) };
+
+	Context ctx;
+	ctx.assign( std::begin( words ), std::end( words ) );
+
+	CHECK_CONDITION( ctx.next()->data() == words[ 0 ].data() )
+
+	const StringView word = *ctx.next();
+
+	CHECK_CONDITION( word.data() == words[ 1 ].data() )
+	CHECK_CONDITION( ctx.index() == 1 )
+	CHECK_CONDITION( ctx.isOwned() == false )
+
+	ctx.prepend( word.substr( 10 ) );
+
+	const StringView value = *ctx.next();
+
+	CHECK_CONDITION( value == SL( "100" ) )
+	CHECK_CONDITION( value.data() == words[ 1 ].data() + 10 )
+	CHECK_CONDITION( ctx.index() == 1 )
+	CHECK_CONDITION( ctx.isOwned() == false )
+	CHECK_CONDITION( ctx.atEnd() == true )
+
+	// Prepended string is stored in the context.
+	ctx.prepend( String( SL( "200" ) ) );
+
+	CHECK_CONDITION( *ctx.next() == SL( "200" ) )
+	CHECK_CONDITION( ctx.isOwned() == true )
+}
+
+TEST( ContextTestCase, TestTokens )
+{
+	const String words[] = { SL( "--timeout=100" ), SL( "-abc" ),
+		SL( "add" ), SL( "--" ), SL( "-a" ) };
+
+	Context ctx;
+	ctx.assign( std::begin( words ), std::end( words ) );
+
+	auto it = ctx.next();
+
+	CHECK_CONDITION( ctx.token( it ).kind() == TokenKind::Long )
+	CHECK_CONDITION( ctx.token( it ).name( *it ) == SL( "--timeout" ) )
+	CHECK_CONDITION( ctx.token( it ).hasValue( *it ) == true )
+	CHECK_CONDITION( ctx.token( it ).value( *it ) == SL( "100" ) )
+
+	it = ctx.next();
+
+	CHECK_CONDITION( ctx.token( it ).kind() == TokenKind::Short )
+	CHECK_CONDITION( ctx.token( it ).name( *it ) == SL( "-abc" ) )
+	CHECK_CONDITION( ctx.token( it ).hasValue( *it ) == false )
+
+	it = ctx.next();
+
+	CHECK_CONDITION( ctx.token( it ).kind() == TokenKind::Word )
+
+	it = ctx.next();
+
+	CHECK_CONDITION( ctx.token( it ).kind() == TokenKind::EndOfOptions )
+
+	it = ctx.next();
+
+	CHECK_CONDITION( ctx.token( it ).kind() == TokenKind::Operand )
+}
+
+TEST( ContextTestCase, TestEndOfOptionsAndValues )
+{
+	const std::vector< String > words = { SL( "--num=-5" ), SL( "-a" ),
+		SL( "--" ), SL( "-a" ) };
+
+	CmdLine cmd( words );
+
+	Arg num( SL( "num" ), true );
+	Arg a( Char( SL( 'a' ) ) );
+
+	cmd.addArg( num );
+	cmd.addArg( a );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	CHECK_CONDITION( status.token() == 3 )
+	CHECK_CONDITION( num.value() == SL( "-5" ) )
+	CHECK_CONDITION( a.isDefined() == true )
+}
+
+TEST( ContextTestCase, TestDashedValuesAfterEndOfOptions )
+{
+	const std::vector< String > words = { SL( "--files" ), SL( "a" ),
+		SL( "--" ), SL( "--foo" ), SL( "b" ) };
+
+	CmdLine cmd( words );
+
+	MultiArg files( SL( "files" ), true );
+	Arg foo( SL( "foo" ) );
+
+	cmd.addArg( files );
+	cmd.addArg( foo );
+
+	ParseStatus status;
+
+	const StringList values = { SL( "a" ), SL( "--foo" ), SL( "b" ) };
+
+	CHECK_CONDITION( cmd.parse( status ) == true )
+	CHECK_CONDITION( files.values() == values )
+	CHECK_CONDITION( foo.isDefined() == false )
+
+	const std::vector< String > words2 = { SL( "--num" ), SL( "--" ),
+		SL( "-5" ) };
+
+	CmdLine cmd2( words2 );
+
+	Arg num( SL( "num" ), true );
+	Arg five( Char( SL( '5' ) ) );
+
+	cmd2.addArg( num );
+	cmd2.addArg( five );
+
+	CHECK_CONDITION( cmd2.parse( status ) == true )
+	CHECK_CONDITION( num.value() == SL( "-5" ) )
+	CHECK_CONDITION( five.isDefined() == false )
+}
+
+TEST( ContextTestCase, TestValuesWithoutCmdLine )
+{
+	const String words[] = { SL( "value" ) };
+
+	Context ctx;
+	ctx.assign( std::begin( words ), std::end( words ) );
+
+	CmdLine * cmd = nullptr;
+	StringView value;
+
+	CHECK_THROW( eatOneValue( ctx, cmd, value ), BaseException )
+	CHECK_THROW( consumeValues( ctx, cmd,
+		[] ( const StringView & ) { return true; } ), BaseException )
+}
+
+TEST( ContextTestCase, TestCmdLineFromContainer )
+{
+	const std::vector< String > words = { SL( "-a" ), SL( "--timeout=100" ),
+		SL( "--host" ), SL( "localhost" ) };
+
+	CmdLine cmd( words );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg timeout( SL( "timeout" ), true );
+	Arg host( SL( "host" ), true );
+
+	cmd.addArg( a );
+	cmd.addArg( timeout );
+	cmd.addArg( host );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == true )
+	CHECK_CONDITION( a.isDefined() == true )
+	CHECK_CONDITION( timeout.value() == SL( "100" ) )
+	CHECK_CONDITION( host.value() == SL( "localhost" ) )
+}
+
+TEST( ContextTestCase, TestCmdLineFromRange )
+{
+	const String words[] = { SL( "--host" ), SL( "localhost" ), SL( "-a" ) };
+
+	CmdLine cmd( std::begin( words ), std::end( words ) - 1 );
+
+	Arg host( SL( "host" ), true );
+
+	cmd.addArg( host );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == true )
+	CHECK_CONDITION( host.value() == SL( "localhost" ) )
+}
+
 
 int main()
 {
@@ -363,6 +363,66 @@ TEST( GroupCase, GroupsFailed )
 }
 
 
+TEST( GroupCase, TestLateChanges )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( SL( 'a' ), String( SL( "aaa" ) ) );
+	Arg b( SL( 'b' ), String( SL( "bbb" ) ) );
+
+	AllOfGroup g( SL( "all_of" ) );
+	g.addArg( a );
+
+	cmd.addArg( g );
+
+	CHECK_CONDITION( cmd.findArgument( SL( "--aaa" ) ) == &a )
+	CHECK_CONDITION( cmd.tryFindArgument( SL( "--bbb" ) ) == nullptr )
+
+	// Child added to the already registered group.
+	g.addArg( b );
+
+	CHECK_CONDITION( cmd.findArgument( SL( "--bbb" ) ) == &b )
+	CHECK_CONDITION( cmd.findArgument( SL( "-b" ) ) == &b )
+
+	// Renames after the first lookup.
+	a.setArgumentName( SL( "ccc" ) );
+	b.setFlag( SL( 'd' ) );
+	b.addAlias( SL( "--eee" ) );
+
+	CHECK_CONDITION( cmd.tryFindArgument( SL( "--aaa" ) ) == nullptr )
+	CHECK_CONDITION( cmd.tryFindArgument( SL( "-b" ) ) == nullptr )
+	CHECK_CONDITION( cmd.findArgument( SL( "--ccc" ) ) == &a )
+	CHECK_CONDITION( cmd.findArgument( SL( "-d" ) ) == &b )
+	CHECK_CONDITION( cmd.findArgument( SL( "--eee" ) ) == &b )
+
+	// Child of the command added after parsing.
+	Command c( SL( "run" ) );
+	Arg f( SL( 'f' ), String( SL( "fff" ) ) );
+
+	cmd.addArg( c );
+
+	const int argc2 = 4;
+	const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+		SL( "--ccc" ), SL( "-d" ), SL( "run" ) };
+
+	cmd.parse( argc2, argv2 );
+
+	c.addArg( f );
+
+	const int argc3 = 5;
+	const CHAR * argv3[ argc3 ] = { SL( "program.exe" ),
+		SL( "--ccc" ), SL( "-d" ), SL( "run" ), SL( "--fff" ) };
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( argc3, argv3, status ) )
+	CHECK_CONDITION( f.isDefined() )
+}
+
+
 int main()
 {
 	RUN_ALL_TESTS()
@@ -0,0 +1,321 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+// C++ include.
+#include <vector>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+//
+// CountingResource
+//
+
+//! Memory resource that counts allocations.
+class CountingResource final
+	:	public MemoryResource
+{
+public:
+	CountingResource()
+		:	m_allocations( 0 )
+		,	m_deallocations( 0 )
+	{
+	}
+
+	std::size_t allocations() const
+	{
+		return m_allocations;
+	}
+
+	std::size_t deallocations() const
+	{
+		return m_deallocations;
+	}
+
+protected:
+	void * doAllocate( std::size_t bytes, std::size_t alignment ) override
+	{
+		++m_allocations;
+
+		return newDeleteResource()->allocate( bytes, alignment );
+	}
+
+	void doDeallocate( void * p, std::size_t bytes,
+		std::size_t alignment ) override
+	{
+		++m_deallocations;
+
+		newDeleteResource()->deallocate( p, bytes, alignment );
+	}
+
+private:
+	std::size_t m_allocations;
+	std::size_t m_deallocations;
+}; // class CountingResource
+
+
+TEST( MemoryResourceCase, TestMonotonicBuffer )
+{
+	CountingResource upstream;
+
+	alignas( std::max_align_t ) char buffer[ 256 ];
+
+	{
+		MonotonicBuffer arena( buffer, sizeof( buffer ), &upstream );
+
+		char * p = static_cast< char* > ( arena.allocate( 100 ) );
+
+		CHECK_CONDITION( p >= buffer && p + 100 <= buffer + sizeof( buffer ) )
+		CHECK_CONDITION( upstream.allocations() == 0 )
+		CHECK_CONDITION( arena.used() == 100 )
+
+		arena.deallocate( p, 100 );
+
+		char * big = static_cast< char* > ( arena.allocate( 600, 8 ) );
+
+		CHECK_CONDITION( big < buffer || big >= buffer + sizeof( buffer ) )
+		CHECK_CONDITION( reinterpret_cast< std::size_t > ( big ) % 8 == 0 )
+		CHECK_CONDITION( upstream.allocations() == 1 )
+
+		arena.allocate( 10 );
+
+		CHECK_CONDITION( upstream.allocations() == 1 )
+
+		arena.release();
+
+		CHECK_CONDITION( upstream.deallocations() == 1 )
+		CHECK_CONDITION( arena.used() == 0 )
+
+		p = static_cast< char* > ( arena.allocate( 100 ) );
+
+		CHECK_CONDITION( p >= buffer && p + 100 <= buffer + sizeof( buffer ) )
+
+		arena.allocate( 4000 );
+
+		CHECK_CONDITION( upstream.allocations() == 2 )
+	}
+
+	CHECK_CONDITION( upstream.deallocations() == 2 )
+}
+
+TEST( MemoryResourceCase, TestOverAligned )
+{
+	const std::size_t alignment = alignof( std::max_align_t ) * 4;
+
+#ifdef __cpp_aligned_new
+	void * p = newDeleteResource()->allocate( 100, alignment );
+
+	CHECK_CONDITION( reinterpret_cast< std::size_t > ( p ) % alignment == 0 )
+
+	newDeleteResource()->deallocate( p, 100, alignment );
+#else
+	CHECK_THROW( newDeleteResource()->allocate( 100, alignment ), std::bad_alloc )
+#endif
+}
+
+TEST( MemoryResourceCase, TestAllocator )
+{
+	CountingResource resource;
+
+	{
+		std::vector< int, PolymorphicAllocator< int > > v( &resource );
+
+		v.push_back( 1 );
+		v.push_back( 2 );
+
+		CHECK_CONDITION( resource.allocations() > 0 )
+		CHECK_CONDITION( v.get_allocator().resource() == &resource )
+	}
+
+	CHECK_CONDITION( resource.allocations() == resource.deallocations() )
+
+	CHECK_CONDITION( PolymorphicAllocator< int > ( &resource ) ==
+		PolymorphicAllocator< char > ( &resource ) )
+	CHECK_CONDITION( PolymorphicAllocator< int > () ==
+		PolymorphicAllocator< int > ( newDeleteResource() ) )
+	CHECK_CONDITION( PolymorphicAllocator< int > ( &resource ) !=
+		PolymorphicAllocator< int > () )
+}
+
+TEST( MemoryResourceCase, TestParseWithResource )
+{
+	CountingResource resource;
+
+	{
+		const int argc = 6;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ),
+			SL( "-t" ), SL( "100" ), SL( "add" ), SL( "--file" ), SL( "a.txt" ) };
+
+		CmdLine cmd( argc, argv, CmdLine::Empty, &resource );
+
+		Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+		Command add( SL( "add" ) );
+		Arg file( Char( SL( 'f' ) ), String( SL( "file" ) ), true );
+
+		add.addArg( file );
+
+		cmd.addArg( timeout );
+		cmd.addArg( add );
+
+		CHECK_CONDITION( cmd.memoryResource() == &resource )
+
+		cmd.parse();
+
+		CHECK_CONDITION( timeout.value() == SL( "100" ) )
+		CHECK_CONDITION( add.isDefined() )
+		CHECK_CONDITION( file.value() == SL( "a.txt" ) )
+		CHECK_CONDITION( resource.allocations() > 0 )
+	}
+
+	CHECK_CONDITION( resource.allocations() == resource.deallocations() )
+}
+
+TEST( MemoryResourceCase, TestParseInArena )
+{
+	CountingResource upstream;
+
+	alignas( std::max_align_t ) char buffer[ 16 * 1024 ];
+
+	MonotonicBuffer arena( buffer, sizeof( buffer ), &upstream );
+
+	{
+		const int argc = 6;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ),
+			SL( "-t" ), SL( "100" ), SL( "add" ), SL( "--file" ), SL( "a.txt" ) };
+
+		CmdLine cmd( argc, argv, CmdLine::Empty, &arena );
+
+		Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+		Command add( SL( "add" ) );
+		Arg file( Char( SL( 'f' ) ), String( SL( "file" ) ), true );
+
+		add.addArg( file );
+
+		cmd.addArg( timeout );
+		cmd.addArg( add );
+
+		cmd.parse();
+
+		CHECK_CONDITION( timeout.value() == SL( "100" ) )
+		CHECK_CONDITION( file.value() == SL( "a.txt" ) )
+
+		const int argc2 = 4;
+		const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+			SL( "add" ), SL( "-f" ), SL( "b.txt" ) };
+
+		cmd.parse( argc2, argv2 );
+
+		CHECK_CONDITION( !timeout.isDefined() )
+		CHECK_CONDITION( file.value() == SL( "b.txt" ) )
+	}
+
+	CHECK_CONDITION( upstream.allocations() == 0 )
+
+	arena.release();
+}
+
+TEST( MemoryResourceCase, TestReparseInArena )
+{
+	alignas( std::max_align_t ) char buffer[ 16 * 1024 ];
+
+	MonotonicBuffer arena( buffer, sizeof( buffer ) );
+
+	const int argc = 6;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-t" ), SL( "100" ), SL( "add" ), SL( "--file" ), SL( "a.txt" ) };
+
+	const int argc2 = 5;
+	const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+		SL( "--timeout=5" ), SL( "add" ), SL( "-f" ), SL( "b.txt" ) };
+
+	CmdLine cmd( argc, argv, CmdLine::Empty, &arena );
+
+	Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+	Command add( SL( "add" ) );
+	Arg file( Char( SL( 'f' ) ), String( SL( "file" ) ), true );
+
+	add.addArg( file );
+
+	cmd.addArg( timeout );
+	cmd.addArg( add );
+
+	// Not sealed, index is built by the first parsing.
+	cmd.parse();
+	cmd.parse( argc2, argv2 );
+
+	const std::size_t used = arena.used();
+
+	for( int i = 0; i < 100; ++i )
+	{
+		cmd.parse( argc, argv );
+		cmd.parse( argc2, argv2 );
+	}
+
+	CHECK_CONDITION( arena.used() == used )
+	CHECK_CONDITION( timeout.value() == SL( "5" ) )
+	CHECK_CONDITION( file.value() == SL( "b.txt" ) )
+
+	// Index is rebuilt once after the change of the arguments.
+	Arg verbose( Char( SL( 'v' ) ) );
+
+	add.addArg( verbose );
+
+	cmd.parse( argc2, argv2 );
+
+	const std::size_t changed = arena.used();
+
+	CHECK_CONDITION( changed > used )
+
+	for( int i = 0; i < 100; ++i )
+		cmd.parse( argc2, argv2 );
+
+	CHECK_CONDITION( arena.used() == changed )
+}
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
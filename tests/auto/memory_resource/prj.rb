@@ -0,0 +1,9 @@
+
+require 'mxx_ru/cpp'
+
+Mxx_ru::Cpp::exe_target {
+    
+	target( "tests/test.memory_resource" )
+
+	cpp_source( "main.cpp" )
+}
@@ -197,6 +197,105 @@ TEST( MultiArgTestCase, NotDefinedValue2 )
 	CHECK_CONDITION( false )
 }
 
+TEST( MultiArgTestCase, TestTypedMultiArg )
+{
+	const int argc = 8;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-i" ), SL( "1" ), SL( "2" ), SL( "-t" ), SL( "10" ),
+		SL( "--id=3" ), SL( "--id=-4" ) };
+
+	CmdLine cmd( argc, argv );
+
+	TypedMultiArg< int > id( Char( SL( 'i' ) ), String( SL( "id" ) ) );
+	Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+
+	id.reserve( 16 );
+
+	cmd.addArg( id );
+	cmd.addArg( timeout );
+
+	cmd.parse();
+
+	const Span< const int > values = id.values();
+
+	CHECK_CONDITION( id.isDefined() )
+	CHECK_CONDITION( id.isWithValue() )
+	CHECK_CONDITION( id.count() == 4 )
+	CHECK_CONDITION( values.size() == 4 )
+	CHECK_CONDITION( values[ 0 ] == 1 && values[ 1 ] == 2 &&
+		values[ 2 ] == 3 && values[ 3 ] == -4 )
+	CHECK_CONDITION( values.data() + 3 == &values.back() )
+	CHECK_CONDITION( timeout.value() == SL( "10" ) )
+
+	const CHAR * argv2[ 3 ] = { SL( "program.exe" ),
+		SL( "-i" ), SL( "5" ) };
+
+	cmd.parse( 3, argv2 );
+
+	CHECK_CONDITION( id.count() == 1 && id.values().front() == 5 )
+	CHECK_CONDITION( id.values().data() == values.data() )
+}
+
+TEST( MultiArgTestCase, TestTypedMultiArgWithValueHandler )
+{
+	const int argc = 4;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-i" ), SL( "1" ), SL( "2" ) };
+
+	CmdLine cmd( argc, argv );
+
+	TypedMultiArg< int > id( Char( SL( 'i' ) ) );
+
+	cmd.addArg( id );
+
+	int handled = 0;
+
+	auto onValue = [ &handled ] ( const StringView & )
+		{ ++handled; };
+
+	id.setValueHandler( onValue );
+
+	cmd.parse();
+
+	CHECK_CONDITION( handled == 2 )
+	CHECK_CONDITION( id.values().size() == 0 )
+	CHECK_CONDITION( id.count() == 2 )
+
+	const CHAR * argv2[ 3 ] = { SL( "program.exe" ),
+		SL( "-i" ), SL( "3" ) };
+
+	cmd.parse( 3, argv2 );
+
+	CHECK_CONDITION( handled == 3 )
+	CHECK_CONDITION( id.count() == 1 )
+}
+
+TEST( MultiArgTestCase, TestTypedMultiArgInvalidValue )
+{
+	const int argc = 5;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "--size" ), SL( "1.5" ), SL( "x" ), SL( "2" ) };
+
+	CmdLine cmd( argc, argv );
+
+	TypedMultiArg< double > size( String( SL( "size" ) ), true );
+
+	cmd.addArg( size );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( !cmd.parse( status ) )
+	CHECK_CONDITION( status.error() == ParseError::InvalidValue )
+	CHECK_CONDITION( status.argument() == &size )
+	CHECK_CONDITION( status.token() == 2 )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Value \"x\" of argument \"--size\" is invalid." ) ) )
+
+	const CHAR * argv2[ 2 ] = { SL( "program.exe" ), SL( "--size" ) };
+
+	CHECK_THROW( cmd.parse( 2, argv2 ), BaseException )
+}
+
 
 int main()
 {
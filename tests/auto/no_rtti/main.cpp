@@ -0,0 +1,204 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+/*
+	This test is built with disabled RTTI.
+*/
+
+TEST( NoRttiCase, TestKind )
+{
+	Arg a( Char( SL( 'a' ) ) );
+	MultiArg m( Char( SL( 'm' ) ) );
+	ArgAsCommand c( SL( "file" ) );
+	Command add( SL( "add" ) );
+	OnlyOneGroup g1( SL( "g1" ) );
+	AllOfGroup g2( SL( "g2" ) );
+	AtLeastOneGroup g3( SL( "g3" ) );
+
+	CHECK_CONDITION( a.kind() == ArgKind::Argument )
+	CHECK_CONDITION( m.kind() == ArgKind::Argument )
+	CHECK_CONDITION( c.kind() == ArgKind::Argument )
+	CHECK_CONDITION( add.kind() == ArgKind::Command )
+	CHECK_CONDITION( g1.kind() == ArgKind::OnlyOneGroup )
+	CHECK_CONDITION( g2.kind() == ArgKind::AllOfGroup )
+	CHECK_CONDITION( g3.kind() == ArgKind::AtLeastOneGroup )
+
+	CHECK_CONDITION( details::asCommand( &add ) == &add )
+	CHECK_CONDITION( details::asCommand( &g1 ) == nullptr )
+	CHECK_CONDITION( details::asCommand( &a ) == nullptr )
+	CHECK_CONDITION( details::asGroup( &g2 ) == &g2 )
+	CHECK_CONDITION( details::asGroup( &add ) == &add )
+	CHECK_CONDITION( details::asGroup( &m ) == nullptr )
+
+	ArgIface & cmd = add;
+
+	CHECK_THROW( g1.addArg( cmd ), BaseException )
+}
+
+TEST( NoRttiCase, TestParse )
+{
+	const int argc = 7;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-v" ), SL( "add" ), SL( "b.txt" ), SL( "-f" ), SL( "a.txt" ),
+		SL( "--force" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg verbose( Char( SL( 'v' ) ) );
+	Arg quiet( Char( SL( 'q' ) ) );
+	OnlyOneGroup g( SL( "output" ) );
+	Command add( SL( "add" ), ValueOptions::ManyValues );
+	Command remove( SL( "remove" ) );
+	Arg file( Char( SL( 'f' ) ), true );
+	Arg force( String( SL( "force" ) ) );
+
+	g.addArg( verbose );
+	g.addArg( quiet );
+	add.addArg( file );
+	add.addArg( force );
+
+	cmd.addArg( g );
+	cmd.addArg( add );
+	cmd.addArg( remove );
+
+	cmd.parse();
+
+	CHECK_CONDITION( verbose.isDefined() )
+	CHECK_CONDITION( !quiet.isDefined() )
+	CHECK_CONDITION( add.isDefined() )
+	CHECK_CONDITION( !remove.isDefined() )
+	CHECK_CONDITION( file.value() == SL( "a.txt" ) )
+	CHECK_CONDITION( force.isDefined() )
+	CHECK_CONDITION( add.values().size() == 1 )
+	CHECK_CONDITION( add.values().front() == SL( "b.txt" ) )
+	CHECK_CONDITION( cmd.findArgument( SL( "add" ) ) == &add )
+}
+
+TEST( NoRttiCase, TestErrors )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "add" ), SL( "remove" ) };
+
+	{
+		CmdLine cmd( argc, argv );
+
+		Command add( SL( "add" ) );
+		Command remove( SL( "remove" ) );
+
+		cmd.addArg( add );
+		cmd.addArg( remove );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::OnlyOneCommand )
+	}
+
+	{
+		CmdLine cmd( 1, argv );
+
+		Arg a( Char( SL( 'a' ) ) );
+		a.setRequired( true );
+		AllOfGroup g( SL( "g" ) );
+		g.addArg( a );
+
+		cmd.addArg( g );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::RequiredArgumentInGroup )
+		CHECK_CONDITION( status.description() ==
+			String( SL( "Required argument \"-a\" is not allowed to be in "
+				"AllOf group \"g\"." ) ) )
+	}
+}
+
+TEST( NoRttiCase, TestHelp )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-h" ), SL( "add" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg file( Char( SL( 'f' ) ), String( SL( "file" ) ), true );
+	AllOfGroup g( SL( "g" ) );
+	Arg a( Char( SL( 'a' ) ) );
+	Command add( SL( "add" ) );
+	Help help;
+
+	g.addArg( a );
+	add.addArg( file );
+
+	cmd.addArg( g );
+	cmd.addArg( add );
+	cmd.addArg( help );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.isHelpPrinted() )
+}
+
+TEST( NoRttiCase, TestMemoryResource )
+{
+	NewDeleteResource resource;
+	MonotonicBuffer buffer;
+
+	CHECK_CONDITION( newDeleteResource()->isEqual( resource ) )
+	CHECK_CONDITION( resource.isEqual( *newDeleteResource() ) )
+	CHECK_CONDITION( !resource.isEqual( buffer ) )
+	CHECK_CONDITION( buffer.isEqual( buffer ) )
+}
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+
+TEMPLATE = app
+CONFIG += console c++14
+CONFIG -= rtti
+QT -= core gui
+
+INCLUDEPATH = ../../..
+
+include( ../../../config.pri )
+
+SOURCES = main.cpp
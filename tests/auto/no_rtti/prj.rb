@@ -0,0 +1,11 @@
+
+require 'mxx_ru/cpp'
+
+Mxx_ru::Cpp::exe_target {
+    
+	target( "tests/test.no_rtti" )
+
+	rtti_mode( Mxx_ru::Cpp::RTTI_DISABLED )
+
+	cpp_source( "main.cpp" )
+}
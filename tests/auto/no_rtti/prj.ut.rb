@@ -0,0 +1,7 @@
+
+require 'mxx_ru/binary_unittest'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"tests/auto/no_rtti/prj.ut.rb",
+		"tests/auto/no_rtti/prj.rb" ) )
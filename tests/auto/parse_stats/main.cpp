@@ -0,0 +1,157 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define ARGS_ENABLE_PARSE_STATS
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+// C++ include.
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+//! Write file.
+void writeFile( const char * name, const std::string & content )
+{
+	std::ofstream stream( name, std::ios::binary | std::ios::trunc );
+
+	stream.write( content.data(), static_cast< std::streamsize > ( content.size() ) );
+}
+
+
+TEST( ParseStatsCase, TestCounters )
+{
+	const int argc = 7;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-ab" ), SL( "--host=localhost" ), SL( "--files" ), SL( "1" ),
+		SL( "2" ), SL( "run" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ) );
+	Arg host( String( SL( "host" ) ), true );
+	MultiArg files( String( SL( "files" ) ), true );
+	Command run( SL( "run" ) );
+
+	cmd.addArg( a );
+	cmd.addArg( b );
+	cmd.addArg( host );
+	cmd.addArg( files );
+	cmd.addArg( run );
+
+	cmd.parse();
+
+	const ParseStats & stats = cmd.parseStats();
+
+	// "-ab", "--host=", "localhost", "--files", "1", "2", "run".
+	CHECK_CONDITION( stats.m_tokens == 7 )
+	// "-a", "-b", "--host", "--files", "1", "2", "run" and lookup of
+	// the word after "2" is not done because it's the command.
+	CHECK_CONDITION( stats.m_findArgumentProbes >= 6 )
+	CHECK_CONDITION( stats.m_beforeParsingTime.count() > 0 )
+	CHECK_CONDITION( stats.m_tokenLoopTime.count() > 0 )
+	CHECK_CONDITION( stats.m_valuesTime.count() > 0 )
+	CHECK_CONDITION( stats.m_valuesTime <= stats.m_tokenLoopTime )
+	CHECK_CONDITION( stats.m_afterParsingTime.count() > 0 )
+
+	// Values are copied only on access.
+	CHECK_CONDITION( host.value() == SL( "localhost" ) )
+	CHECK_CONDITION( files.values().size() == 2 )
+
+	const std::size_t tokens = stats.m_tokens;
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( argc, argv, status ) )
+	CHECK_CONDITION( cmd.parseStats().m_tokens == tokens * 2 )
+
+	cmd.resetParseStats();
+
+	CHECK_CONDITION( cmd.parseStats().m_tokens == 0 )
+	CHECK_CONDITION( cmd.parseStats().m_tokenLoopTime.count() == 0 )
+}
+
+TEST( ParseStatsCase, TestGroupsAndCopies )
+{
+	writeFile( "stats.txt", "ab\ncde\n" );
+
+	const std::vector< String > words = { SL( "--files" ), SL( "-" ),
+		SL( "--dir" ), SL( "d" ) };
+
+	CmdLine cmd( words );
+
+	MultiArg files( String( SL( "files" ) ), true );
+	Arg dir( String( SL( "dir" ) ), true );
+	OnlyOneGroup g( SL( "group" ) );
+
+	g.addArg( files );
+	g.addArg( dir );
+
+	cmd.addArg( g );
+
+	std::FILE * file = std::fopen( "stats.txt", "rb" );
+
+	StreamSource source( fileno( file ) );
+	files.setStream( &source );
+
+	ParseStatus status;
+
+	// Only one argument of the group is allowed.
+	CHECK_CONDITION( !cmd.parse( status ) )
+
+	std::fclose( file );
+
+	// Words of the stream are copied, words of the container are not.
+	CHECK_CONDITION( cmd.parseStats().m_bytesCopied == 5 * sizeof( Char ) )
+	CHECK_CONDITION( cmd.parseStats().m_tokens == 4 )
+}
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
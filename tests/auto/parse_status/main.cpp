@@ -0,0 +1,505 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+// C++ include.
+#include <algorithm>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+TEST( ParseStatusCase, TestAllIsOk )
+{
+	const int argc = 4;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "--port" ), SL( "4545" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg port( SL( "port" ), true );
+
+	cmd.addArg( a );
+	cmd.addArg( port );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == true )
+	CHECK_CONDITION( status.isOk() == true )
+	CHECK_CONDITION( status.error() == ParseError::None )
+	CHECK_CONDITION( status.token() == ParseStatus::npos )
+
+	CHECK_CONDITION( a.isDefined() == true )
+	CHECK_CONDITION( port.value() == SL( "4545" ) )
+}
+
+TEST( ParseStatusCase, TestUnknownArgument )
+{
+	const int argc = 4;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "--host=localhost" ), SL( "--port" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg port( SL( "port" ), true );
+
+	cmd.addArg( a );
+	cmd.addArg( port );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.isOk() == false )
+	CHECK_CONDITION( status.isHelpPrinted() == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	CHECK_CONDITION( status.token() == 1 )
+	CHECK_CONDITION( status.word() == SL( "--host" ) )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Unknown argument \"--host\"." ) ) )
+}
+
+TEST( ParseStatusCase, TestValueRequired )
+{
+	const int argc = 5;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "--port=" ), SL( "-b" ), SL( "--port" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ) );
+	Arg port( SL( "port" ), true );
+
+	cmd.addArg( a );
+	cmd.addArg( b );
+	cmd.addArg( port );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::ValueRequired )
+	CHECK_CONDITION( status.token() == 1 )
+	CHECK_CONDITION( status.argument() == &port )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Argument \"--port\" require value that wasn't presented." ) ) )
+}
+
+TEST( ParseStatusCase, TestFlagsCombo )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "-vbc=100" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ), true );
+	Arg c( Char( SL( 'c' ) ), true );
+
+	cmd.addArg( a );
+	cmd.addArg( b );
+	cmd.addArg( c );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	CHECK_CONDITION( status.token() == 1 )
+	CHECK_CONDITION( status.word() == SL( "-v" ) )
+}
+
+TEST( ParseStatusCase, TestValueInFlagsCombo )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "-bc=100" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ), true );
+	Arg c( Char( SL( 'c' ) ), true );
+
+	cmd.addArg( a );
+	cmd.addArg( b );
+	cmd.addArg( c );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::ValueInFlagsCombo )
+	CHECK_CONDITION( status.token() == 1 )
+	CHECK_CONDITION( status.word() == SL( "-bc" ) )
+}
+
+TEST( ParseStatusCase, TestUndefinedRequired )
+{
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg port( SL( "port" ), true, true );
+
+	cmd.addArg( a );
+	cmd.addArg( port );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UndefinedRequiredArgument )
+	CHECK_CONDITION( status.token() == ParseStatus::npos )
+	CHECK_CONDITION( status.argument() == &port )
+}
+
+TEST( ParseStatusCase, TestRedefinition )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( SL( 'a' ), String( SL( "host" ) ) );
+	Arg b( SL( 'a' ), String( SL( "port" ) ) );
+
+	cmd.addArg( a );
+	cmd.addArg( b );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::FlagRedefinition )
+	CHECK_CONDITION( status.argument() == &b )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Redefinition of argument with flag \"-a\"." ) ) )
+}
+
+TEST( ParseStatusCase, TestOnlyOneGroup )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "-b" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ) );
+
+	OnlyOneGroup g( SL( "only" ) );
+	g.addArg( a );
+	g.addArg( b );
+
+	cmd.addArg( g );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::OnlyOneGroupViolation )
+	CHECK_CONDITION( status.argument() == &a )
+	CHECK_CONDITION( status.otherArgument() == &b )
+	CHECK_CONDITION( status.group() == &g )
+}
+
+TEST( ParseStatusCase, TestHelp )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-h" ), SL( "-a" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Help help;
+
+	cmd.addArg( a );
+	cmd.addArg( help );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.isHelpPrinted() == true )
+	CHECK_CONDITION( status.argument() == &help )
+}
+
+TEST( ParseStatusCase, TestThrowingParse )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-h" ), SL( "-a" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Help help;
+
+	cmd.addArg( a );
+	cmd.addArg( help );
+
+	CHECK_THROW( cmd.parse(), HelpHasBeenPrintedException )
+}
+
+
+//! Argument written before parsing without exceptions.
+class OldStyleArg final
+	:	public ArgIface
+{
+public:
+	explicit OldStyleArg( Char flag, bool required = false )
+		:	m_flag( 1, flag )
+		,	m_key( String( SL( "-" ) ) + m_flag )
+		,	m_required( required )
+		,	m_defined( false )
+	{
+	}
+
+	//! \return Value.
+	const String & value() const
+	{
+		return m_value;
+	}
+
+	const String & name() const override
+	{
+		return m_key;
+	}
+
+	bool isWithValue() const override
+	{
+		return true;
+	}
+
+	bool isRequired() const override
+	{
+		return m_required;
+	}
+
+	bool isDefined() const override
+	{
+		return m_defined;
+	}
+
+	const String & flag() const override
+	{
+		return m_flag;
+	}
+
+	const String & argumentName() const override
+	{
+		return m_empty;
+	}
+
+	const String & valueSpecifier() const override
+	{
+		return m_empty;
+	}
+
+	const String & description() const override
+	{
+		return m_empty;
+	}
+
+	const String & longDescription() const override
+	{
+		return m_empty;
+	}
+
+protected:
+	ArgIface * isItYou( const String & name ) override
+	{
+		return ( name == m_key ? this : nullptr );
+	}
+
+	void process( Context & context ) override
+	{
+		if( context.atEnd() )
+			throw BaseException( String( SL( "No value." ) ) );
+
+		m_value = context.next()->toString();
+
+		if( m_value == SL( "bad" ) )
+			throw BaseException( String( SL( "Bad value." ) ) );
+
+		m_defined = true;
+	}
+
+	void checkCorrectnessBeforeParsing( StringList & flags,
+		StringList & ) const override
+	{
+		if( std::find( flags.cbegin(), flags.cend(), m_key ) != flags.cend() )
+			throw BaseException( String( SL( "Redefinition of " ) ) + m_key );
+
+		flags.push_back( m_key );
+	}
+
+	void checkCorrectnessAfterParsing() const override
+	{
+		if( m_required && !m_defined )
+			throw BaseException( String( SL( "Undefined " ) ) + m_key );
+	}
+
+private:
+	//! Flag.
+	String m_flag;
+	//! Key of the flag.
+	String m_key;
+	//! Value.
+	String m_value;
+	//! Empty string.
+	String m_empty;
+	//! Is required?
+	bool m_required;
+	//! Is defined?
+	bool m_defined;
+}; // class OldStyleArg
+
+TEST( ParseStatusCase, TestOldStyleArg )
+{
+	{
+		const int argc = 4;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ),
+			SL( "-o" ), SL( "good" ), SL( "-a" ) };
+
+		CmdLine cmd( argc, argv );
+
+		Arg a( Char( SL( 'a' ) ) );
+		OldStyleArg o( Char( SL( 'o' ) ) );
+
+		cmd.addArg( a );
+		cmd.addArg( o );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == true )
+		CHECK_CONDITION( o.isDefined() == true )
+		CHECK_CONDITION( o.value() == SL( "good" ) )
+		CHECK_CONDITION( a.isDefined() == true )
+	}
+
+	{
+		const int argc = 3;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ),
+			SL( "-o" ), SL( "bad" ) };
+
+		CmdLine cmd( argc, argv );
+
+		OldStyleArg o( Char( SL( 'o' ) ) );
+
+		cmd.addArg( o );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::ArgumentException )
+		CHECK_CONDITION( status.argument() == &o )
+		CHECK_CONDITION( status.token() == 0 )
+		CHECK_CONDITION( status.description() == SL( "Bad value." ) )
+
+		CHECK_THROW( cmd.parse( argc, argv ), BaseException )
+	}
+
+	{
+		const int argc = 1;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+		CmdLine cmd( argc, argv );
+
+		OldStyleArg o( Char( SL( 'o' ) ), true );
+
+		cmd.addArg( o );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::ArgumentException )
+		CHECK_CONDITION( status.description() == SL( "Undefined -o" ) )
+	}
+}
+
+TEST( ParseStatusCase, TestOldStyleArgRedefinition )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	{
+		CmdLine cmd( argc, argv );
+
+		Arg a( Char( SL( 'a' ) ) );
+		OldStyleArg o( Char( SL( 'a' ) ) );
+
+		cmd.addArg( a );
+		cmd.addArg( o );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::ArgumentException )
+		CHECK_CONDITION( status.argument() == &o )
+		CHECK_CONDITION( status.description() == SL( "Redefinition of -a" ) )
+	}
+
+	{
+		CmdLine cmd( argc, argv );
+
+		OldStyleArg o( Char( SL( 'a' ) ) );
+		Arg a( Char( SL( 'a' ) ) );
+
+		cmd.addArg( o );
+		cmd.addArg( a );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::FlagRedefinition )
+		CHECK_CONDITION( status.argument() == &a )
+	}
+}
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
@@ -0,0 +1,7 @@
+
+require 'mxx_ru/binary_unittest'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"tests/auto/parse_status/prj.ut.rb",
+		"tests/auto/parse_status/prj.rb" ) )
@@ -0,0 +1,390 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+TEST( ResetCase, TestReparse )
+{
+	const int argc = 7;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "--port" ), SL( "4545" ), SL( "-m" ),
+		SL( "1" ), SL( "2" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg port( SL( "port" ), true );
+	MultiArg m( Char( SL( 'm' ) ), true );
+	MultiArg v( Char( SL( 'v' ) ) );
+
+	cmd.addArg( a );
+	cmd.addArg( port );
+	cmd.addArg( m );
+	cmd.addArg( v );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == true )
+	CHECK_CONDITION( a.isDefined() == true )
+	CHECK_CONDITION( port.value() == SL( "4545" ) )
+	CHECK_CONDITION( m.count() == 2 )
+
+	const int argc2 = 6;
+	const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+		SL( "--port=80" ), SL( "-vv" ), SL( "-m" ), SL( "3" ), SL( "-v" ) };
+
+#ifndef ARGS_QSTRING_BUILD
+	const Char * portBuffer = port.value().data();
+#endif
+
+	CHECK_CONDITION( cmd.parse( argc2, argv2, status ) == true )
+	CHECK_CONDITION( a.isDefined() == false )
+	CHECK_CONDITION( port.value() == SL( "80" ) )
+	CHECK_CONDITION( m.count() == 1 )
+	CHECK_CONDITION( m.value() == SL( "3" ) )
+	CHECK_CONDITION( v.count() == 3 )
+
+#ifndef ARGS_QSTRING_BUILD
+	CHECK_CONDITION( port.value().data() == portBuffer )
+#endif
+
+	cmd.reset();
+
+	CHECK_CONDITION( port.isDefined() == false )
+	CHECK_CONDITION( port.value().empty() == true )
+	CHECK_CONDITION( m.values().empty() == true )
+	CHECK_CONDITION( v.count() == 0 )
+}
+
+TEST( ResetCase, TestReparseCommand )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "add" ), SL( "file.txt" ) };
+
+	CmdLine cmd( argc, argv, CmdLine::CommandIsRequired );
+
+	Command add( SL( "add" ), ValueOptions::OneValue );
+	Command remove( SL( "remove" ), ValueOptions::ManyValues );
+	Arg force( Char( SL( 'f' ) ) );
+
+	remove.addArg( force );
+
+	cmd.addArg( add );
+	cmd.addArg( remove );
+
+	cmd.parse();
+
+	CHECK_CONDITION( add.isDefined() == true )
+	CHECK_CONDITION( add.value() == SL( "file.txt" ) )
+
+	const int argc2 = 5;
+	const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+		SL( "remove" ), SL( "1.txt" ), SL( "2.txt" ), SL( "-f" ) };
+
+	cmd.parse( argc2, argv2 );
+
+	CHECK_CONDITION( add.isDefined() == false )
+	CHECK_CONDITION( add.values().empty() == true )
+	CHECK_CONDITION( remove.isDefined() == true )
+	CHECK_CONDITION( remove.values().size() == 2 )
+	CHECK_CONDITION( force.isDefined() == true )
+
+	const int argc3 = 1;
+	const CHAR * argv3[ argc3 ] = { SL( "program.exe" ) };
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( argc3, argv3, status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::CommandNotSpecified )
+	CHECK_CONDITION( remove.isDefined() == false )
+	CHECK_CONDITION( force.isDefined() == false )
+}
+
+TEST( ResetCase, TestSeal )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "add" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ) );
+	Command add( SL( "add" ) );
+	OnlyOneGroup g( SL( "g" ) );
+	Arg c( Char( SL( 'c' ) ) );
+	Arg d( Char( SL( 'd' ) ) );
+
+	g.addArg( c );
+	add.addArg( g );
+
+	cmd.addArg( a );
+	cmd.addArg( add );
+
+	CHECK_CONDITION( cmd.isSealed() == false )
+
+	cmd.seal();
+
+	CHECK_CONDITION( cmd.isSealed() == true )
+
+	const std::size_t fingerprint = cmd.fingerprint();
+
+	CHECK_THROW( cmd.addArg( b ), BaseException )
+	CHECK_THROW( g.addArg( d ), BaseException )
+
+	CHECK_CONDITION( cmd.fingerprint() == fingerprint )
+
+	cmd.parse();
+
+	CHECK_CONDITION( a.isDefined() == true )
+	CHECK_CONDITION( add.isDefined() == true )
+
+	const int argc2 = 3;
+	const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+		SL( "add" ), SL( "-c" ) };
+
+	cmd.parse( argc2, argv2 );
+
+	CHECK_CONDITION( a.isDefined() == false )
+	CHECK_CONDITION( c.isDefined() == true )
+
+	// Sealed arguments can't be changed.
+	CHECK_THROW( c.setRequired(), BaseException )
+	CHECK_THROW( c.setWithValue(), BaseException )
+	CHECK_THROW( g.setRequired(), BaseException )
+
+	CHECK_CONDITION( c.isRequired() == false )
+	CHECK_CONDITION( c.isWithValue() == false )
+	CHECK_CONDITION( g.isRequired() == false )
+	CHECK_CONDITION( cmd.fingerprint() == fingerprint )
+}
+
+TEST( ResetCase, TestSealIncorrect )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'a' ) ), SL( "bb" ) );
+
+	cmd.addArg( a );
+	cmd.addArg( b );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.seal( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::FlagRedefinition )
+	CHECK_CONDITION( cmd.isSealed() == false )
+}
+
+TEST( ResetCase, TestLazyValues )
+{
+	const int argc = 5;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "--port" ), SL( "4545" ), SL( "-m" ), SL( "1" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg port( SL( "port" ), true );
+	MultiArg m( Char( SL( 'm' ) ), true );
+	Command c( SL( "run" ), ValueOptions::ManyValues );
+
+	cmd.addArg( port );
+	cmd.addArg( m );
+	cmd.addArg( c );
+
+	cmd.parse();
+
+	// Values of the first parsing are never read.
+	CHECK_CONDITION( port.isDefined() == true )
+
+	const int argc2 = 7;
+	const CHAR * argv2[ argc2 ] = { SL( "program.exe" ),
+		SL( "--port=80" ), SL( "-m" ), SL( "2" ), SL( "3" ),
+		SL( "run" ), SL( "x" ) };
+
+	cmd.parse( argc2, argv2 );
+
+	const StringList values = { SL( "2" ), SL( "3" ) };
+
+	CHECK_CONDITION( port.value() == SL( "80" ) )
+	CHECK_CONDITION( port.valueAs< int > () == 80 )
+	CHECK_CONDITION( m.values() == values )
+	CHECK_CONDITION( m.value() == SL( "2" ) )
+	CHECK_CONDITION( c.value() == SL( "x" ) )
+	CHECK_CONDITION( c.values().size() == 1 )
+}
+
+//! Argument derived by user without clear().
+class UserArg final
+	:	public ArgIface
+{
+public:
+	UserArg()
+		:	m_flag( SL( "u" ) )
+		,	m_key( SL( "-u" ) )
+		,	m_count( 0 )
+	{
+	}
+
+	//! \return How many times argument was found.
+	int count() const
+	{
+		return m_count;
+	}
+
+	const String & name() const override
+	{
+		return m_key;
+	}
+
+	bool isWithValue() const override
+	{
+		return false;
+	}
+
+	bool isRequired() const override
+	{
+		return false;
+	}
+
+	bool isDefined() const override
+	{
+		return m_count > 0;
+	}
+
+	const String & flag() const override
+	{
+		return m_flag;
+	}
+
+	const String & argumentName() const override
+	{
+		return m_empty;
+	}
+
+	const String & valueSpecifier() const override
+	{
+		return m_empty;
+	}
+
+	const String & description() const override
+	{
+		return m_empty;
+	}
+
+	const String & longDescription() const override
+	{
+		return m_empty;
+	}
+
+protected:
+	ArgIface * isItYou( const String & name ) override
+	{
+		return ( name == m_key ? this : nullptr );
+	}
+
+	ParseError tryProcess( Context & ) override
+	{
+		++m_count;
+
+		return ParseError::None;
+	}
+
+	ParseStatus tryCheckCorrectnessBeforeParsing( NameSet & flags,
+		NameSet & ) const override
+	{
+		if( !flags.insert( m_key ) )
+			return ParseStatus( ParseError::FlagRedefinition, this );
+
+		return ParseStatus();
+	}
+
+	ParseStatus tryCheckCorrectnessAfterParsing() const override
+	{
+		return ParseStatus();
+	}
+
+private:
+	//! Flag.
+	String m_flag;
+	//! Key of the flag.
+	String m_key;
+	//! Empty string.
+	String m_empty;
+	//! Counter.
+	int m_count;
+}; // class UserArg
+
+TEST( ResetCase, TestUserArgWithoutClear )
+{
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "-u" ) };
+
+	CmdLine cmd( argc, argv );
+
+	UserArg u;
+
+	cmd.addArg( u );
+
+	cmd.parse();
+
+	CHECK_CONDITION( u.count() == 1 )
+
+	cmd.parse( argc, argv );
+
+	// Default clear() keeps the state of the user's argument.
+	CHECK_CONDITION( u.count() == 2 )
+}
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
@@ -0,0 +1,337 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define ARGS_ENABLE_RESPONSE_FILES
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+// C++ include.
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+//! Write file.
+void writeFile( const char * name, const std::string & content )
+{
+	std::ofstream stream( name, std::ios::binary | std::ios::trunc );
+
+	stream.write( content.data(), static_cast< std::streamsize > ( content.size() ) );
+}
+
+//! \return Words of the context.
+std::vector< String > words( Context & context )
+{
+	std::vector< String > result;
+
+	for( auto it = context.begin(), last = context.end(); it != last; ++it )
+		result.push_back( it->toString() );
+
+	return result;
+}
+
+//! \return Tokens of the response file as strings.
+std::vector< std::string > tokenize( const std::string & content,
+	std::size_t chunkSize, std::size_t threads = 4 )
+{
+	std::vector< ResponseToken > tokens;
+
+	tokenizeResponseFile( content.data(), content.data() + content.size(),
+		tokens, chunkSize, threads );
+
+	std::vector< std::string > result;
+
+	for( const auto & t : tokens )
+	{
+		if( t.m_isQuoted )
+			result.push_back( unquoteResponseToken( t ) );
+		else
+			result.push_back( std::string( t.m_begin, t.m_end ) );
+	}
+
+	return result;
+}
+
+
+TEST( ResponseFileCase, TestTokenizer )
+{
+	const std::vector< std::string > tokens = tokenize(
+		"-a  --host\tlocalhost\r\n'my file' \"x y\" a\\ b \"q\\\"q\" 'un'quoted ''\n",
+		1024 );
+
+	const std::vector< std::string > expected = { "-a", "--host", "localhost",
+		"my file", "x y", "a b", "q\"q", "unquoted", "" };
+
+	CHECK_CONDITION( tokens == expected )
+
+	const std::vector< std::string > nul = tokenize(
+		std::string( "a b\0c\nd\0\0e", 10 ), 1024 );
+
+	const std::vector< std::string > expectedNul = { "a b", "c\nd", "e" };
+
+	CHECK_CONDITION( nul == expectedNul )
+}
+
+TEST( ResponseFileCase, TestParallelTokenizer )
+{
+	std::string content;
+
+	for( int i = 0; i < 10000; ++i )
+		content += "--value " + std::to_string( i ) + "\n";
+
+	const std::vector< std::string > sequential = tokenize( content, content.size() );
+
+	CHECK_CONDITION( sequential.size() == 20000 )
+	CHECK_CONDITION( tokenize( content, 4096 ) == sequential )
+	CHECK_CONDITION( tokenize( content, 4096, 1 ) == sequential )
+
+	// Escaped new lines are never the bounds of the chunks.
+	std::string escaped;
+
+	for( int i = 0; i < 10000; ++i )
+		escaped += "aaa\\\nbbb ccc\\\\\n";
+
+	const std::vector< std::string > unescaped = tokenize( escaped, escaped.size() );
+
+	CHECK_CONDITION( unescaped.size() == 20000 )
+	CHECK_CONDITION( unescaped[ 0 ] == "aaa\nbbb" )
+	CHECK_CONDITION( unescaped[ 1 ] == "ccc\\" )
+	CHECK_CONDITION( tokenize( escaped, 16 ) == unescaped )
+
+	// Quoted word crosses the bounds of the chunks.
+	std::string quoted = "'" + content + "' tail";
+
+	const std::vector< std::string > parallel = tokenize( quoted, 4096 );
+
+	CHECK_CONDITION( parallel.size() == 2 )
+	CHECK_CONDITION( parallel[ 0 ] == content )
+	CHECK_CONDITION( parallel[ 1 ] == "tail" )
+
+	std::string nul;
+
+	for( int i = 0; i < 10000; ++i )
+		nul += "/path/" + std::to_string( i ) + std::string( 1, '\0' );
+
+	const std::vector< std::string > paths = tokenize( nul, 4096 );
+
+	CHECK_CONDITION( paths.size() == 10000 )
+	CHECK_CONDITION( paths[ 9999 ] == "/path/9999" )
+}
+
+TEST( ResponseFileCase, TestExpand )
+{
+	writeFile( "response1.txt", "-a --host localhost @response2.txt\n"
+		"\"--name=my name\" --file @missing.txt" );
+	writeFile( "response2.txt", "-p 8080 run" );
+
+	const int argc = 4;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-t" ), SL( "@response1.txt" ), SL( "-v" ) };
+
+	CmdLine cmd( argc, argv,
+		CmdLine::ExpandResponseFiles | CmdLine::CommandIsRequired );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg t( Char( SL( 't' ) ) );
+	Arg v( Char( SL( 'v' ) ) );
+	Arg host( String( SL( "host" ) ), true );
+	Arg name( String( SL( "name" ) ), true );
+	Arg port( Char( SL( 'p' ) ), true );
+	Arg file( String( SL( "file" ) ), true );
+	Command run( SL( "run" ) );
+
+	cmd.addArg( a );
+	cmd.addArg( t );
+	cmd.addArg( v );
+	cmd.addArg( host );
+	cmd.addArg( name );
+	cmd.addArg( port );
+	cmd.addArg( file );
+	cmd.addArg( run );
+
+	cmd.parse();
+
+	CHECK_CONDITION( a.isDefined() && t.isDefined() && v.isDefined() )
+	CHECK_CONDITION( host.value() == SL( "localhost" ) )
+	CHECK_CONDITION( port.valueAs< int > () == 8080 )
+	CHECK_CONDITION( name.value() == SL( "my name" ) )
+	CHECK_CONDITION( file.value() == SL( "@missing.txt" ) )
+	CHECK_CONDITION( run.isDefined() )
+}
+
+TEST( ResponseFileCase, TestContext )
+{
+	writeFile( "response3.txt", "-a\n--host 'quoted' -- @response3.txt" );
+
+	const std::vector< String > argv = { SL( "@response3.txt" ), SL( "x" ),
+		SL( "--" ), SL( "@response3.txt" ) };
+
+	Context context;
+	context.assign( argv.cbegin(), argv.cend() );
+	context.expandResponseFiles();
+
+	const std::vector< String > expected = { SL( "-a" ), SL( "--host" ),
+		SL( "quoted" ), SL( "--" ), SL( "@response3.txt" ), SL( "x" ),
+		SL( "--" ), SL( "@response3.txt" ) };
+
+	CHECK_CONDITION( words( context ) == expected )
+
+#if !defined( ARGS_WSTRING_BUILD ) && !defined( ARGS_QSTRING_BUILD )
+	// Words are views into the mapped file.
+	auto it = context.begin();
+	const StringView first = *it++;
+	const StringView second = *it++;
+	const StringView third = *it++;
+
+	CHECK_CONDITION( second.data() == first.data() + 3 )
+	CHECK_CONDITION( third.data() == second.data() + 8 )
+#endif
+
+	CHECK_CONDITION( context.token( context.begin() + 4 ).kind() ==
+		TokenKind::Operand )
+}
+
+TEST( ResponseFileCase, TestEmptyFile )
+{
+	writeFile( "response7.txt", std::string() );
+
+	MappedFile file;
+
+	CHECK_CONDITION( file.open( "response7.txt" ) )
+	CHECK_CONDITION( file.data() != nullptr )
+	CHECK_CONDITION( file.size() == 0 )
+
+	file.close();
+
+	const int argc = 4;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-a" ), SL( "@response7.txt" ), SL( "-b" ) };
+
+	CmdLine cmd( argc, argv, CmdLine::ExpandResponseFiles );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Arg b( Char( SL( 'b' ) ) );
+
+	cmd.addArg( a );
+	cmd.addArg( b );
+
+	cmd.parse();
+
+	CHECK_CONDITION( a.isDefined() && b.isDefined() )
+}
+
+TEST( ResponseFileCase, TestNotEnabled )
+{
+	writeFile( "response4.txt", "-a" );
+
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "@response4.txt" ) };
+
+	CmdLine cmd( argc, argv, CmdLine::CommandIsRequired );
+
+	Arg a( Char( SL( 'a' ) ) );
+	Command c( SL( "response4" ) );
+
+	cmd.addArg( a );
+	cmd.addArg( c );
+
+	CHECK_THROW( cmd.parse(), BaseException )
+}
+
+TEST( ResponseFileCase, TestRecursion )
+{
+	writeFile( "response5.txt", "-a @response5.txt" );
+
+	const std::vector< String > argv = { SL( "@response5.txt" ) };
+
+	Context context;
+	context.assign( argv.cbegin(), argv.cend() );
+	context.expandResponseFiles( 3 );
+
+	const std::vector< String > expected = { SL( "-a" ), SL( "-a" ),
+		SL( "-a" ), SL( "@response5.txt" ) };
+
+	CHECK_CONDITION( words( context ) == expected )
+}
+
+TEST( ResponseFileCase, TestValuesOutliveCmdLine )
+{
+	writeFile( "response6.txt", "--name 'my name' --host=localhost\n"
+		"-m a \"b c\" run x" );
+
+	Arg name( String( SL( "name" ) ), true );
+	Arg host( String( SL( "host" ) ), true );
+	MultiArg m( Char( SL( 'm' ) ), true );
+	Command run( SL( "run" ), ValueOptions::ManyValues );
+
+	{
+		const int argc = 2;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ),
+			SL( "@response6.txt" ) };
+
+		CmdLine cmd( argc, argv, CmdLine::ExpandResponseFiles );
+
+		cmd.addArg( name );
+		cmd.addArg( host );
+		cmd.addArg( m );
+		cmd.addArg( run );
+
+		cmd.parse();
+	}
+
+	const StringList values = { SL( "a" ), SL( "b c" ) };
+	const StringList runValues = { SL( "x" ) };
+
+	CHECK_CONDITION( name.value() == SL( "my name" ) )
+	CHECK_CONDITION( host.value() == SL( "localhost" ) )
+	CHECK_CONDITION( m.values() == values )
+	CHECK_CONDITION( run.values() == runValues )
+}
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
@@ -0,0 +1,451 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+constexpr StaticArgSpec c_specs[] = {
+	staticArg( SL( 'v' ), SL( "verbose" ) ),
+	staticArg( SL( 't' ), SL( "timeout" ) ).withValue(),
+	staticArg( SL( "config" ) ).withValue().required(),
+	staticCommand( SL( "add" ) ),
+	staticArg( SL( 'f' ), SL( "file" ) ).withValue().in( SL( "add" ) ),
+	staticGroup( SL( "mode" ) ).in( SL( "add" ) ),
+	staticArg( SL( 'r' ) ).in( SL( "mode" ) ),
+	staticArg( SL( 'w' ) ).in( SL( "mode" ) ),
+	staticCommand( SL( "remove" ) ),
+	staticArg( SL( 'f' ), SL( "file" ) ).withValue().in( SL( "remove" ) ),
+	staticArgAsCommand( SL( "list" ) )
+};
+
+ARGS_STATIC_SCHEMA( c_schema, c_specs )
+
+
+constexpr StaticArgSpec c_flagRedefinition[] = {
+	staticArg( SL( 'a' ) ), staticArg( SL( 'a' ), SL( "all" ) ) };
+
+static_assert( makeStaticSchema( c_flagRedefinition ).error() ==
+	StaticSchemaError::FlagRedefinition, "" );
+
+constexpr StaticArgSpec c_nameRedefinition[] = {
+	staticCommand( SL( "add" ) ), staticArg( SL( 'a' ), SL( "file" ) ),
+	staticArg( SL( "file" ) ).in( SL( "add" ) ) };
+
+static_assert( makeStaticSchema( c_nameRedefinition ).error() ==
+	StaticSchemaError::NameRedefinition, "" );
+
+constexpr StaticArgSpec c_disallowedName[] = {
+	staticArg( SL( 'a' ), SL( "my file" ) ) };
+
+static_assert( makeStaticSchema( c_disallowedName ).error() ==
+	StaticSchemaError::DisallowedName, "" );
+
+constexpr StaticArgSpec c_requiredInGroup[] = {
+	staticGroup( SL( "g" ) ), staticArg( SL( 'a' ) ).required().in( SL( "g" ) ) };
+
+static_assert( makeStaticSchema( c_requiredInGroup ).error() ==
+	StaticSchemaError::RequiredArgumentInGroup, "" );
+
+constexpr StaticArgSpec c_unknownParent[] = {
+	staticArg( SL( 'a' ) ).in( SL( "g" ) ) };
+
+static_assert( makeStaticSchema( c_unknownParent ).error() ==
+	StaticSchemaError::UnknownParent, "" );
+
+
+constexpr StaticArgSpec c_repeatedSpecs[] = {
+	staticArg( SL( 'v' ) ),
+	staticCommand( SL( "a" ) ),
+	staticArg( SL( 'k' ) ).in( SL( "a" ) ),
+	staticArg( SL( 'l' ) ).in( SL( "a" ) ),
+	staticArg( SL( 'N' ) ).in( SL( "a" ) ),
+	staticCommand( SL( "b" ) ),
+	staticArg( SL( 'k' ) ).in( SL( "b" ) ),
+	staticArg( SL( 'l' ) ).in( SL( "b" ) ),
+	staticArg( SL( 'N' ) ).in( SL( "b" ) ),
+	staticCommand( SL( "c" ) ),
+	staticArg( SL( 'k' ) ).in( SL( "c" ) ),
+	staticArg( SL( 'l' ) ).in( SL( "c" ) ),
+	staticArg( SL( 'N' ) ).in( SL( "c" ) )
+};
+
+ARGS_STATIC_SCHEMA( c_repeatedSchema, c_repeatedSpecs )
+
+
+constexpr StaticArgSpec c_groupAndWordSpecs[] = {
+	staticGroup( SL( "list" ) ),
+	staticArg( SL( 'a' ) ).in( SL( "list" ) ),
+	staticArgAsCommand( SL( "list" ) )
+};
+
+ARGS_STATIC_SCHEMA( c_groupAndWordSchema, c_groupAndWordSpecs )
+
+
+//! Arguments of the schema.
+class Schema {
+public:
+	Schema( CmdLine & cmd )
+		:	verbose( Char( SL( 'v' ) ), SL( "verbose" ) )
+		,	timeout( Char( SL( 't' ) ), SL( "timeout" ), true )
+		,	config( SL( "config" ), true, true )
+		,	add( SL( "add" ) )
+		,	addFile( Char( SL( 'f' ) ), SL( "file" ), true )
+		,	mode( SL( "mode" ) )
+		,	r( Char( SL( 'r' ) ) )
+		,	w( Char( SL( 'w' ) ) )
+		,	remove( SL( "remove" ) )
+		,	removeFile( Char( SL( 'f' ) ), SL( "file" ), true )
+		,	list( SL( "list" ) )
+	{
+		mode.addArg( r );
+		mode.addArg( w );
+		add.addArg( addFile );
+		add.addArg( mode );
+		remove.addArg( removeFile );
+
+		cmd.addArg( verbose );
+		cmd.addArg( timeout );
+		cmd.addArg( config );
+		cmd.addArg( add );
+		cmd.addArg( remove );
+		cmd.addArg( list );
+	}
+
+	Arg verbose;
+	Arg timeout;
+	Arg config;
+	Command add;
+	Arg addFile;
+	OnlyOneGroup mode;
+	Arg r;
+	Arg w;
+	Command remove;
+	Arg removeFile;
+	ArgAsCommand list;
+}; // class Schema
+
+
+TEST( StaticSchemaCase, TestParse )
+{
+	const int argc = 8;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-v" ), SL( "--config=cfg" ), SL( "-t" ), SL( "100" ),
+		SL( "add" ), SL( "-rf" ), SL( "file.txt" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Schema s( cmd );
+
+	cmd.setSchema( c_schema );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == true )
+	CHECK_CONDITION( s.verbose.isDefined() == true )
+	CHECK_CONDITION( s.config.value() == SL( "cfg" ) )
+	CHECK_CONDITION( s.timeout.value() == SL( "100" ) )
+	CHECK_CONDITION( s.add.isDefined() == true )
+	CHECK_CONDITION( s.r.isDefined() == true )
+	CHECK_CONDITION( s.w.isDefined() == false )
+	CHECK_CONDITION( s.addFile.value() == SL( "file.txt" ) )
+	CHECK_CONDITION( s.removeFile.isDefined() == false )
+	CHECK_CONDITION( cmd.findArgument( SL( "--file" ) ) == &s.addFile )
+	CHECK_CONDITION( cmd.tryFindArgument( SL( "--files" ) ) == nullptr )
+	CHECK_CONDITION( cmd.tryFindArgument( SL( "list" ) ) == &s.list )
+}
+
+TEST( StaticSchemaCase, TestErrors )
+{
+	{
+		const int argc = 5;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ),
+			SL( "--config" ), SL( "cfg" ), SL( "-f" ), SL( "file.txt" ) };
+
+		CmdLine cmd( argc, argv );
+
+		Schema s( cmd );
+
+		cmd.setSchema( c_schema );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+		CHECK_CONDITION( status.token() == 2 )
+	}
+
+	{
+		const int argc = 3;
+		const CHAR * argv[ argc ] = { SL( "program.exe" ),
+			SL( "remove" ), SL( "-r" ) };
+
+		CmdLine cmd( argc, argv );
+
+		Schema s( cmd );
+
+		cmd.setSchema( c_schema );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	}
+}
+
+TEST( StaticSchemaCase, TestSuggestions )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "add" ), SL( "--fil" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Schema s( cmd );
+
+	cmd.setSchema( c_schema );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	CHECK_CONDITION( status.candidates().size() == 1 )
+	CHECK_CONDITION( status.candidates().front() == SL( "--file" ) )
+
+	const CHAR * argv2[ 2 ] = { SL( "program.exe" ), SL( "remve" ) };
+
+	CHECK_CONDITION( cmd.parse( 2, argv2, status ) == false )
+	CHECK_CONDITION( status.candidates().size() == 1 )
+	CHECK_CONDITION( status.candidates().front() == SL( "remove" ) )
+}
+
+TEST( StaticSchemaCase, TestMismatch )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	{
+		CmdLine cmd( argc, argv );
+
+		Schema s( cmd );
+
+		Arg unknown( SL( "unknown" ) );
+
+		cmd.addArg( unknown );
+
+		cmd.setSchema( c_schema );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::SchemaMismatch )
+		CHECK_CONDITION( status.argument() == &unknown )
+	}
+
+	{
+		CmdLine cmd( argc, argv );
+
+		Arg verbose( Char( SL( 'v' ) ), SL( "verbose" ), true );
+
+		cmd.addArg( verbose );
+
+		cmd.setSchema( c_schema );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::SchemaMismatch )
+		CHECK_CONDITION( status.argument() == &verbose )
+	}
+
+	{
+		CmdLine cmd( argc, argv );
+
+		Arg verbose( Char( SL( 'v' ) ), SL( "verbose" ) );
+
+		cmd.addArg( verbose );
+
+		cmd.setSchema( c_schema );
+
+		ParseStatus status;
+
+		CHECK_CONDITION( cmd.parse( status ) == false )
+		CHECK_CONDITION( status.error() == ParseError::SchemaMismatch )
+		CHECK_CONDITION( status.word() == SL( "--timeout" ) )
+		CHECK_CONDITION( status.description() ==
+			SL( "Argument \"--timeout\" from the schema wasn't added." ) )
+	}
+}
+
+TEST( StaticSchemaCase, TestFindKeys )
+{
+	const StaticSchemaView view = c_schema.view();
+
+	CHECK_CONDITION( view.findFlag( 0, StringView( SL( "v" ) ) ) == 0 )
+	CHECK_CONDITION( view.findName( 0, StringView( SL( "verbose" ) ) ) == 0 )
+	CHECK_CONDITION( view.findName( 0, StringView( SL( "config" ) ) ) == 2 )
+	CHECK_CONDITION( view.findFlag( 4, StringView( SL( "f" ) ) ) == 4 )
+	CHECK_CONDITION( view.findName( 9, StringView( SL( "file" ) ) ) == 9 )
+	CHECK_CONDITION( view.findGroup( 4, StringView( SL( "mode" ) ) ) == 5 )
+
+	CHECK_CONDITION( view.findFlag( 0, StringView( SL( "f" ) ) ) ==
+		StaticSchemaView::npos )
+	CHECK_CONDITION( view.findName( 0, StringView( SL( "list" ) ) ) ==
+		StaticSchemaView::npos )
+	CHECK_CONDITION( view.findGroup( 0, StringView( SL( "mode" ) ) ) ==
+		StaticSchemaView::npos )
+	CHECK_CONDITION( view.find( 4, StringView( SL( "mode" ) ) ) ==
+		StaticSchemaView::npos )
+}
+
+TEST( StaticSchemaCase, TestGroupAndWordWithSameName )
+{
+	const CHAR * argv[ 2 ] = { SL( "program.exe" ), SL( "list" ) };
+
+	CmdLine cmd( 2, argv );
+
+	OnlyOneGroup g( SL( "list" ) );
+	Arg a( Char( SL( 'a' ) ) );
+	ArgAsCommand list( SL( "list" ) );
+
+	g.addArg( a );
+
+	cmd.addArg( g );
+	cmd.addArg( list );
+
+	cmd.setSchema( c_groupAndWordSchema );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == true )
+	CHECK_CONDITION( list.isDefined() )
+	CHECK_CONDITION( !a.isDefined() )
+}
+
+TEST( StaticSchemaCase, TestScopes )
+{
+	const CHAR * flags = SL( "0123456789abcdefghijklmnopqrstuvwxyz"
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ" );
+
+	for( std::size_t f = 0; !( flags[ f ] == CHAR() ); ++f )
+	{
+		const StaticArgSpec specs[] = {
+			staticArg( SL( 'v' ) ),
+			staticCommand( SL( "a" ) ),
+			staticArg( SL( 'k' ) ).in( SL( "a" ) ),
+			staticArg( flags[ f ] ).in( SL( "a" ) ),
+			staticCommand( SL( "b" ) ),
+			staticArg( SL( 'k' ) ).in( SL( "b" ) ),
+			staticArg( flags[ f ] ).in( SL( "b" ) ),
+			staticCommand( SL( "c" ) ),
+			staticArg( SL( 'k' ) ).in( SL( "c" ) ),
+			staticArg( flags[ f ] ).in( SL( "c" ) )
+		};
+
+		const StaticSchema< 10 > schema( specs );
+
+		if( schema.error() != StaticSchemaError::None )
+			continue;
+
+		const StaticSchemaView view = schema.view();
+
+		const CHAR flag[] = { SL( '-' ), flags[ f ], CHAR() };
+		const StringView keys[] = { StringView( SL( "-v" ) ),
+			StringView( SL( "-k" ) ), StringView( flag ) };
+		const std::size_t scopes[] = { 0, 2, 5, 8 };
+
+		for( const std::size_t scope : scopes )
+		{
+			for( const StringView & key : keys )
+			{
+				const std::size_t i = view.find( scope, key );
+
+				if( i != StaticSchemaView::npos )
+					CHECK_CONDITION( view.scopeOf( i ) == scope )
+			}
+		}
+
+		CHECK_CONDITION( view.find( 0, StringView( flag ) ) ==
+			StaticSchemaView::npos )
+		CHECK_CONDITION( view.find( 5, StringView( flag ) ) == 6 )
+	}
+
+	Arg v( Char( SL( 'v' ) ) );
+	Command a( SL( "a" ) ), b( SL( "b" ) ), c( SL( "c" ) );
+	Arg ak( Char( SL( 'k' ) ) ), al( Char( SL( 'l' ) ) ), an( Char( SL( 'N' ) ) );
+	Arg bk( Char( SL( 'k' ) ) ), bl( Char( SL( 'l' ) ) ), bn( Char( SL( 'N' ) ) );
+	Arg ck( Char( SL( 'k' ) ) ), cl( Char( SL( 'l' ) ) ), cn( Char( SL( 'N' ) ) );
+
+	a.addArg( ak ); a.addArg( al ); a.addArg( an );
+	b.addArg( bk ); b.addArg( bl ); b.addArg( bn );
+	c.addArg( ck ); c.addArg( cl ); c.addArg( cn );
+
+	const CHAR * argv[ 3 ] = { SL( "program.exe" ), SL( "b" ), SL( "-N" ) };
+
+	CmdLine cmd( 3, argv );
+
+	cmd.addArg( v );
+	cmd.addArg( a );
+	cmd.addArg( b );
+	cmd.addArg( c );
+
+	cmd.setSchema( c_repeatedSchema );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == true )
+	CHECK_CONDITION( bn.isDefined() == true )
+	CHECK_CONDITION( an.isDefined() == false )
+	CHECK_CONDITION( cn.isDefined() == false )
+
+	const CHAR * argv2[ 2 ] = { SL( "program.exe" ), SL( "-N" ) };
+
+	CHECK_CONDITION( cmd.parse( 2, argv2, status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+}
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
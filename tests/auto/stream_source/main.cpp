@@ -0,0 +1,391 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+// C++ include.
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+	#include <fcntl.h>
+	#include <io.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+//! Write file.
+void writeFile( const char * name, const std::string & content )
+{
+	std::ofstream stream( name, std::ios::binary | std::ios::trunc );
+
+	stream.write( content.data(), static_cast< std::streamsize > ( content.size() ) );
+}
+
+//! \return File descriptor of the file opened for reading.
+int openFile( const char * name )
+{
+#ifdef _WIN32
+	return _open( name, _O_RDONLY | _O_BINARY );
+#else
+	return ::open( name, O_RDONLY );
+#endif
+}
+
+//! Close file descriptor.
+void closeFile( int fd )
+{
+#ifdef _WIN32
+	_close( fd );
+#else
+	::close( fd );
+#endif
+}
+
+//! \return All words of the file.
+std::vector< String > readAll( const char * name, StreamSource::Delimiter delimiter,
+	std::size_t chunkSize, StreamSource::Delimiter * detected = nullptr )
+{
+	const int fd = openFile( name );
+
+	std::vector< String > result;
+
+	{
+		StreamSource source( fd, delimiter, chunkSize );
+		StringView word;
+
+		while( source.next( word ) )
+			result.push_back( word.toString() );
+
+		if( detected )
+			*detected = source.delimiter();
+	}
+
+	closeFile( fd );
+
+	return result;
+}
+
+//! Collector of the values.
+struct Collector {
+	void operator () ( const StringView & value )
+	{
+		m_values.push_back( value.toString() );
+	}
+
+	std::vector< String > m_values;
+}; // struct Collector
+
+static int g_calls = 0;
+
+//! Counts calls.
+void countCall( const StringView & )
+{
+	++g_calls;
+}
+
+
+TEST( StreamSourceCase, TestNewline )
+{
+	writeFile( "stream1.txt", "a.txt\nb.txt\r\n\nc d.txt" );
+
+	StreamSource::Delimiter detected = StreamSource::Auto;
+
+	const std::vector< String > expected = { SL( "a.txt" ), SL( "b.txt" ),
+		SL( "c d.txt" ) };
+
+	CHECK_CONDITION( readAll( "stream1.txt", StreamSource::Auto, 1024,
+		&detected ) == expected )
+	CHECK_CONDITION( detected == StreamSource::Newline )
+	CHECK_CONDITION( readAll( "stream1.txt", StreamSource::Newline, 4 ) == expected )
+}
+
+TEST( StreamSourceCase, TestNul )
+{
+	writeFile( "stream2.txt", std::string( "a b\0c\nd\0\0e\r", 12 ) );
+
+	StreamSource::Delimiter detected = StreamSource::Auto;
+
+	const std::vector< String > expected = { SL( "a b" ), SL( "c\nd" ),
+		SL( "e\r" ) };
+
+	CHECK_CONDITION( readAll( "stream2.txt", StreamSource::Auto, 1024,
+		&detected ) == expected )
+	CHECK_CONDITION( detected == StreamSource::Nul )
+	CHECK_CONDITION( readAll( "stream2.txt", StreamSource::Nul, 3 ) == expected )
+}
+
+TEST( StreamSourceCase, TestDelimiterAfterFirstChunk )
+{
+	writeFile( "stream9.txt",
+		std::string( "long_name_of_the_file\0b\nc\0", 26 ) );
+
+	StreamSource::Delimiter detected = StreamSource::Auto;
+
+	const std::vector< String > expected = { SL( "long_name_of_the_file" ),
+		SL( "b\nc" ) };
+
+	CHECK_CONDITION( readAll( "stream9.txt", StreamSource::Auto, 16,
+		&detected ) == expected )
+	CHECK_CONDITION( detected == StreamSource::Nul )
+
+	writeFile( "stream10.txt", "long_name_of_the_file\nb\n" );
+
+	const std::vector< String > expected2 = { SL( "long_name_of_the_file" ),
+		SL( "b" ) };
+
+	CHECK_CONDITION( readAll( "stream10.txt", StreamSource::Auto, 16,
+		&detected ) == expected2 )
+	CHECK_CONDITION( detected == StreamSource::Newline )
+
+	writeFile( "stream11.txt", "long_name_of_the_file" );
+
+	CHECK_CONDITION( readAll( "stream11.txt", StreamSource::Auto, 16,
+		&detected ).size() == 1 )
+	CHECK_CONDITION( detected == StreamSource::Auto )
+}
+
+TEST( StreamSourceCase, TestLongWords )
+{
+	std::string content;
+
+	for( int i = 0; i < 1000; ++i )
+		content += "/very/long/path/to/the/file/" + std::to_string( i ) + "\n";
+
+	content += std::string( 1000, 'x' );
+
+	writeFile( "stream3.txt", content );
+
+	const std::vector< String > words = readAll( "stream3.txt",
+		StreamSource::Auto, 16 );
+
+	CHECK_CONDITION( words.size() == 1001 )
+	CHECK_CONDITION( words[ 999 ] == SL( "/very/long/path/to/the/file/999" ) )
+	CHECK_CONDITION( words[ 1000 ].length() == 1000 )
+}
+
+TEST( StreamSourceCase, TestEmpty )
+{
+	writeFile( "stream4.txt", "" );
+
+	CHECK_CONDITION( readAll( "stream4.txt", StreamSource::Auto, 16 ).empty() )
+}
+
+TEST( StreamSourceCase, TestMultiArg )
+{
+	writeFile( "stream5.txt", std::string( "a.txt\0b.txt\0c.txt\0", 18 ) );
+
+	const int fd = openFile( "stream5.txt" );
+
+	StreamSource source( fd );
+
+	const int argc = 6;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "--files" ), SL( "first.txt" ), SL( "-" ), SL( "-v" ),
+		SL( "--other=-" ) };
+
+	CmdLine cmd( argc, argv );
+
+	MultiArg files( String( SL( "files" ) ), true );
+	MultiArg other( String( SL( "other" ) ), true );
+	Arg v( Char( SL( 'v' ) ) );
+
+	Collector collector;
+
+	files.setStream( &source );
+	files.setValueHandler( collector );
+
+	cmd.addArg( files );
+	cmd.addArg( other );
+	cmd.addArg( v );
+
+	cmd.parse();
+
+	closeFile( fd );
+
+	const std::vector< String > expected = { SL( "first.txt" ), SL( "a.txt" ),
+		SL( "b.txt" ), SL( "c.txt" ) };
+
+	CHECK_CONDITION( collector.m_values == expected )
+	CHECK_CONDITION( files.values().empty() )
+	CHECK_CONDITION( files.count() == 4 )
+	CHECK_CONDITION( files.isDefined() )
+	CHECK_CONDITION( v.isDefined() )
+	CHECK_CONDITION( other.value() == SL( "-" ) )
+}
+
+TEST( StreamSourceCase, TestOrderOfValues )
+{
+	writeFile( "stream7.txt", "c\nd\n" );
+
+	const int fd = openFile( "stream7.txt" );
+
+	StreamSource source( fd );
+
+	const int argc = 5;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "-f" ), SL( "a" ),
+		SL( "-" ), SL( "b" ) };
+
+	CmdLine cmd( argc, argv );
+
+	MultiArg files( Char( SL( 'f' ) ), true );
+	files.setStream( &source );
+
+	cmd.addArg( files );
+
+	cmd.parse();
+
+	closeFile( fd );
+
+	const StringList expected = { SL( "a" ), SL( "c" ), SL( "d" ), SL( "b" ) };
+
+	CHECK_CONDITION( files.values() == expected )
+	CHECK_CONDITION( files.value() == SL( "a" ) )
+}
+
+TEST( StreamSourceCase, TestFunctionPointer )
+{
+	writeFile( "stream6.txt", "a\nb\n" );
+
+	const int fd = openFile( "stream6.txt" );
+
+	StreamSource source( fd );
+
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "-f" ), SL( "-" ) };
+
+	CmdLine cmd( argc, argv );
+
+	MultiArg files( Char( SL( 'f' ) ), true );
+	files.setStream( &source );
+	files.setValueHandler( &countCall );
+
+	cmd.addArg( files );
+
+	cmd.parse();
+
+	closeFile( fd );
+
+	CHECK_CONDITION( g_calls == 2 )
+	CHECK_CONDITION( files.count() == 2 )
+}
+
+#ifndef _WIN32
+TEST( StreamSourceCase, TestReadError )
+{
+	std::string content;
+
+	for( int i = 0; i < 100; ++i )
+		content += "file" + std::to_string( i ) + ".txt\n";
+
+	writeFile( "stream8.txt", content );
+
+	const int fd = openFile( "stream8.txt" );
+
+	StreamSource source( fd, StreamSource::Auto, 16 );
+
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "-f" ), SL( "-" ) };
+
+	CmdLine cmd( argc, argv );
+
+	MultiArg files( Char( SL( 'f' ) ), true );
+	files.setStream( &source );
+
+	bool isClosed = false;
+
+	// Stream fails after the first chunk.
+	const auto closer = [ fd, &isClosed ] ( const StringView & )
+	{
+		if( !isClosed )
+			closeFile( fd );
+
+		isClosed = true;
+	};
+
+	files.setValueHandler( closer, true );
+
+	cmd.addArg( files );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::StreamReadError )
+	CHECK_CONDITION( source.hasError() )
+	CHECK_CONDITION( files.count() > 0 && files.count() < 100 )
+	CHECK_CONDITION( files.value() == SL( "file0.txt" ) )
+}
+
+TEST( StreamSourceCase, TestIncompleteWordOnReadError )
+{
+	writeFile( "stream12.txt", "file0.txt\nfile1.txt\n" );
+
+	const int fd = openFile( "stream12.txt" );
+
+	StreamSource source( fd, StreamSource::Newline, 16 );
+
+	StringView word;
+
+	CHECK_CONDITION( source.next( word ) )
+	CHECK_CONDITION( word.toString() == SL( "file0.txt" ) )
+
+	// Only "file1." is read, the rest of the word can't be read.
+	closeFile( fd );
+
+	CHECK_CONDITION( source.next( word ) == false )
+	CHECK_CONDITION( source.hasError() )
+	CHECK_CONDITION( source.next( word ) == false )
+}
+#endif // _WIN32
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
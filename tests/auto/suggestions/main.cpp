@@ -0,0 +1,372 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+// C++ include.
+#include <memory>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+//! \return Prefix with the number.
+String numbered( const String & prefix, std::size_t n )
+{
+	const String digits = SL( "0123456789" );
+
+	String suffix;
+
+	do {
+		suffix = String( 1, digits[ static_cast< int > ( n % 10 ) ] ) + suffix;
+		n /= 10;
+	} while( n > 0 );
+
+	return prefix + suffix;
+}
+
+
+TEST( SuggestionsCase, TestIndex )
+{
+	CHECK_CONDITION( SimilarityIndex::distance( String( SL( "kitten" ) ),
+		String( SL( "sitting" ) ) ) == 3 )
+	CHECK_CONDITION( SimilarityIndex::distance( String( SL( "add" ) ),
+		String( SL( "add" ) ) ) == 0 )
+	CHECK_CONDITION( SimilarityIndex::distance( String(),
+		String( SL( "add" ) ) ) == 3 )
+
+	SimilarityIndex index;
+
+	CHECK_CONDITION( index.empty() )
+
+	index.insert( SL( "--verbose" ) );
+	index.insert( SL( "--version" ) );
+	index.insert( SL( "--output" ) );
+	index.insert( SL( "add" ) );
+
+	std::vector< SimilarityIndex::Match > matches;
+
+	index.find( String( SL( "--verbos" ) ), 1, matches );
+
+	CHECK_CONDITION( matches.size() == 1 )
+	CHECK_CONDITION( matches.front().first == 1 )
+	CHECK_CONDITION( matches.front().second == SL( "--verbose" ) )
+
+	matches.clear();
+	index.find( String( SL( "--versoin" ) ), 2, matches );
+
+	CHECK_CONDITION( matches.size() == 1 )
+	CHECK_CONDITION( matches.front().first == 2 )
+	CHECK_CONDITION( matches.front().second == SL( "--version" ) )
+
+	matches.clear();
+	index.find( String( SL( "--input" ) ), 1, matches );
+
+	CHECK_CONDITION( matches.empty() )
+
+	matches.clear();
+	index.find( String( SL( "ad" ) ), 1, matches );
+
+	CHECK_CONDITION( matches.size() == 1 )
+	CHECK_CONDITION( matches.front().second == SL( "add" ) )
+}
+
+TEST( SuggestionsCase, TestIndexFindsAll )
+{
+	const String alphabet = SL( "-abc" );
+
+	SimilarityIndex index;
+	std::vector< String > names;
+
+	// All names of length up to 5 from the alphabet.
+	names.push_back( String() );
+
+	for( std::size_t i = 0; i < names.size(); ++i )
+	{
+		if( names[ i ].length() < 5 )
+		{
+			for( std::size_t j = 0; j < alphabet.length(); ++j )
+				names.push_back( names[ i ] + String( 1, alphabet[ j ] ) );
+		}
+	}
+
+	for( const auto & name : names )
+		index.insert( name );
+
+	const std::vector< String > words = { SL( "a" ), SL( "--ab" ),
+		SL( "abcab" ), SL( "--abcabc" ), SL( "cccccccc" ) };
+
+	bool isSame = true;
+
+	for( const auto & word : words )
+	{
+		for( std::size_t k = 1; k < 4; ++k )
+		{
+			std::vector< SimilarityIndex::Match > matches;
+
+			index.find( word, k, matches );
+
+			std::size_t expected = 0;
+
+			for( const auto & name : names )
+			{
+				if( SimilarityIndex::distance( word, name ) <= k )
+					++expected;
+			}
+
+			for( const auto & match : matches )
+				isSame = isSame && ( SimilarityIndex::distance( word,
+					match.second ) == match.first );
+
+			isSame = isSame && ( matches.size() == expected );
+		}
+	}
+
+	CHECK_CONDITION( isSame )
+}
+
+TEST( SuggestionsCase, TestNearIdenticalNames )
+{
+	SimilarityIndex index;
+	std::vector< String > names;
+
+	for( std::size_t i = 0; i < 2000; ++i )
+	{
+		names.push_back( numbered( SL( "--option-" ), i ) );
+		index.insert( names.back() );
+	}
+
+	const String word = SL( "--opiton-1234" );
+
+	std::vector< SimilarityIndex::Match > matches;
+
+	// Bigrams of all names aren't counted, but nothing is lost.
+	index.find( word, 3, matches );
+
+	std::size_t expected = 0;
+
+	for( const auto & name : names )
+	{
+		if( SimilarityIndex::distance( word, name ) <= 3 )
+			++expected;
+	}
+
+	CHECK_CONDITION( matches.size() == expected )
+	CHECK_CONDITION( expected > 5 )
+
+	// Name with the most common bigrams is compared first.
+	matches.clear();
+	index.find( word, 3, matches, 5 );
+
+	CHECK_CONDITION( matches.size() <= 5 )
+
+	bool isFound = false;
+
+	for( const auto & match : matches )
+		isFound = isFound || ( match.second == SL( "--option-1234" ) );
+
+	CHECK_CONDITION( isFound )
+
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	CmdLine cmd( argc, argv );
+
+	std::vector< std::unique_ptr< Arg > > args;
+
+	for( std::size_t i = 0; i < 2000; ++i )
+	{
+		args.emplace_back( new Arg( numbered( SL( "option-" ), i ), true ) );
+		cmd.addArg( *args.back() );
+	}
+
+	cmd.seal();
+
+	const auto similar = cmd.suggestions( word );
+
+	CHECK_CONDITION( !similar.empty() )
+	CHECK_CONDITION( similar.front() == SL( "--option-1234" ) )
+}
+
+TEST( SuggestionsCase, TestParse )
+{
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "--verbos" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg verbose( String( SL( "verbose" ) ) );
+	Arg version( String( SL( "version" ) ) );
+	Arg port( String( SL( "port" ) ), true );
+
+	cmd.addArg( verbose );
+	cmd.addArg( version );
+	cmd.addArg( port );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	CHECK_CONDITION( status.candidates().size() == 1 )
+	CHECK_CONDITION( status.candidates().front() == SL( "--verbose" ) )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Unknown argument \"--verbos\". "
+			"Did you mean \"--verbose\"?" ) ) )
+
+	const CHAR * argv2[ argc ] = { SL( "program.exe" ), SL( "--host" ) };
+
+	CHECK_CONDITION( cmd.parse( argc, argv2, status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	CHECK_CONDITION( status.candidates().empty() )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Unknown argument \"--host\"." ) ) )
+}
+
+TEST( SuggestionsCase, TestScopeOfCommand )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "add" ), SL( "--formt" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg force( String( SL( "force" ) ) );
+	Command add( SL( "add" ) );
+	Command remove( SL( "remove" ) );
+	Arg format( String( SL( "format" ) ) );
+	Arg from( String( SL( "from" ) ) );
+
+	add.addArg( format );
+	remove.addArg( from );
+
+	cmd.addArg( force );
+	cmd.addArg( add );
+	cmd.addArg( remove );
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.error() == ParseError::UnknownArgument )
+	CHECK_CONDITION( status.candidates().size() == 1 )
+	CHECK_CONDITION( status.candidates().front() == SL( "--format" ) )
+
+	const CHAR * argv2[ argc ] = { SL( "program.exe" ),
+		SL( "--formt" ), SL( "add" ) };
+
+	CHECK_CONDITION( cmd.parse( argc, argv2, status ) == false )
+	CHECK_CONDITION( status.candidates().empty() )
+
+	const CHAR * argv3[ 2 ] = { SL( "program.exe" ), SL( "remov" ) };
+
+	CHECK_CONDITION( cmd.parse( 2, argv3, status ) == false )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Unknown argument \"remov\". Did you mean \"remove\"?" ) ) )
+}
+
+TEST( SuggestionsCase, TestFindArgument )
+{
+	const int argc = 1;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+	timeout.addAlias( SL( "--time-out" ) );
+
+	cmd.addArg( timeout );
+
+	cmd.parse();
+
+	const std::vector< String > names = cmd.suggestions( String( SL( "--timout" ) ) );
+
+	CHECK_CONDITION( names.size() == 2 )
+	CHECK_CONDITION( names.front() == SL( "--timeout" ) )
+	CHECK_CONDITION( cmd.suggestions( String( SL( "--timout" ) ), 1 ).size() == 1 )
+	CHECK_CONDITION( cmd.suggestions( String( SL( "-x" ) ) ).empty() )
+
+	try {
+		cmd.findArgument( String( SL( "--timout" ) ) );
+
+		CHECK_CONDITION( false )
+	}
+	catch( const BaseException & x )
+	{
+		CHECK_CONDITION( x.desc() == String( SL( "Unknown argument "
+			"\"--timout\". Did you mean \"--timeout\" or \"--time-out\"?" ) ) )
+	}
+}
+
+TEST( SuggestionsCase, TestRenameAfterSeal )
+{
+	const int argc = 2;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ), SL( "--verbos" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg verbose( String( SL( "verbose" ) ) );
+
+	cmd.addArg( verbose );
+
+	cmd.seal();
+
+	// Names of the sealed command line can't be changed.
+	CHECK_THROW( verbose.setArgumentName( SL( "renamed" ) ), BaseException )
+	CHECK_THROW( verbose.setFlag( SL( 'r' ) ), BaseException )
+	CHECK_THROW( verbose.addAlias( SL( "--renamed" ) ), BaseException )
+
+	ParseStatus status;
+
+	CHECK_CONDITION( cmd.parse( status ) == false )
+	CHECK_CONDITION( status.candidates().size() == 1 )
+	CHECK_CONDITION( status.candidates().front() == SL( "--verbose" ) )
+
+	const CHAR * argv2[ argc ] = { SL( "program.exe" ), SL( "--renamed" ) };
+
+	CHECK_CONDITION( cmd.parse( argc, argv2, status ) == false )
+	CHECK_CONDITION( status.candidates().empty() )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Unknown argument \"--renamed\"." ) ) )
+}
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
@@ -0,0 +1,353 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2013-2017 Igor Mironchik
+
+	Permission is hereby granted, free of charge, to any person
+	obtaining a copy of this software and associated documentation
+	files (the "Software"), to deal in the Software without
+	restriction, including without limitation the rights to use,
+	copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following
+	conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// UnitTest include.
+#include <UnitTest/unit_test.hpp>
+
+// Args include.
+#include <Args/all.hpp>
+
+// C++ include.
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+
+using namespace Args;
+
+#ifdef ARGS_WSTRING_BUILD
+	using CHAR = String::value_type;
+#else
+	using CHAR = char;
+#endif
+
+
+TEST( TypedValueCase, TestIntegers )
+{
+	Arg a( Char( SL( 'a' ) ), true );
+
+	a.setValue( SL( "100" ) );
+
+	CHECK_CONDITION( a.valueAs< int > () == 100 )
+	CHECK_CONDITION( a.valueAs< unsigned short > () == 100 )
+	CHECK_CONDITION( a.valueAs< std::int8_t > () == 100 )
+	CHECK_CONDITION( a.valueAs< long long > () == 100 )
+
+	a.setValue( SL( "-128" ) );
+
+	CHECK_CONDITION( a.valueAs< std::int8_t > () == -128 )
+	CHECK_THROW( a.valueAs< unsigned int > (), BaseException )
+
+	a.setValue( SL( "128" ) );
+
+	CHECK_THROW( a.valueAs< std::int8_t > (), BaseException )
+	CHECK_CONDITION( a.valueAs< std::uint8_t > () == 128 )
+
+	a.setValue( SL( "18446744073709551615" ) );
+
+	CHECK_CONDITION( a.valueAs< std::uint64_t > () == 18446744073709551615ull )
+
+	a.setValue( SL( "18446744073709551616" ) );
+
+	CHECK_THROW( a.valueAs< std::uint64_t > (), BaseException )
+
+	a.setValue( SL( "12a" ) );
+
+	CHECK_THROW( a.valueAs< int > (), BaseException )
+
+	a.setValue( SL( "" ) );
+
+	CHECK_THROW( a.valueAs< int > (), BaseException )
+}
+
+TEST( TypedValueCase, TestFloatingPoint )
+{
+	Arg a( Char( SL( 'a' ) ), true );
+
+	a.setValue( SL( "2.5" ) );
+
+	CHECK_CONDITION( a.valueAs< double > () == 2.5 )
+	CHECK_CONDITION( a.valueAs< float > () == 2.5f )
+
+	a.setValue( SL( "-1e3" ) );
+
+	CHECK_CONDITION( a.valueAs< double > () == -1000.0 )
+
+	a.setValue( SL( "1.2.3" ) );
+
+	CHECK_THROW( a.valueAs< double > (), BaseException )
+
+	a.setValue( SL( " 1.2" ) );
+
+	CHECK_THROW( a.valueAs< double > (), BaseException )
+}
+
+TEST( TypedValueCase, TestFloatingPointSyntax )
+{
+	// Same result with std::from_chars() (C++17) and without it.
+	const CHAR * invalid[] = { SL( "inf" ), SL( "-inf" ), SL( "INF" ),
+		SL( "infinity" ), SL( "nan" ), SL( "-nan" ), SL( "NaN" ),
+		SL( "nan(1)" ), SL( "1e999" ), SL( "-1e999" ), SL( "+1" ),
+		SL( "0x10" ), SL( "1,5" ), SL( "" ) };
+
+	Arg a( Char( SL( 'a' ) ), true );
+
+	for( const auto & value : invalid )
+	{
+		a.setValue( value );
+
+		CHECK_THROW( a.valueAs< double > (), BaseException )
+		CHECK_THROW( a.valueAs< float > (), BaseException )
+	}
+
+	a.setValue( SL( ".5" ) );
+
+	CHECK_CONDITION( a.valueAs< double > () == 0.5 )
+
+	a.setValue( SL( "5." ) );
+
+	CHECK_CONDITION( a.valueAs< double > () == 5.0 )
+
+	a.setValue( SL( "-0" ) );
+
+	CHECK_CONDITION( a.valueAs< double > () == 0.0 )
+
+	a.setValue( SL( "1E-3" ) );
+
+	CHECK_CONDITION( a.valueAs< double > () == 0.001 )
+}
+
+TEST( TypedValueCase, TestBool )
+{
+	Arg a( Char( SL( 'a' ) ), true );
+
+	a.setValue( SL( "true" ) );
+	CHECK_CONDITION( a.valueAs< bool > () )
+
+	a.setValue( SL( "on" ) );
+	CHECK_CONDITION( a.valueAs< bool > () )
+
+	a.setValue( SL( "0" ) );
+	CHECK_CONDITION( !a.valueAs< bool > () )
+
+	a.setValue( SL( "no" ) );
+	CHECK_CONDITION( !a.valueAs< bool > () )
+
+	a.setValue( SL( "maybe" ) );
+	CHECK_THROW( a.valueAs< bool > (), BaseException )
+}
+
+TEST( TypedValueCase, TestDurations )
+{
+	using namespace std::chrono;
+
+	Arg a( Char( SL( 'a' ) ), true );
+
+	a.setValue( SL( "1500ms" ) );
+
+	CHECK_CONDITION( a.valueAs< milliseconds > () == milliseconds( 1500 ) )
+	CHECK_CONDITION( a.valueAs< microseconds > () == microseconds( 1500000 ) )
+	CHECK_THROW( a.valueAs< seconds > (), BaseException )
+	CHECK_CONDITION( a.valueAs< duration< double > > () ==
+		duration< double > ( 1.5 ) )
+
+	a.setValue( SL( "2m" ) );
+
+	CHECK_CONDITION( a.valueAs< seconds > () == seconds( 120 ) )
+	CHECK_CONDITION( a.valueAs< minutes > () == minutes( 2 ) )
+
+	a.setValue( SL( "1d" ) );
+
+	CHECK_CONDITION( a.valueAs< hours > () == hours( 24 ) )
+
+	a.setValue( SL( "90" ) );
+
+	CHECK_CONDITION( a.valueAs< seconds > () == seconds( 90 ) )
+
+	a.setValue( SL( "1e3ms" ) );
+
+	CHECK_CONDITION( a.valueAs< duration< double > > () ==
+		duration< double > ( 1.0 ) )
+	CHECK_THROW( a.valueAs< milliseconds > (), BaseException )
+
+	a.setValue( SL( "2.5e-1s" ) );
+
+	using DoubleMilliseconds = duration< double, std::milli >;
+
+	CHECK_CONDITION( a.valueAs< DoubleMilliseconds > () ==
+		DoubleMilliseconds( 250.0 ) )
+
+	a.setValue( SL( "10parsecs" ) );
+
+	CHECK_THROW( a.valueAs< seconds > (), BaseException )
+}
+
+TEST( TypedValueCase, TestByteSize )
+{
+	Arg a( Char( SL( 'a' ) ), true );
+
+	a.setValue( SL( "4K" ) );
+
+	CHECK_CONDITION( a.valueAs< ByteSize > () == ByteSize( 4096 ) )
+
+	a.setValue( SL( "10MB" ) );
+
+	CHECK_CONDITION( a.valueAs< ByteSize > ().bytes() == 10000000 )
+
+	a.setValue( SL( "2GiB" ) );
+
+	CHECK_CONDITION( a.valueAs< ByteSize > ().bytes() == 2147483648ull )
+
+	a.setValue( SL( "512" ) );
+
+	CHECK_CONDITION( a.valueAs< ByteSize > ().bytes() == 512 )
+
+	a.setValue( SL( "100000000T" ) );
+
+	CHECK_THROW( a.valueAs< ByteSize > (), BaseException )
+
+	a.setValue( SL( "1X" ) );
+
+	CHECK_THROW( a.valueAs< ByteSize > (), BaseException )
+}
+
+TEST( TypedValueCase, TestStatus )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "--port" ), SL( "http" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg port( String( SL( "port" ) ), true );
+
+	cmd.addArg( port );
+
+	cmd.parse();
+
+	int value = 0;
+	ParseStatus status;
+
+	CHECK_CONDITION( !port.valueAs( value, status ) )
+	CHECK_CONDITION( status.error() == ParseError::InvalidValue )
+	CHECK_CONDITION( status.argument() == &port )
+	CHECK_CONDITION( status.word() == SL( "http" ) )
+	CHECK_CONDITION( status.description() ==
+		String( SL( "Value \"http\" of argument \"--port\" is invalid." ) ) )
+
+	try {
+		port.valueAs< int > ();
+
+		CHECK_CONDITION( false )
+	}
+	catch( const BaseException & x )
+	{
+		CHECK_CONDITION( x.desc() == status.description() )
+	}
+
+	CHECK_CONDITION( port.valueAs( value, status ) == false )
+	CHECK_CONDITION( port.valueAs< String > () == SL( "http" ) )
+}
+
+TEST( TypedValueCase, TestCache )
+{
+	const int argc = 3;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-t" ), SL( "100" ) };
+
+	CmdLine cmd( argc, argv );
+
+	Arg timeout( Char( SL( 't' ) ), String( SL( "timeout" ) ), true );
+
+	cmd.addArg( timeout );
+
+	cmd.parse();
+
+	CHECK_CONDITION( timeout.valueAs< int > () == 100 )
+	CHECK_CONDITION( timeout.valueAs< int > () == 100 )
+	CHECK_CONDITION( timeout.valueAs< double > () == 100.0 )
+	CHECK_CONDITION( timeout.valueAs< int > () == 100 )
+
+	const CHAR * argv2[ argc ] = { SL( "program.exe" ),
+		SL( "-t" ), SL( "200" ) };
+
+	cmd.parse( argc, argv2 );
+
+	CHECK_CONDITION( timeout.valueAs< int > () == 200 )
+
+	timeout.setValue( SL( "300" ) );
+
+	CHECK_CONDITION( timeout.valueAs< int > () == 300 )
+}
+
+TEST( TypedValueCase, TestMultiArg )
+{
+	const int argc = 7;
+	const CHAR * argv[ argc ] = { SL( "program.exe" ),
+		SL( "-i" ), SL( "1" ), SL( "-i" ), SL( "2" ),
+		SL( "--id" ), SL( "3" ) };
+
+	CmdLine cmd( argc, argv );
+
+	MultiArg id( Char( SL( 'i' ) ), String( SL( "id" ) ), true );
+
+	cmd.addArg( id );
+
+	cmd.parse();
+
+	const std::vector< int > expected = { 1, 2, 3 };
+
+	CHECK_CONDITION( id.valuesAs< int > () == expected )
+	CHECK_CONDITION( &id.valuesAs< int > () == &id.valuesAs< int > () )
+	CHECK_CONDITION( id.valueAs< int > () == 1 )
+
+	std::vector< long > values;
+	ParseStatus status;
+
+	CHECK_CONDITION( id.valuesAs( values, status ) )
+	CHECK_CONDITION( values.size() == 3 && values[ 2 ] == 3 )
+
+	const CHAR * argv2[ 5 ] = { SL( "program.exe" ),
+		SL( "-i" ), SL( "1" ), SL( "-i" ), SL( "x" ) };
+
+	cmd.parse( 5, argv2 );
+
+	CHECK_CONDITION( !id.valuesAs( values, status ) )
+	CHECK_CONDITION( status.word() == SL( "x" ) )
+	CHECK_THROW( id.valuesAs< int > (), BaseException )
+}
+
+
+int main()
+{
+	RUN_ALL_TESTS()
+
+	return 0;
+}
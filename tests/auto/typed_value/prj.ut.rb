@@ -0,0 +1,7 @@
+
+require 'mxx_ru/binary_unittest'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"tests/auto/typed_value/prj.ut.rb",
+		"tests/auto/typed_value/prj.rb" ) )
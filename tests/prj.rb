@@ -10,4 +10,16 @@ MxxRu::Cpp::composite_target() {
 	required_prj( "tests/auto/groups/prj.ut.rb" )
 	required_prj( "tests/auto/command/prj.ut.rb" )
 	required_prj( "tests/auto/arg_as_command/prj.ut.rb" )
+	required_prj( "tests/auto/parse_status/prj.ut.rb" )
+	required_prj( "tests/auto/static_schema/prj.ut.rb" )
+	required_prj( "tests/auto/reset/prj.ut.rb" )
+	required_prj( "tests/auto/memory_resource/prj.ut.rb" )
+	required_prj( "tests/auto/typed_value/prj.ut.rb" )
+	required_prj( "tests/auto/response_file/prj.ut.rb" )
+	required_prj( "tests/auto/stream_source/prj.ut.rb" )
+	required_prj( "tests/auto/parse_stats/prj.ut.rb" )
+	required_prj( "tests/auto/allocations/prj.ut.rb" )
+	required_prj( "tests/auto/no_rtti/prj.ut.rb" )
+	required_prj( "tests/auto/abbreviations/prj.ut.rb" )
+	required_prj( "tests/auto/suggestions/prj.ut.rb" )
 }